@@ -13,11 +13,15 @@
 //===----------------------------------------------------------------------===//
 #pragma once
 
+#include "common/configure.h"
 #include "common/errcode.h"
 #include "common/filesystem.h"
 #include "common/span.h"
 #include "common/types.h"
 
+#include <cstdint>
+#include <functional>
+#include <string>
 #include <string_view>
 
 namespace WasmEdge {
@@ -33,6 +37,37 @@ public:
   static Expect<std::filesystem::path>
   getPath(Span<const Byte> Data, StorageScope Scope, std::string_view Key = {});
   static void clear(StorageScope Scope, std::string_view Key = {});
+
+  /// Get the key of the cache directory. The compiled modules are only valid
+  /// for the same AOT binary version, target machine and compiler options, so
+  /// the key is the binary version followed by the hash of the others.
+  static std::string getKey(const Configure &Conf, std::string_view Target);
+
+  /// Publish a compiled module into the cache path. The writer outputs the
+  /// compiled module into the temporary path in the same directory, which is
+  /// renamed to the cache path atomically. A lock file next to the cache path
+  /// prevents the concurrent processes from compiling the same module, so the
+  /// writer is skipped if the lock is held by others or the cache path exists.
+  static Expect<void>
+  publish(const std::filesystem::path &Path,
+          const std::function<Expect<void>(const std::filesystem::path &)>
+              &Writer);
+
+  /// Evict the least recently used cached modules until the total size of the
+  /// cache root is within the budget in bytes. Returns the evicted count.
+  static uint64_t prune(StorageScope Scope, uint64_t Budget);
+
+  /// Counters of the cache accesses in the current process.
+  struct Statistics {
+    uint64_t Hits = 0;
+    uint64_t Misses = 0;
+    uint64_t Evictions = 0;
+  };
+  /// Record a loaded cached module, and mark it as recently used.
+  static void recordHit(const std::filesystem::path &Path) noexcept;
+  /// Record a cached module not found or broken.
+  static void recordMiss() noexcept;
+  static Statistics getStatistics() noexcept;
 };
 
 } // namespace AOT
@@ -166,6 +166,12 @@ typedef struct WasmEdge_CallingFrameContext WasmEdge_CallingFrameContext;
 /// Opaque struct of WasmEdge asynchronous result.
 typedef struct WasmEdge_Async WasmEdge_Async;
 
+/// Opaque struct of WasmEdge module instance snapshot.
+typedef struct WasmEdge_SnapshotContext WasmEdge_SnapshotContext;
+
+/// Opaque struct of WasmEdge module instance pool.
+typedef struct WasmEdge_InstancePoolContext WasmEdge_InstancePoolContext;
+
 /// Opaque struct of WasmEdge VM.
 typedef struct WasmEdge_VMContext WasmEdge_VMContext;
 
@@ -829,6 +835,233 @@ WasmEdge_ConfigureSetMaxMemoryPage(WasmEdge_ConfigureContext *Cxt,
 WASMEDGE_CAPI_EXPORT extern uint32_t
 WasmEdge_ConfigureGetMaxMemoryPage(const WasmEdge_ConfigureContext *Cxt);
 
+/// Set the depth limit of the call stack.
+///
+/// Limit the count of the nested function calls in execution. The value stack
+/// of the interpreter is also reserved in proportion to this limit. Calling a
+/// function beyond the limit will fail with the call stack exhausted error.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the maximum call depth.
+/// \param Depth the maximum call depth.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureSetMaxCallStackDepth(WasmEdge_ConfigureContext *Cxt,
+                                       const uint32_t Depth);
+
+/// Get the setting of the depth limit of the call stack.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the maximum call depth
+/// setting.
+///
+/// \returns the call depth limitation value.
+WASMEDGE_CAPI_EXPORT extern uint32_t
+WasmEdge_ConfigureGetMaxCallStackDepth(const WasmEdge_ConfigureContext *Cxt);
+
+/// Set the tiered execution option.
+///
+/// When enabled, the functions are executed by the interpreter first. Once the
+/// calls and the loop iterations of a function reach the tier-up threshold,
+/// the module is compiled by the LLVM JIT in the background, and the functions
+/// switch to the compiled code at their next calls. The option has no effect
+/// if the library was built without LLVM, or the module was already compiled.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the boolean value.
+/// \param IsTieredJIT the boolean value to determine to use the tiered
+/// execution or not.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureSetTieredJIT(WasmEdge_ConfigureContext *Cxt,
+                               const bool IsTieredJIT);
+
+/// Get the tiered execution option.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the boolean value.
+///
+/// \returns the boolean value to determine to use the tiered execution or not.
+WASMEDGE_CAPI_EXPORT extern bool
+WasmEdge_ConfigureIsTieredJIT(const WasmEdge_ConfigureContext *Cxt);
+
+/// Set the tier-up threshold of the tiered execution.
+///
+/// The threshold is the count of the calls and the loop iterations of a
+/// function in the interpreter before the background compilation starts.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the threshold.
+/// \param Threshold the tier-up threshold.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureSetTierUpThreshold(WasmEdge_ConfigureContext *Cxt,
+                                     const uint32_t Threshold);
+
+/// Get the tier-up threshold of the tiered execution.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the threshold.
+///
+/// \returns the tier-up threshold.
+WASMEDGE_CAPI_EXPORT extern uint32_t
+WasmEdge_ConfigureGetTierUpThreshold(const WasmEdge_ConfigureContext *Cxt);
+
+/// Set the AOT cache option.
+///
+/// When enabled, the VM looks up the AOT cache in the local cache directory by
+/// the hash of the loaded WASM binary. On a hit, the cached universal WASM or
+/// native shared library is loaded instead. On a miss, the module is compiled
+/// by the LLVM AOT compiler in the background after validation, and published
+/// into the cache for the next loading. The option has no effect if the library
+/// was built without LLVM, or the loaded module was already compiled.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the boolean value.
+/// \param IsAOTCache the boolean value to determine to use the AOT cache or
+/// not.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureSetAOTCache(WasmEdge_ConfigureContext *Cxt,
+                              const bool IsAOTCache);
+
+/// Get the AOT cache option.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the boolean value.
+///
+/// \returns the boolean value to determine to use the AOT cache or not.
+WASMEDGE_CAPI_EXPORT extern bool
+WasmEdge_ConfigureIsAOTCache(const WasmEdge_ConfigureContext *Cxt);
+
+/// Set the size limit in bytes of the AOT cache.
+///
+/// After a module is published into the AOT cache, the least recently used
+/// cached modules are evicted until the total size of the cache directory is
+/// within the limit. The default value 0 means unlimited.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the size limit.
+/// \param Limit the size limit in bytes.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureSetAOTCacheSizeLimit(WasmEdge_ConfigureContext *Cxt,
+                                       const uint64_t Limit);
+
+/// Get the size limit in bytes of the AOT cache.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the size limit.
+///
+/// \returns the size limit in bytes, 0 for unlimited.
+WASMEDGE_CAPI_EXPORT extern uint64_t
+WasmEdge_ConfigureGetAOTCacheSizeLimit(const WasmEdge_ConfigureContext *Cxt);
+
+/// Set the module image cache option in the runtime configuration.
+///
+/// When enabled, the VM loads the pre-decoded and pre-validated module image
+/// from the local cache instead of decoding the WASM binary, and creates the
+/// image into the cache after the first validation of the module. The cached
+/// images are keyed by the hash of the WASM binary and the enabled proposals.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the boolean value.
+/// \param IsEnable the boolean value.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureSetImageCache(WasmEdge_ConfigureContext *Cxt,
+                                const bool IsEnable);
+
+/// Get the module image cache option in the runtime configuration.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the boolean value.
+///
+/// \returns the boolean value.
+WASMEDGE_CAPI_EXPORT extern bool
+WasmEdge_ConfigureIsImageCache(const WasmEdge_ConfigureContext *Cxt);
+
+/// Set the count of the threads to decode the function bodies.
+///
+/// The function bodies in the code section are decoded in parallel when the
+/// count is larger than 1. The error of the first malformed function in order
+/// is reported. The default value is 1, and 0 for the hardware concurrency.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the thread count.
+/// \param Jobs the count of the threads.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureSetLoadingJobs(WasmEdge_ConfigureContext *Cxt,
+                                 const uint32_t Jobs);
+
+/// Get the count of the threads to decode the function bodies.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the thread count.
+///
+/// \returns the count of the threads.
+WASMEDGE_CAPI_EXPORT extern uint32_t
+WasmEdge_ConfigureGetLoadingJobs(const WasmEdge_ConfigureContext *Cxt);
+
+/// Set the lazy loading option.
+///
+/// In the lazy loading mode, the loader only records the function bodies, and
+/// a function body is decoded and validated on its first call in the
+/// interpreter mode. Therefore the invalid function bodies are reported when
+/// calling them rather than in the validation. This option is ignored when the
+/// JIT, the tiered JIT, or the AOT cache is enabled. Disabled by default.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the boolean value.
+/// \param IsLazyLoading the boolean value to determine to enable the lazy
+/// loading.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureSetLazyLoading(WasmEdge_ConfigureContext *Cxt,
+                                 const bool IsLazyLoading);
+
+/// Get the lazy loading option.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the boolean value.
+///
+/// \returns the boolean value to determine to enable the lazy loading.
+WASMEDGE_CAPI_EXPORT extern bool
+WasmEdge_ConfigureIsLazyLoading(const WasmEdge_ConfigureContext *Cxt);
+
+/// Set the count of the threads to validate the function bodies.
+///
+/// The function bodies in the code section are validated in parallel when the
+/// count is larger than 1. The error of the first invalid function in order is
+/// reported. The default value is 1, and 0 for the hardware concurrency.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the thread count.
+/// \param Jobs the count of the threads.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureSetValidationJobs(WasmEdge_ConfigureContext *Cxt,
+                                    const uint32_t Jobs);
+
+/// Get the count of the threads to validate the function bodies.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the thread count.
+///
+/// \returns the count of the threads.
+WASMEDGE_CAPI_EXPORT extern uint32_t
+WasmEdge_ConfigureGetValidationJobs(const WasmEdge_ConfigureContext *Cxt);
+
 /// Set the force interpreter mode execution option.
 ///
 /// This function is thread-safe.
@@ -851,6 +1084,88 @@ WasmEdge_ConfigureSetForceInterpreter(WasmEdge_ConfigureContext *Cxt,
 WASMEDGE_CAPI_EXPORT extern bool
 WasmEdge_ConfigureIsForceInterpreter(const WasmEdge_ConfigureContext *Cxt);
 
+/// Set the threaded interpreter dispatch option.
+///
+/// When enabled, the interpreter uses the direct-threaded dispatch engine
+/// instead of the switch-based one. The option has no effect if the library
+/// was built by a compiler without the labels-as-values extension.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the boolean value.
+/// \param IsThreadedInterpreter the boolean value to determine to use the
+/// direct-threaded dispatch engine in interpreter mode or not.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureSetThreadedInterpreter(WasmEdge_ConfigureContext *Cxt,
+                                         const bool IsThreadedInterpreter);
+
+/// Get the threaded interpreter dispatch option.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the boolean value.
+///
+/// \returns the boolean value to determine to use the direct-threaded
+/// dispatch engine in interpreter mode or not.
+WASMEDGE_CAPI_EXPORT extern bool
+WasmEdge_ConfigureIsThreadedInterpreter(const WasmEdge_ConfigureContext *Cxt);
+
+/// Set the register-based bytecode option in interpreter mode.
+///
+/// When enabled, the function bodies are lowered into the register-based
+/// internal bytecode with the fused superinstructions at instantiation, and
+/// the interpreter executes the lowered form. The option is ignored when the instruction counting or the
+/// cost measuring is enabled.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the boolean value.
+/// \param IsRegisterInterpreter the boolean value to determine to lower the
+/// function bodies into the register-based bytecode or not.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureSetRegisterInterpreter(WasmEdge_ConfigureContext *Cxt,
+                                         const bool IsRegisterInterpreter);
+
+/// Get the register-based bytecode option in interpreter mode.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the boolean value.
+///
+/// \returns the boolean value to determine to lower the function bodies into
+/// the register-based bytecode or not.
+WASMEDGE_CAPI_EXPORT extern bool
+WasmEdge_ConfigureIsRegisterInterpreter(const WasmEdge_ConfigureContext *Cxt);
+
+/// Set the guard page bounds checking option in interpreter mode.
+///
+/// When enabled, the interpreter skips the software bounds checking of the
+/// memory load and store instructions. The out-of-bounds accesses fall into
+/// the inaccessible region reserved after every linear memory and are trapped
+/// by the signal handler. The option is ignored when the instruction counting
+/// or the cost measuring is enabled, or on the platforms without the reserved
+/// region.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the boolean value.
+/// \param IsGuardPageBoundsCheck the boolean value to determine to check the
+/// memory boundary by the guard pages in interpreter mode or not.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureSetGuardPageBoundsCheck(WasmEdge_ConfigureContext *Cxt,
+                                          const bool IsGuardPageBoundsCheck);
+
+/// Get the guard page bounds checking option in interpreter mode.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the boolean value.
+///
+/// \returns the boolean value to determine to check the memory boundary by
+/// the guard pages in interpreter mode or not.
+WASMEDGE_CAPI_EXPORT extern bool
+WasmEdge_ConfigureIsGuardPageBoundsCheck(const WasmEdge_ConfigureContext *Cxt);
+
 /// Set the option of enabling/disabling AF_UNIX support in the WASI socket.
 ///
 /// This function is thread-safe.
@@ -980,6 +1295,31 @@ WasmEdge_ConfigureCompilerSetInterruptible(WasmEdge_ConfigureContext *Cxt,
 WASMEDGE_CAPI_EXPORT extern bool
 WasmEdge_ConfigureCompilerIsInterruptible(const WasmEdge_ConfigureContext *Cxt);
 
+/// Set the count of the threads of the AOT compiler.
+///
+/// If the count is larger than 1, the module is split into the same count of
+/// partitions, which are optimized and code-generated in parallel and linked
+/// together. The value 0 means the hardware concurrency. The default value is
+/// 1.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the count.
+/// \param Jobs the count of the threads.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureCompilerSetJobs(WasmEdge_ConfigureContext *Cxt,
+                                  const uint32_t Jobs);
+
+/// Get the count of the threads of the AOT compiler.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the count.
+///
+/// \returns the count of the threads.
+WASMEDGE_CAPI_EXPORT extern uint32_t
+WasmEdge_ConfigureCompilerGetJobs(const WasmEdge_ConfigureContext *Cxt);
+
 /// Set the instruction counting option for the statistics.
 ///
 /// This function is thread-safe.
@@ -1025,6 +1365,37 @@ WasmEdge_ConfigureStatisticsSetCostMeasuring(WasmEdge_ConfigureContext *Cxt,
 WASMEDGE_CAPI_EXPORT extern bool WasmEdge_ConfigureStatisticsIsCostMeasuring(
     const WasmEdge_ConfigureContext *Cxt);
 
+/// Set the basic block cost measuring option for the statistics.
+///
+/// With this option, the costs of the instructions in a basic block are
+/// summed when instantiating and charged once when entering the basic block in
+/// interpreter mode. The total cost is the same as the cost measured per
+/// instruction, but the cost limit is only checked at the control
+/// instructions. The cost table in the statistics should be set before
+/// instantiation. This option takes effect only when the cost measuring is
+/// enabled.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the boolean value.
+/// \param IsMeasure the boolean value to determine to measure the costs per
+/// basic block or not.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureStatisticsSetBlockCostMeasuring(
+    WasmEdge_ConfigureContext *Cxt, const bool IsMeasure);
+
+/// Get the basic block cost measuring option for the statistics.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the boolean value.
+///
+/// \returns the boolean value to determine to measure the costs per basic
+/// block or not.
+WASMEDGE_CAPI_EXPORT extern bool
+WasmEdge_ConfigureStatisticsIsBlockCostMeasuring(
+    const WasmEdge_ConfigureContext *Cxt);
+
 /// Set the time measuring option for the statistics.
 ///
 /// This function is thread-safe.
@@ -1697,6 +2068,59 @@ WasmEdge_CompilerDelete(WasmEdge_CompilerContext *Cxt);
 
 // <<<<<<<< WasmEdge AOT compiler functions <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
+// >>>>>>>> WasmEdge AOT cache functions >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+/// Get the statistics of the AOT cache.
+///
+/// The counters are accumulated in the current process by all VM contexts with
+/// the AOT cache or the module image cache enabled.
+///
+/// This function is thread-safe.
+///
+/// \param [out] Hits the count of the cached modules loaded. Can be NULL.
+/// \param [out] Misses the count of the modules not found or broken in the
+/// cache. Can be NULL.
+/// \param [out] Evictions the count of the cached modules evicted by the size
+/// limit. Can be NULL.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_AOTCacheGetStatistics(uint64_t *Hits, uint64_t *Misses,
+                               uint64_t *Evictions);
+
+// <<<<<<<< WasmEdge AOT cache functions <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+// >>>>>>>> WasmEdge memory pool functions >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+/// Set the capacity of the linear memory reservation pool.
+///
+/// Every memory instance reserves an inaccessible region for its guard pages.
+/// The released reservations are reset and kept in the pool up to the
+/// capacity, and reused by the following memory instances instead of mapping
+/// new regions. The missing slots are reserved immediately. The pool is shared
+/// by all contexts in the current process, and the default capacity 0
+/// disables it.
+///
+/// This function is thread-safe.
+///
+/// \param Capacity the count of the reservations kept in the pool.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_MemoryPoolSetCapacity(const uint32_t Capacity);
+
+/// Get the statistics of the linear memory reservation pool.
+///
+/// This function is thread-safe.
+///
+/// \param [out] Idle the count of the reservations in the pool. Can be NULL.
+/// \param [out] Live the count of the allocated memory instances. Can be NULL.
+/// \param [out] HighWater the maximum count of the allocated memory instances.
+/// Can be NULL.
+/// \param [out] Reused the count of the memory instances allocated from the
+/// pool. Can be NULL.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_MemoryPoolGetStatistics(uint32_t *Idle, uint64_t *Live,
+                                 uint64_t *HighWater, uint64_t *Reused);
+
+// <<<<<<<< WasmEdge memory pool functions <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
 // >>>>>>>> WasmEdge loader functions >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 
 /// Creation of the WasmEdge_LoaderContext.
@@ -1771,6 +2195,35 @@ WasmEdge_LoaderParseFromBytes(WasmEdge_LoaderContext *Cxt,
                               WasmEdge_ASTModuleContext **Module,
                               const WasmEdge_Bytes Bytes);
 
+/// Callback of reading the streaming source of the WASM binary.
+///
+/// The callback reads at most `Size` bytes into the `Buf`, and returns the read
+/// size. Return 0 for the end of the stream, or a negative value for the
+/// reading failure.
+typedef int64_t (*WasmEdge_StreamReadFunc_t)(void *Data, uint8_t *Buf,
+                                              const uint32_t Size);
+
+/// Load and parse the WASM module from a streaming source into
+/// WasmEdge_ASTModuleContext.
+///
+/// Load and parse the WASM module from the data read by the callback, and
+/// return a WasmEdge_ASTModuleContext as the result. The sections are parsed
+/// when the data arrived, and the callback will be called until the end of the
+/// module. The caller owns the WasmEdge_ASTModuleContext object and should call
+/// `WasmEdge_ASTModuleDelete` to destroy it.
+///
+/// \param Cxt the WasmEdge_LoaderContext.
+/// \param [out] Module the output WasmEdge_ASTModuleContext if succeeded.
+/// \param ReadFunc the callback to read the WASM binary.
+/// \param Data the additional object passed to the callback.
+///
+/// \returns WasmEdge_Result. Call `WasmEdge_ResultGetMessage` for the error
+/// message.
+WASMEDGE_CAPI_EXPORT extern WasmEdge_Result
+WasmEdge_LoaderParseFromStream(WasmEdge_LoaderContext *Cxt,
+                               WasmEdge_ASTModuleContext **Module,
+                               WasmEdge_StreamReadFunc_t ReadFunc, void *Data);
+
 /// Serialize the WasmEdge_ASTModuleContext into WASM binary.
 ///
 /// Serialize the loaded WasmEdge_ASTModuleContext into the WASM binary format.
@@ -1878,6 +2331,49 @@ WASMEDGE_CAPI_EXPORT extern WasmEdge_Result WasmEdge_ExecutorInstantiate(
     WasmEdge_ExecutorContext *Cxt, WasmEdge_ModuleInstanceContext **ModuleCxt,
     WasmEdge_StoreContext *StoreCxt, const WasmEdge_ASTModuleContext *ASTCxt);
 
+/// Instantiate an AST Module into a module instance from a snapshot.
+///
+/// Instantiate an AST Module as `WasmEdge_ExecutorInstantiate`, but restore the
+/// memories, tables, globals, and the dropped segments from the snapshot
+/// instead of initializing them. The start function is not executed. The
+/// snapshot should be saved from an instance of the same module. The caller
+/// owns the object and should call `WasmEdge_ModuleInstanceDelete` to destroy
+/// it.
+///
+/// \param Cxt the WasmEdge_ExecutorContext to instantiate the module.
+/// \param [out] ModuleCxt the output WasmEdge_ModuleInstanceContext if
+/// succeeded.
+/// \param StoreCxt the WasmEdge_StoreContext to link the imports.
+/// \param ASTCxt the WasmEdge AST Module context generated by loader or
+/// compiler.
+/// \param SnapCxt the WasmEdge_SnapshotContext to restore from.
+///
+/// \returns WasmEdge_Result. Call `WasmEdge_ResultGetMessage` for the error
+/// message.
+WASMEDGE_CAPI_EXPORT extern WasmEdge_Result
+WasmEdge_ExecutorInstantiateSnapshot(
+    WasmEdge_ExecutorContext *Cxt, WasmEdge_ModuleInstanceContext **ModuleCxt,
+    WasmEdge_StoreContext *StoreCxt, const WasmEdge_ASTModuleContext *ASTCxt,
+    const WasmEdge_SnapshotContext *SnapCxt);
+
+/// Save the snapshot of a module instance into a file.
+///
+/// The defined memories, tables, and globals, and the dropped segments of the
+/// module instance are saved. The imported instances and the states of the
+/// host modules are not saved. The references in the tables and globals
+/// should be null or refer to the functions of the module instance.
+///
+/// \param Cxt the WasmEdge_ExecutorContext.
+/// \param ModuleCxt the WasmEdge_ModuleInstanceContext to save.
+/// \param Path the output snapshot file path.
+///
+/// \returns WasmEdge_Result. Call `WasmEdge_ResultGetMessage` for the error
+/// message.
+WASMEDGE_CAPI_EXPORT extern WasmEdge_Result
+WasmEdge_ExecutorSaveSnapshot(WasmEdge_ExecutorContext *Cxt,
+                              const WasmEdge_ModuleInstanceContext *ModuleCxt,
+                              const char *Path);
+
 /// Instantiate an AST Module into a named module instance and link into store.
 ///
 /// Instantiate an AST Module with the module name, return the instantiated
@@ -1985,6 +2481,117 @@ WasmEdge_ExecutorDelete(WasmEdge_ExecutorContext *Cxt);
 
 // <<<<<<<< WasmEdge executor functions <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
+// >>>>>>>> WasmEdge snapshot functions >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+/// Load the snapshot from a file into a WasmEdge_SnapshotContext.
+///
+/// The memory contents in the snapshot are mapped into the module instances
+/// when instantiating from the snapshot, so the file should not be modified
+/// while the context is in use. The snapshot context can be used to
+/// instantiate the module repeatedly. The caller owns the object and should
+/// call `WasmEdge_SnapshotDelete` to destroy it.
+///
+/// \param [out] Cxt the output WasmEdge_SnapshotContext if succeeded.
+/// \param Path the snapshot file path.
+///
+/// \returns WasmEdge_Result. Call `WasmEdge_ResultGetMessage` for the error
+/// message.
+WASMEDGE_CAPI_EXPORT extern WasmEdge_Result
+WasmEdge_SnapshotLoad(WasmEdge_SnapshotContext **Cxt, const char *Path);
+
+/// Deletion of the WasmEdge_SnapshotContext.
+///
+/// After calling this function, the context will be destroyed and should
+/// __NOT__ be used.
+///
+/// \param Cxt the WasmEdge_SnapshotContext to destroy.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_SnapshotDelete(WasmEdge_SnapshotContext *Cxt);
+
+// <<<<<<<< WasmEdge snapshot functions <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+// >>>>>>>> WasmEdge instance pool functions >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+/// Creation of the WasmEdge_InstancePoolContext.
+///
+/// The pool instantiates the AST module into the anonymous module instances
+/// in the size, which is at least 1. The first instance is instantiated as
+/// usual, and the others are instantiated from the state of it. The released
+/// instances are reset to the state, so an acquired instance is the same as
+/// a newly instantiated one. The imported module instances are not reset.
+/// The executor, store, and AST module contexts should not be destroyed
+/// before the pool. The caller owns the object and should call
+/// `WasmEdge_InstancePoolDelete` to destroy it.
+///
+/// \param [out] Cxt the output WasmEdge_InstancePoolContext if succeeded.
+/// \param ExecCxt the WasmEdge_ExecutorContext to instantiate the module.
+/// \param StoreCxt the WasmEdge_StoreContext to link the imports.
+/// \param ASTCxt the WasmEdge AST Module context generated by loader or
+/// compiler.
+/// \param Size the count of the module instances created in advance.
+///
+/// \returns WasmEdge_Result. Call `WasmEdge_ResultGetMessage` for the error
+/// message.
+WASMEDGE_CAPI_EXPORT extern WasmEdge_Result WasmEdge_InstancePoolCreate(
+    WasmEdge_InstancePoolContext **Cxt, WasmEdge_ExecutorContext *ExecCxt,
+    WasmEdge_StoreContext *StoreCxt, const WasmEdge_ASTModuleContext *ASTCxt,
+    const uint32_t Size);
+
+/// Acquire a module instance from the WasmEdge_InstancePoolContext.
+///
+/// A new module instance is added into the pool if all the instances are
+/// acquired. The module instance is owned by the pool and should __NOT__ be
+/// destroyed by the caller.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_InstancePoolContext.
+/// \param [out] ModuleCxt the output WasmEdge_ModuleInstanceContext if
+/// succeeded.
+///
+/// \returns WasmEdge_Result. Call `WasmEdge_ResultGetMessage` for the error
+/// message.
+WASMEDGE_CAPI_EXPORT extern WasmEdge_Result
+WasmEdge_InstancePoolAcquire(WasmEdge_InstancePoolContext *Cxt,
+                             WasmEdge_ModuleInstanceContext **ModuleCxt);
+
+/// Release a module instance back to the WasmEdge_InstancePoolContext.
+///
+/// The module instance is reset and becomes idle. If the reset failed, the
+/// module instance is destroyed. After calling this function, the module
+/// instance should __NOT__ be used.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_InstancePoolContext.
+/// \param ModuleCxt the WasmEdge_ModuleInstanceContext acquired from the pool.
+///
+/// \returns WasmEdge_Result. Call `WasmEdge_ResultGetMessage` for the error
+/// message.
+WASMEDGE_CAPI_EXPORT extern WasmEdge_Result
+WasmEdge_InstancePoolRelease(WasmEdge_InstancePoolContext *Cxt,
+                             WasmEdge_ModuleInstanceContext *ModuleCxt);
+
+/// Get the count of the idle module instances in the
+/// WasmEdge_InstancePoolContext.
+///
+/// \param Cxt the WasmEdge_InstancePoolContext.
+///
+/// \returns the count of the idle module instances.
+WASMEDGE_CAPI_EXPORT extern uint32_t
+WasmEdge_InstancePoolGetIdleCount(const WasmEdge_InstancePoolContext *Cxt);
+
+/// Deletion of the WasmEdge_InstancePoolContext.
+///
+/// After calling this function, the context and all the module instances in
+/// the pool will be destroyed and should __NOT__ be used.
+///
+/// \param Cxt the WasmEdge_InstancePoolContext to destroy.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_InstancePoolDelete(WasmEdge_InstancePoolContext *Cxt);
+
+// <<<<<<<< WasmEdge instance pool functions <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
 // >>>>>>>> WasmEdge store functions >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 
 /// Creation of the WasmEdge_StoreContext.
@@ -3571,6 +4178,39 @@ WasmEdge_VMValidate(WasmEdge_VMContext *Cxt);
 WASMEDGE_CAPI_EXPORT extern WasmEdge_Result
 WasmEdge_VMInstantiate(WasmEdge_VMContext *Cxt);
 
+/// Instantiate the validated WASM module in the VM context from a snapshot.
+///
+/// Instantiate the validated WASM module as `WasmEdge_VMInstantiate`, but
+/// restore the states of the instance from the snapshot instead of
+/// initializing them. The start function is not executed.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_VMContext.
+/// \param SnapCxt the WasmEdge_SnapshotContext to restore from.
+///
+/// \returns WasmEdge_Result. Call `WasmEdge_ResultGetMessage` for the error
+/// message.
+WASMEDGE_CAPI_EXPORT extern WasmEdge_Result
+WasmEdge_VMInstantiateSnapshot(WasmEdge_VMContext *Cxt,
+                               const WasmEdge_SnapshotContext *SnapCxt);
+
+/// Save the snapshot of the instantiated WASM module in the VM context.
+///
+/// This function is usually called after executing the initialization function
+/// of the module, such as `_initialize`, and the snapshot can be used to skip
+/// the initialization in the other VM contexts.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_VMContext.
+/// \param Path the output snapshot file path.
+///
+/// \returns WasmEdge_Result. Call `WasmEdge_ResultGetMessage` for the error
+/// message.
+WASMEDGE_CAPI_EXPORT extern WasmEdge_Result
+WasmEdge_VMSaveSnapshot(WasmEdge_VMContext *Cxt, const char *Path);
+
 /// Invoke a WASM function by name.
 ///
 /// This is the final step to invoke a WASM function step by step.
@@ -16,6 +16,8 @@
 
 #include "ast/instruction.h"
 
+#include <memory>
+
 namespace WasmEdge {
 namespace AST {
 
@@ -23,13 +25,39 @@ namespace AST {
 class Expression {
 public:
   /// Getter of instructions vector.
-  InstrView getInstrs() const noexcept { return Instrs; }
-  InstrVec &getInstrs() noexcept { return Instrs; }
+  InstrView getInstrs() const noexcept {
+    return InstrsHolder ? InstrsView : InstrView(Instrs);
+  }
+  InstrVec &getInstrs() noexcept {
+    if (InstrsHolder) {
+      // Own the referenced instructions to be modified.
+      Instrs.assign(InstrsView.begin(), InstrsView.end());
+      InstrsView = {};
+      InstrsHolder.reset();
+    }
+    return Instrs;
+  }
+
+  /// Getter of the holder of the referenced instructions. Returns null if the
+  /// instructions are owned by this expression.
+  const std::shared_ptr<const void> &getInstrsHolder() const noexcept {
+    return InstrsHolder;
+  }
+
+  /// Setter of the instructions loaded from the module image, which are kept
+  /// alive by the holder.
+  void setInstrs(InstrView View, std::shared_ptr<const void> Holder) noexcept {
+    Instrs.clear();
+    InstrsView = View;
+    InstrsHolder = std::move(Holder);
+  }
 
 private:
   /// \name Data of Expression.
   /// @{
   InstrVec Instrs;
+  InstrView InstrsView;
+  std::shared_ptr<const void> InstrsHolder;
   /// @}
 };
 
@@ -18,6 +18,7 @@
 #include "common/types.h"
 
 #include <algorithm>
+#include <cstring>
 #include <vector>
 
 namespace WasmEdge {
@@ -63,17 +64,14 @@ public:
   /// Constructor assigns the OpCode and the Offset.
   Instruction(OpCode Byte, uint32_t Off = 0) noexcept
       : Offset(Off), Code(Byte) {
-#if defined(__x86_64__) || defined(__aarch64__) ||                             \
-    (defined(__riscv) && __riscv_xlen == 64)
-    Data.Num = static_cast<uint128_t>(0);
-#else
     Data.Num.Low = static_cast<uint64_t>(0);
     Data.Num.High = static_cast<uint64_t>(0);
-#endif
     Flags.IsAllocLabelList = false;
     Flags.IsAllocValTypeList = false;
     Flags.IsAllocBrCast = false;
     Flags.IsAllocTryCatch = false;
+    Flags.IsMeterLeader = false;
+    Flags.IsMeterSync = false;
   }
 
   /// Copy constructor.
@@ -117,8 +115,9 @@ public:
     return *this;
   }
 
-  /// Getter of OpCode.
+  /// Getter and setter of OpCode.
   OpCode getOpCode() const noexcept { return Code; }
+  void setOpCode(const OpCode C) noexcept { Code = C; }
 
   /// Getter of Offset.
   uint32_t getOffset() const noexcept { return Offset; }
@@ -235,21 +234,33 @@ public:
 
   /// Getter and setter of the constant value.
   ValVariant getNum() const noexcept {
-#if defined(__x86_64__) || defined(__aarch64__) ||                             \
-    (defined(__riscv) && __riscv_xlen == 64)
-    return ValVariant(Data.Num);
-#else
-    uint128_t N(Data.Num.High, Data.Num.Low);
+    uint128_t N;
+    std::memcpy(&N, &Data.Num, sizeof(uint128_t));
     return ValVariant(N);
-#endif
   }
   void setNum(ValVariant N) noexcept {
-#if defined(__x86_64__) || defined(__aarch64__) ||                             \
-    (defined(__riscv) && __riscv_xlen == 64)
-    Data.Num = N.get<uint128_t>();
-#else
     std::memcpy(&Data.Num, &N.get<uint128_t>(), sizeof(uint128_t));
-#endif
+  }
+
+  /// Getter and setter of the register operands for lowered instructions.
+  OpCode getRegOpCode() const noexcept { return Data.Regs.Code; }
+  OpCode &getRegOpCode() noexcept { return Data.Regs.Code; }
+  uint32_t getRegSrc1() const noexcept { return Data.Regs.Src1; }
+  uint32_t &getRegSrc1() noexcept { return Data.Regs.Src1; }
+  uint32_t getRegSrc2() const noexcept { return Data.Regs.Src2; }
+  uint32_t &getRegSrc2() noexcept { return Data.Regs.Src2; }
+  uint32_t getRegDst() const noexcept { return Data.Regs.Dst; }
+  uint32_t &getRegDst() noexcept { return Data.Regs.Dst; }
+
+  /// Getter and setter of the basic block metering flags. The costs of the
+  /// basic blocks are kept in the side table of the function instance.
+  bool isMeterLeader() const noexcept { return Flags.IsMeterLeader; }
+  void setMeterLeader(const bool Leader = true) noexcept {
+    Flags.IsMeterLeader = Leader;
+  }
+  bool isMeterSync() const noexcept { return Flags.IsMeterSync; }
+  void setMeterSync(const bool Sync = true) noexcept {
+    Flags.IsMeterSync = Sync;
   }
 
   /// Getter and setter of BrCast info for Br_cast instructions.
@@ -271,6 +282,13 @@ public:
   const TryDescriptor &getTryCatch() const noexcept { return *Data.TryCatch; }
   TryDescriptor &getTryCatch() noexcept { return *Data.TryCatch; }
 
+  /// Check the payload is allocated out of the instruction node. The node of
+  /// such instruction cannot be copied bytewise.
+  bool isAllocPayload() const noexcept {
+    return Flags.IsAllocLabelList || Flags.IsAllocValTypeList ||
+           Flags.IsAllocBrCast || Flags.IsAllocTryCatch;
+  }
+
 private:
   /// Release allocated resources.
   void reset() noexcept {
@@ -335,16 +353,12 @@ private:
       uint32_t MemOffset;
       uint8_t MemLane;
     } Memories;
-    // Type 8: Num.
-#if defined(__x86_64__) || defined(__aarch64__) ||                             \
-    (defined(__riscv) && __riscv_xlen == 64)
-    uint128_t Num;
-#else
+    // Type 8: Num. The 128-bit value is stored in halves, so the instruction is
+    // only 8-byte aligned.
     struct {
       uint64_t Low;
       uint64_t High;
     } Num;
-#endif
     // Type 9: End flags.
     struct {
       bool IsExprLast : 1;
@@ -359,6 +373,14 @@ private:
     // LEGACY-EH: remove this case after deprecating legacy EH.
     // Type 12: Legacy Catch descriptor.
     CatchDescriptorLegacy CatchLegacy;
+    // Type 13: Register operands of the lowered instructions. The source and
+    // destination are the stack offsets at the entry of the instruction.
+    struct {
+      OpCode Code;
+      uint32_t Src1;
+      uint32_t Src2;
+      uint32_t Dst;
+    } Regs;
   } Data;
   uint32_t Offset = 0;
   OpCode Code = OpCode::End;
@@ -367,10 +389,16 @@ private:
     bool IsAllocValTypeList : 1;
     bool IsAllocBrCast : 1;
     bool IsAllocTryCatch : 1;
+    bool IsMeterLeader : 1;
+    bool IsMeterSync : 1;
   } Flags;
   /// @}
 };
 
+/// The instructions are executed in place by the interpreter. Keep the node in
+/// 24 bytes, and store the rare payloads out of line.
+static_assert(sizeof(Instruction) <= 24);
+
 // Type aliasing
 using InstrVec = std::vector<Instruction>;
 using InstrView = Span<const Instruction>;
@@ -16,9 +16,14 @@
 
 #include "ast/section.h"
 
+#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace WasmEdge {
+
+class MemoryImage;
+
 namespace AST {
 
 /// AST Module node.
@@ -78,6 +83,15 @@ public:
   bool getIsValidated() const noexcept { return IsValidated; }
   void setIsValidated(bool V = true) noexcept { IsValidated = V; }
 
+  /// Initial memory images, which are built by the first instantiation and
+  /// shared by the copies of the module. The images are indexed by the memory
+  /// index, and null for the memories initialized by copying the data.
+  struct MemoryImages {
+    std::once_flag Built;
+    std::vector<std::shared_ptr<const MemoryImage>> Images;
+  };
+  MemoryImages &getMemoryImages() const noexcept { return *MemImages; }
+
 private:
   /// \name Data of Module node.
   /// @{
@@ -113,6 +127,11 @@ private:
   /// @{
   bool IsValidated = false;
   /// @}
+
+  /// \name Initial memory images of the instances.
+  /// @{
+  std::shared_ptr<MemoryImages> MemImages = std::make_shared<MemoryImages>();
+  /// @}
 };
 
 class CoreModuleSection : public Section {
@@ -22,6 +22,7 @@
 #include "ast/description.h"
 #include "ast/segment.h"
 
+#include <memory>
 #include <optional>
 #include <vector>
 
@@ -55,14 +56,34 @@ public:
   void setName(std::string_view N) { Name = N; }
 
   /// Getter of content vector.
-  Span<const Byte> getContent() const noexcept { return Content; }
-  std::vector<Byte> &getContent() noexcept { return Content; }
+  Span<const Byte> getContent() const noexcept {
+    return ContentHolder ? ContentView : Span<const Byte>(Content);
+  }
+  std::vector<Byte> &getContent() noexcept {
+    if (ContentHolder) {
+      // Own the referenced content to be modified.
+      Content.assign(ContentView.begin(), ContentView.end());
+      ContentView = {};
+      ContentHolder.reset();
+    }
+    return Content;
+  }
+
+  /// Setter of the content referencing the loaded image kept by the holder.
+  void setContent(Span<const Byte> View,
+                  std::shared_ptr<const void> Holder) noexcept {
+    Content.clear();
+    ContentView = View;
+    ContentHolder = std::move(Holder);
+  }
 
 private:
   /// \name Data of CustomSection.
   /// @{
   std::string Name;
   std::vector<Byte> Content;
+  Span<const Byte> ContentView;
+  std::shared_ptr<const void> ContentHolder;
   /// @}
 };
 
@@ -17,11 +17,23 @@
 #include "ast/expression.h"
 #include "ast/type.h"
 
+#include <memory>
 #include <vector>
 
 namespace WasmEdge {
 namespace AST {
 
+/// Interface of the function body which is decoded and validated on demand in
+/// the lazy loading mode.
+class LazyFunctionBody {
+public:
+  virtual ~LazyFunctionBody() noexcept = default;
+
+  /// Load the expression and the maximum value stack height of the body.
+  virtual Expect<void> load(Expression &Expr,
+                            uint32_t &MaxStackHeight) const = 0;
+};
+
 /// Segment's base class.
 class Segment {
 public:
@@ -116,12 +128,27 @@ public:
   const auto &getSymbol() const noexcept { return FuncSymbol; }
   void setSymbol(Symbol<void> S) noexcept { FuncSymbol = std::move(S); }
 
+  /// Getter and setter of the maximum value stack height of the expression.
+  uint32_t getMaxStackHeight() const noexcept { return MaxStackHeight; }
+  void setMaxStackHeight(uint32_t Height) noexcept { MaxStackHeight = Height; }
+
+  /// Getter and setter of the lazy function body. The expression is empty when
+  /// the body is loaded lazily.
+  const std::shared_ptr<const LazyFunctionBody> &getLazyBody() const noexcept {
+    return LazyBody;
+  }
+  void setLazyBody(std::shared_ptr<const LazyFunctionBody> Body) noexcept {
+    LazyBody = std::move(Body);
+  }
+
 private:
   /// \name Data of CodeSegment node.
   /// @{
   uint32_t SegSize = 0;
+  uint32_t MaxStackHeight = 0;
   std::vector<std::pair<uint32_t, ValType>> Locals;
   Symbol<void> FuncSymbol;
+  std::shared_ptr<const LazyFunctionBody> LazyBody;
   /// @}
 };
 
@@ -140,8 +167,32 @@ public:
   void setIdx(uint32_t Idx) noexcept { MemoryIdx = Idx; }
 
   /// Getter of data.
-  Span<const Byte> getData() const noexcept { return Data; }
-  std::vector<Byte> &getData() noexcept { return Data; }
+  Span<const Byte> getData() const noexcept {
+    return DataHolder ? DataView : Span<const Byte>(Data);
+  }
+  std::vector<Byte> &getData() noexcept {
+    if (DataHolder) {
+      // Own the referenced data to be modified.
+      Data.assign(DataView.begin(), DataView.end());
+      DataView = {};
+      DataHolder.reset();
+    }
+    return Data;
+  }
+
+  /// Getter of the holder of the referenced data. Returns null if the data is
+  /// owned by this node.
+  const std::shared_ptr<const void> &getDataHolder() const noexcept {
+    return DataHolder;
+  }
+
+  /// Setter of the data referencing the loaded image kept by the holder.
+  void setData(Span<const Byte> View,
+               std::shared_ptr<const void> Holder) noexcept {
+    Data.clear();
+    DataView = View;
+    DataHolder = std::move(Holder);
+  }
 
 private:
   /// \name Data of DataSegment node.
@@ -149,6 +200,8 @@ private:
   DataMode Mode = DataMode::Active;
   uint32_t MemoryIdx = 0;
   std::vector<Byte> Data;
+  Span<const Byte> DataView;
+  std::shared_ptr<const void> DataHolder;
   /// @}
 };
 
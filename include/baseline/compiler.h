@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/baseline/compiler.h - Baseline compiler definition -------===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file is the definition class of the single-pass baseline compiler,
+/// which emits x86-64 machine code from the validated instructions without
+/// LLVM.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include "ast/module.h"
+#include "common/configure.h"
+#include "common/errcode.h"
+#include "common/executable.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace WasmEdge::Baseline {
+
+/// Holder class of the machine code emitted by the baseline compiler.
+class CodeLibrary : public Executable {
+public:
+  CodeLibrary() noexcept = default;
+  ~CodeLibrary() noexcept override;
+
+  /// Copy the machine code into the executable memory.
+  Expect<void> load(std::vector<uint8_t> Code,
+                    std::vector<uint64_t> Offsets) noexcept;
+
+  /// The intrinsics table slot referenced by the machine code.
+  const IntrinsicsTable *const *getIntrinsicsSlot() const noexcept {
+    return &IntrinsicsSlot;
+  }
+
+  Symbol<const IntrinsicsTable *> getIntrinsics() noexcept override;
+
+  std::vector<Symbol<Wrapper>> getTypes(size_t Size) noexcept override;
+
+  std::vector<Symbol<void>> getCodes(size_t Offset,
+                                     size_t Size) noexcept override;
+
+  /// Offset of the function which is not compiled.
+  static inline constexpr const uint64_t kNoCode = UINT64_MAX;
+
+private:
+  const IntrinsicsTable *IntrinsicsSlot = nullptr;
+  uint8_t *Binary = nullptr;
+  uint64_t BinarySize = 0;
+  std::vector<uint64_t> CodeOffsets;
+};
+
+/// Compiling the functions of a validated module into x86-64 machine code in
+/// one pass over the instructions. The functions using the instructions out of
+/// the supported subset are skipped and keep running in the interpreter.
+class Compiler {
+public:
+  Compiler(const Configure &Conf) noexcept : Conf(Conf) {}
+
+  Expect<std::shared_ptr<Executable>> compile(const AST::Module &Module);
+
+  /// Check the host and the configuration can run the baseline code.
+  static bool isSupported(const Configure &Conf) noexcept;
+
+private:
+  const Configure Conf;
+};
+
+} // namespace WasmEdge::Baseline
@@ -37,7 +37,8 @@ public:
         OFormat(RHS.OFormat.load(std::memory_order_relaxed)),
         DumpIR(RHS.DumpIR.load(std::memory_order_relaxed)),
         GenericBinary(RHS.GenericBinary.load(std::memory_order_relaxed)),
-        Interruptible(RHS.Interruptible.load(std::memory_order_relaxed)) {}
+        Interruptible(RHS.Interruptible.load(std::memory_order_relaxed)),
+        Jobs(RHS.Jobs.load(std::memory_order_relaxed)) {}
 
   /// AOT compiler optimization level enum class.
   enum class OptimizationLevel : uint8_t {
@@ -101,12 +102,24 @@ public:
     return Interruptible.load(std::memory_order_relaxed);
   }
 
+  /// Count of the threads to optimize and generate the code. The module is
+  /// split into the same count of partitions if larger than 1, and 0 for the
+  /// hardware concurrency.
+  void setJobs(uint32_t Count) noexcept {
+    Jobs.store(Count, std::memory_order_relaxed);
+  }
+
+  uint32_t getJobs() const noexcept {
+    return Jobs.load(std::memory_order_relaxed);
+  }
+
 private:
   std::atomic<OptimizationLevel> OptLevel = OptimizationLevel::O3;
   std::atomic<OutputFormat> OFormat = OutputFormat::Wasm;
   std::atomic<bool> DumpIR = false;
   std::atomic<bool> GenericBinary = false;
   std::atomic<bool> Interruptible = false;
+  std::atomic<uint32_t> Jobs = 1;
 };
 
 class RuntimeConfigure {
@@ -114,8 +127,25 @@ public:
   RuntimeConfigure() noexcept = default;
   RuntimeConfigure(const RuntimeConfigure &RHS) noexcept
       : MaxMemPage(RHS.MaxMemPage.load(std::memory_order_relaxed)),
+        MaxCallStackDepth(
+            RHS.MaxCallStackDepth.load(std::memory_order_relaxed)),
         EnableJIT(RHS.EnableJIT.load(std::memory_order_relaxed)),
+        EnableTieredJIT(RHS.EnableTieredJIT.load(std::memory_order_relaxed)),
+        TierUpThreshold(RHS.TierUpThreshold.load(std::memory_order_relaxed)),
+        EnableAOTCache(RHS.EnableAOTCache.load(std::memory_order_relaxed)),
+        AOTCacheSizeLimit(
+            RHS.AOTCacheSizeLimit.load(std::memory_order_relaxed)),
+        EnableImageCache(RHS.EnableImageCache.load(std::memory_order_relaxed)),
+        LoadingJobs(RHS.LoadingJobs.load(std::memory_order_relaxed)),
+        LazyLoading(RHS.LazyLoading.load(std::memory_order_relaxed)),
+        ValidationJobs(RHS.ValidationJobs.load(std::memory_order_relaxed)),
         ForceInterpreter(RHS.ForceInterpreter.load(std::memory_order_relaxed)),
+        ThreadedInterpreter(
+            RHS.ThreadedInterpreter.load(std::memory_order_relaxed)),
+        RegisterInterpreter(
+            RHS.RegisterInterpreter.load(std::memory_order_relaxed)),
+        GuardPageBoundsCheck(
+            RHS.GuardPageBoundsCheck.load(std::memory_order_relaxed)),
         AllowAFUNIX(RHS.AllowAFUNIX.load(std::memory_order_relaxed)) {}
 
   void setMaxMemoryPage(const uint32_t Page) noexcept {
@@ -126,6 +156,14 @@ public:
     return MaxMemPage.load(std::memory_order_relaxed);
   }
 
+  void setMaxCallStackDepth(const uint32_t Depth) noexcept {
+    MaxCallStackDepth.store(Depth, std::memory_order_relaxed);
+  }
+
+  uint32_t getMaxCallStackDepth() const noexcept {
+    return MaxCallStackDepth.load(std::memory_order_relaxed);
+  }
+
   void setEnableJIT(bool IsEnableJIT) noexcept {
     EnableJIT.store(IsEnableJIT, std::memory_order_relaxed);
   }
@@ -134,6 +172,78 @@ public:
     return EnableJIT.load(std::memory_order_relaxed);
   }
 
+  void setEnableTieredJIT(bool IsEnableTieredJIT) noexcept {
+    EnableTieredJIT.store(IsEnableTieredJIT, std::memory_order_relaxed);
+  }
+
+  bool isEnableTieredJIT() const noexcept {
+    return EnableTieredJIT.load(std::memory_order_relaxed);
+  }
+
+  void setTierUpThreshold(const uint32_t Threshold) noexcept {
+    TierUpThreshold.store(Threshold, std::memory_order_relaxed);
+  }
+
+  uint32_t getTierUpThreshold() const noexcept {
+    return TierUpThreshold.load(std::memory_order_relaxed);
+  }
+
+  void setEnableAOTCache(bool IsEnableAOTCache) noexcept {
+    EnableAOTCache.store(IsEnableAOTCache, std::memory_order_relaxed);
+  }
+
+  bool isEnableAOTCache() const noexcept {
+    return EnableAOTCache.load(std::memory_order_relaxed);
+  }
+
+  void setAOTCacheSizeLimit(const uint64_t Limit) noexcept {
+    AOTCacheSizeLimit.store(Limit, std::memory_order_relaxed);
+  }
+
+  uint64_t getAOTCacheSizeLimit() const noexcept {
+    return AOTCacheSizeLimit.load(std::memory_order_relaxed);
+  }
+
+  /// Load the pre-decoded module image from the local cache instead of the
+  /// WASM binary, or create the image into the cache after validation.
+  void setEnableImageCache(bool IsEnableImageCache) noexcept {
+    EnableImageCache.store(IsEnableImageCache, std::memory_order_relaxed);
+  }
+
+  bool isEnableImageCache() const noexcept {
+    return EnableImageCache.load(std::memory_order_relaxed);
+  }
+
+  /// Count of the threads to decode the function bodies, 0 for the hardware
+  /// concurrency.
+  void setLoadingJobs(const uint32_t Count) noexcept {
+    LoadingJobs.store(Count, std::memory_order_relaxed);
+  }
+
+  uint32_t getLoadingJobs() const noexcept {
+    return LoadingJobs.load(std::memory_order_relaxed);
+  }
+
+  /// Decode and validate the function bodies on their first calls in the
+  /// interpreter mode.
+  void setLazyLoading(bool IsLazyLoading) noexcept {
+    LazyLoading.store(IsLazyLoading, std::memory_order_relaxed);
+  }
+
+  bool isLazyLoading() const noexcept {
+    return LazyLoading.load(std::memory_order_relaxed);
+  }
+
+  /// Count of the threads to validate the function bodies, 0 for the hardware
+  /// concurrency.
+  void setValidationJobs(const uint32_t Count) noexcept {
+    ValidationJobs.store(Count, std::memory_order_relaxed);
+  }
+
+  uint32_t getValidationJobs() const noexcept {
+    return ValidationJobs.load(std::memory_order_relaxed);
+  }
+
   void setForceInterpreter(bool IsForceInterpreter) noexcept {
     ForceInterpreter.store(IsForceInterpreter, std::memory_order_relaxed);
   }
@@ -142,6 +252,31 @@ public:
     return ForceInterpreter.load(std::memory_order_relaxed);
   }
 
+  void setThreadedInterpreter(bool IsThreadedInterpreter) noexcept {
+    ThreadedInterpreter.store(IsThreadedInterpreter, std::memory_order_relaxed);
+  }
+
+  bool isThreadedInterpreter() const noexcept {
+    return ThreadedInterpreter.load(std::memory_order_relaxed);
+  }
+
+  void setRegisterInterpreter(bool IsRegisterInterpreter) noexcept {
+    RegisterInterpreter.store(IsRegisterInterpreter, std::memory_order_relaxed);
+  }
+
+  bool isRegisterInterpreter() const noexcept {
+    return RegisterInterpreter.load(std::memory_order_relaxed);
+  }
+
+  void setGuardPageBoundsCheck(bool IsGuardPageBoundsCheck) noexcept {
+    GuardPageBoundsCheck.store(IsGuardPageBoundsCheck,
+                               std::memory_order_relaxed);
+  }
+
+  bool isGuardPageBoundsCheck() const noexcept {
+    return GuardPageBoundsCheck.load(std::memory_order_relaxed);
+  }
+
   void setAllowAFUNIX(bool IsAllowAFUNIX) noexcept {
     AllowAFUNIX.store(IsAllowAFUNIX, std::memory_order_relaxed);
   }
@@ -152,8 +287,21 @@ public:
 
 private:
   std::atomic<uint32_t> MaxMemPage = 65536;
+  std::atomic<uint32_t> MaxCallStackDepth = 65536;
   std::atomic<bool> EnableJIT = false;
+  std::atomic<bool> EnableTieredJIT = false;
+  std::atomic<uint32_t> TierUpThreshold = 10000;
+  std::atomic<bool> EnableAOTCache = false;
+  /// Byte budget of the AOT cache directory, 0 for unlimited.
+  std::atomic<uint64_t> AOTCacheSizeLimit = 0;
+  std::atomic<bool> EnableImageCache = false;
+  std::atomic<uint32_t> LoadingJobs = 1;
+  std::atomic<bool> LazyLoading = false;
+  std::atomic<uint32_t> ValidationJobs = 1;
   std::atomic<bool> ForceInterpreter = false;
+  std::atomic<bool> ThreadedInterpreter = false;
+  std::atomic<bool> RegisterInterpreter = false;
+  std::atomic<bool> GuardPageBoundsCheck = false;
   std::atomic<bool> AllowAFUNIX = false;
 };
 
@@ -163,6 +311,8 @@ public:
   StatisticsConfigure(const StatisticsConfigure &RHS) noexcept
       : InstrCounting(RHS.InstrCounting.load(std::memory_order_relaxed)),
         CostMeasuring(RHS.CostMeasuring.load(std::memory_order_relaxed)),
+        BlockCostMeasuring(
+            RHS.BlockCostMeasuring.load(std::memory_order_relaxed)),
         TimeMeasuring(RHS.TimeMeasuring.load(std::memory_order_relaxed)) {}
 
   void setInstructionCounting(bool IsCount) noexcept {
@@ -181,6 +331,14 @@ public:
     return CostMeasuring.load(std::memory_order_relaxed);
   }
 
+  void setBlockCostMeasuring(bool IsMeasure) noexcept {
+    BlockCostMeasuring.store(IsMeasure, std::memory_order_relaxed);
+  }
+
+  bool isBlockCostMeasuring() const noexcept {
+    return BlockCostMeasuring.load(std::memory_order_relaxed);
+  }
+
   void setTimeMeasuring(bool IsTimeMeasure) noexcept {
     TimeMeasuring.store(IsTimeMeasure, std::memory_order_relaxed);
   }
@@ -200,6 +358,7 @@ public:
 private:
   std::atomic<bool> InstrCounting = false;
   std::atomic<bool> CostMeasuring = false;
+  std::atomic<bool> BlockCostMeasuring = false;
   std::atomic<bool> TimeMeasuring = false;
 
   std::atomic<uint64_t> CostLimit = std::numeric_limits<uint64_t>::max();
@@ -49,7 +49,7 @@ static inline constexpr auto ASTNodeAttrStr = []() constexpr {
 }();
 
 /// Instruction opcode enumeration class.
-enum class OpCode : uint32_t {
+enum class OpCode : uint16_t {
 #define UseOpCode
 #define Line(NAME, STRING, PREFIX) NAME,
 #define Line_FB(NAME, STRING, PREFIX, EXTEND) NAME,
@@ -63,6 +63,11 @@ enum class OpCode : uint32_t {
 #undef Line_FD
 #undef Line_FE
 #undef UseOpCode
+#define UseInternalOpCode
+#define Line(NAME, STRING) NAME,
+#include "enum.inc"
+#undef Line
+#undef UseInternalOpCode
 };
 
 /// Instruction opcode enumeration string mapping.
@@ -82,6 +87,11 @@ static inline constexpr const auto OpCodeStr = []() constexpr {
 #undef Line_FD
 #undef Line_FE
 #undef UseOpCode
+#define UseInternalOpCode
+#define Line(NAME, STRING) {OpCode::NAME, STRING},
+#include "enum.inc"
+#undef Line
+#undef UseInternalOpCode
   };
   return SpareEnumMap(Array);
 }();
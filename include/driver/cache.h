@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/driver/cache.h - Cache entrypoint ------------------------===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contents the entrypoint for the AOT cache management tool.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+#include "po/argument_parser.h"
+#include <cstdint>
+#include <string_view>
+
+namespace WasmEdge {
+namespace Driver {
+
+using namespace std::literals;
+
+struct DriverCacheOptions {
+  DriverCacheOptions()
+      : WasmNames(PO::Description("Wasm files to compile into the cache"sv),
+                  PO::MetaVar("WASM"sv)),
+        Clear(PO::Description("Remove all the cached modules"sv)),
+        SizeLimit(
+            PO::Description(
+                "Evict the least recently used cached modules until the cache size in bytes is within the limit, default value is 0 for no limitations"sv),
+            PO::MetaVar("BYTES"sv), PO::DefaultValue<uint64_t>(0)) {}
+
+  PO::List<std::string> WasmNames;
+  PO::Option<PO::Toggle> Clear;
+  PO::Option<uint64_t> SizeLimit;
+
+  void add_option(PO::ArgumentParser &Parser) noexcept {
+    Parser.add_option(WasmNames)
+        .add_option("clear"sv, Clear)
+        .add_option("size-limit"sv, SizeLimit);
+  }
+};
+
+int Cache(struct DriverCacheOptions &Opt) noexcept;
+
+} // namespace Driver
+} // namespace WasmEdge
@@ -13,6 +13,7 @@
 //===----------------------------------------------------------------------===//
 #pragma once
 #include "po/argument_parser.h"
+#include <cstdint>
 #include <string_view>
 
 namespace WasmEdge {
@@ -58,7 +59,11 @@ struct DriverCompilerOptions {
         PropAll(PO::Description("Enable all features"sv)),
         PropOptimizationLevel(
             PO::Description("Optimization level, one of 0, 1, 2, 3, s, z."sv),
-            PO::DefaultValue(std::string("2"))) {}
+            PO::DefaultValue(std::string("2"))),
+        ConfJobs(
+            PO::Description(
+                "Count of the threads to optimize and generate the code in parallel, 0 for the hardware concurrency. Default value is 1."sv),
+            PO::MetaVar("N"sv), PO::DefaultValue<uint32_t>(1)) {}
 
   PO::Option<std::string> WasmName;
   PO::Option<std::string> SoName;
@@ -83,6 +88,7 @@ struct DriverCompilerOptions {
   PO::Option<PO::Toggle> PropFunctionReference;
   PO::Option<PO::Toggle> PropAll;
   PO::Option<std::string> PropOptimizationLevel;
+  PO::Option<uint32_t> ConfJobs;
 
   void add_option(PO::ArgumentParser &Parser) noexcept {
     Parser.add_option(WasmName)
@@ -107,7 +113,8 @@ struct DriverCompilerOptions {
         .add_option("enable-threads"sv, PropThreads)
         .add_option("enable-function-reference"sv, PropFunctionReference)
         .add_option("enable-all"sv, PropAll)
-        .add_option("optimize"sv, PropOptimizationLevel);
+        .add_option("optimize"sv, PropOptimizationLevel)
+        .add_option("jobs"sv, ConfJobs);
   }
 };
 
@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/driver/snapshot.h - Snapshot entrypoint ------------------===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contents the entrypoint for the snapshot tool, which saves the
+/// module instance after the initialization.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+#include "po/argument_parser.h"
+#include <string_view>
+
+namespace WasmEdge {
+namespace Driver {
+
+using namespace std::literals;
+
+struct DriverSnapshotOptions {
+  DriverSnapshotOptions()
+      : WasmName(PO::Description("Wasm file to initialize"sv),
+                 PO::MetaVar("WASM"sv)),
+        SnapshotName(PO::Description("Output snapshot file"sv),
+                     PO::MetaVar("SNAPSHOT"sv)),
+        InitFunc(PO::Description(
+                     "Exported function to initialize the module instance "
+                     "before saving the snapshot, default value is "
+                     "`_initialize`. The function is skipped if not exported."sv),
+                 PO::MetaVar("FUNCTION"sv),
+                 PO::DefaultValue<std::string>("_initialize")),
+        Dir(PO::Description(
+                "Binding directories into WASI virtual filesystem for the "
+                "initialization. Each directory can be specified as --dir "
+                "`guest_path:host_path`."sv),
+            PO::MetaVar("PREOPEN_DIRS"sv)),
+        Env(PO::Description(
+                "Environ variables for the initialization. Each variable can be specified as --env `NAME=VALUE`."sv),
+            PO::MetaVar("ENVS"sv)) {}
+
+  PO::Option<std::string> WasmName;
+  PO::Option<std::string> SnapshotName;
+  PO::Option<std::string> InitFunc;
+  PO::List<std::string> Dir;
+  PO::List<std::string> Env;
+
+  void add_option(PO::ArgumentParser &Parser) noexcept {
+    Parser.add_option(WasmName)
+        .add_option(SnapshotName)
+        .add_option("init-func"sv, InitFunc)
+        .add_option("dir"sv, Dir)
+        .add_option("env"sv, Env);
+  }
+};
+
+int Snapshot(struct DriverSnapshotOptions &Opt) noexcept;
+
+} // namespace Driver
+} // namespace WasmEdge
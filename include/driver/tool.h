@@ -72,14 +72,30 @@ struct DriverToolOptions {
             "Enable generating code for counting Wasm instructions executed."sv)),
         ConfEnableGasMeasuring(PO::Description(
             "Enable generating code for counting gas burned during execution."sv)),
+        ConfEnableBlockGasMeasuring(PO::Description(
+            "Enable counting gas burned per basic block in interpreter mode. This option also enables gas measuring."sv)),
         ConfEnableTimeMeasuring(PO::Description(
             "Enable generating code for counting time during execution."sv)),
         ConfEnableAllStatistics(PO::Description(
             "Enable generating code for all statistics options include instruction counting, gas measuring, and execution time"sv)),
         ConfEnableJIT(
             PO::Description("Enable Just-In-Time compiler for running WASM"sv)),
+        ConfEnableTieredJIT(PO::Description(
+            "Run WASM in interpreter mode first, and compile the module by the Just-In-Time compiler in the background for the hot functions."sv)),
+        ConfEnableAOTCache(PO::Description(
+            "Load the AOT compiled module from the local cache, or compile the module into the cache in the background for the next run."sv)),
+        ConfEnableImageCache(PO::Description(
+            "Load the pre-decoded module image from the local cache, or create the image into the cache after the validation for the next run."sv)),
         ConfForceInterpreter(
             PO::Description("Forcibly run WASM in interpreter mode."sv)),
+        ConfThreadedInterpreter(PO::Description(
+            "Use the direct-threaded dispatch engine in interpreter mode."sv)),
+        ConfRegisterInterpreter(PO::Description(
+            "Lower the functions into the register-based bytecode in interpreter mode."sv)),
+        ConfLazyLoading(PO::Description(
+            "Decode and validate the function bodies on their first calls in interpreter mode."sv)),
+        ConfGuardPageBoundsCheck(PO::Description(
+            "Check the memory boundary by the guard pages instead of the software checks in interpreter mode."sv)),
         TimeLim(
             PO::Description(
                 "Limitation of maximum time(in milliseconds) for execution, default value is 0 for no limitations"sv),
@@ -92,6 +108,34 @@ struct DriverToolOptions {
             PO::Description(
                 "Limitation of pages(as size of 64 KiB) in every memory instance. Upper bound can be specified as --memory-page-limit `PAGE_COUNT`."sv),
             PO::MetaVar("PAGE_COUNT"sv)),
+        CallDepthLim(
+            PO::Description(
+                "Limitation of the call stack depth in execution. Upper bound can be specified as --call-depth-limit `DEPTH`."sv),
+            PO::MetaVar("DEPTH"sv)),
+        TierUpThreshold(
+            PO::Description(
+                "Count of the calls and the loop iterations of a function before compiling it in the tiered execution. Can be specified as --tier-up-threshold `COUNT`."sv),
+            PO::MetaVar("COUNT"sv)),
+        AOTCacheSizeLimit(
+            PO::Description(
+                "Limitation of the AOT cache size in bytes. The least recently used cached modules are evicted over the limit, default value is 0 for no limitations"sv),
+            PO::MetaVar("BYTES"sv), PO::DefaultValue<uint64_t>(0)),
+        MemoryPoolSize(
+            PO::Description(
+                "Count of the linear memory reservations kept for reuse after releasing the memory instances, default value is 0 for no pooling."sv),
+            PO::MetaVar("COUNT"sv), PO::DefaultValue<uint32_t>(0)),
+        LoadingJobs(
+            PO::Description(
+                "Count of the threads to decode the function bodies, 0 for the hardware concurrency. Default value is 1."sv),
+            PO::MetaVar("N"sv), PO::DefaultValue<uint32_t>(1)),
+        ValidationJobs(
+            PO::Description(
+                "Count of the threads to validate the function bodies, 0 for the hardware concurrency. Default value is 1."sv),
+            PO::MetaVar("N"sv), PO::DefaultValue<uint32_t>(1)),
+        SnapshotName(
+            PO::Description(
+                "Instantiate the module from the snapshot saved by the `snapshot` subcommand. Reactor mode does not call `_initialize` again."sv),
+            PO::MetaVar("SNAPSHOT"sv), PO::DefaultValue<std::string>("")),
         ForbiddenPlugins(PO::Description("List of plugins to ignore."sv),
                          PO::MetaVar("NAMES"sv)) {}
 
@@ -119,13 +163,28 @@ struct DriverToolOptions {
   PO::Option<PO::Toggle> PropAll;
   PO::Option<PO::Toggle> ConfEnableInstructionCounting;
   PO::Option<PO::Toggle> ConfEnableGasMeasuring;
+  PO::Option<PO::Toggle> ConfEnableBlockGasMeasuring;
   PO::Option<PO::Toggle> ConfEnableTimeMeasuring;
   PO::Option<PO::Toggle> ConfEnableAllStatistics;
   PO::Option<PO::Toggle> ConfEnableJIT;
+  PO::Option<PO::Toggle> ConfEnableTieredJIT;
+  PO::Option<PO::Toggle> ConfEnableAOTCache;
+  PO::Option<PO::Toggle> ConfEnableImageCache;
   PO::Option<PO::Toggle> ConfForceInterpreter;
+  PO::Option<PO::Toggle> ConfThreadedInterpreter;
+  PO::Option<PO::Toggle> ConfRegisterInterpreter;
+  PO::Option<PO::Toggle> ConfLazyLoading;
+  PO::Option<PO::Toggle> ConfGuardPageBoundsCheck;
   PO::Option<uint64_t> TimeLim;
   PO::List<int> GasLim;
   PO::List<int> MemLim;
+  PO::List<int> CallDepthLim;
+  PO::List<int> TierUpThreshold;
+  PO::Option<uint64_t> AOTCacheSizeLimit;
+  PO::Option<uint32_t> MemoryPoolSize;
+  PO::Option<uint32_t> LoadingJobs;
+  PO::Option<uint32_t> ValidationJobs;
+  PO::Option<std::string> SnapshotName;
   PO::List<std::string> ForbiddenPlugins;
 
   void add_option(PO::ArgumentParser &Parser) noexcept {
@@ -137,10 +196,19 @@ struct DriverToolOptions {
         .add_option("env"sv, Env)
         .add_option("enable-instruction-count"sv, ConfEnableInstructionCounting)
         .add_option("enable-gas-measuring"sv, ConfEnableGasMeasuring)
+        .add_option("enable-block-gas-measuring"sv,
+                    ConfEnableBlockGasMeasuring)
         .add_option("enable-time-measuring"sv, ConfEnableTimeMeasuring)
         .add_option("enable-all-statistics"sv, ConfEnableAllStatistics)
         .add_option("enable-jit"sv, ConfEnableJIT)
+        .add_option("enable-tiered-jit"sv, ConfEnableTieredJIT)
+        .add_option("enable-aot-cache"sv, ConfEnableAOTCache)
+        .add_option("enable-image-cache"sv, ConfEnableImageCache)
         .add_option("force-interpreter"sv, ConfForceInterpreter)
+        .add_option("threaded-interpreter"sv, ConfThreadedInterpreter)
+        .add_option("register-interpreter"sv, ConfRegisterInterpreter)
+        .add_option("lazy-loading"sv, ConfLazyLoading)
+        .add_option("guard-page-bounds-check"sv, ConfGuardPageBoundsCheck)
         .add_option("disable-import-export-mut-globals"sv, PropMutGlobals)
         .add_option("disable-non-trap-float-to-int"sv, PropNonTrapF2IConvs)
         .add_option("disable-sign-extension-operators"sv, PropSignExtendOps)
@@ -161,6 +229,13 @@ struct DriverToolOptions {
         .add_option("time-limit"sv, TimeLim)
         .add_option("gas-limit"sv, GasLim)
         .add_option("memory-page-limit"sv, MemLim)
+        .add_option("call-depth-limit"sv, CallDepthLim)
+        .add_option("tier-up-threshold"sv, TierUpThreshold)
+        .add_option("aot-cache-size-limit"sv, AOTCacheSizeLimit)
+        .add_option("memory-pool-size"sv, MemoryPoolSize)
+        .add_option("loading-jobs"sv, LoadingJobs)
+        .add_option("validation-jobs"sv, ValidationJobs)
+        .add_option("snapshot"sv, SnapshotName)
         .add_option("forbidden-plugin"sv, ForbiddenPlugins);
 
     for (const auto &Path : Plugin::Plugin::getDefaultPluginPaths()) {
@@ -44,7 +44,7 @@ TypeT<T> Executor::runDivOp(const AST::Instruction &Instr, ValVariant &Val1,
       spdlog::error(ErrInfo::InfoInstruction(
           Instr.getOpCode(), Instr.getOffset(), {Val1, Val2},
           {ValTypeFromType<T>(), ValTypeFromType<T>()}, std::is_signed_v<T>));
-      return Unexpect(ErrCode::Value::DivideByZero);
+      return raiseTrap(ErrCode::Value::DivideByZero);
     }
     if (std::is_signed_v<T> && V1 == std::numeric_limits<T>::min() &&
         V2 == static_cast<T>(-1)) {
@@ -54,7 +54,7 @@ TypeT<T> Executor::runDivOp(const AST::Instruction &Instr, ValVariant &Val1,
       spdlog::error(ErrInfo::InfoInstruction(
           Instr.getOpCode(), Instr.getOffset(), {Val1, Val2},
           {ValTypeFromType<T>(), ValTypeFromType<T>()}, true));
-      return Unexpect(ErrCode::Value::IntegerOverflow);
+      return raiseTrap(ErrCode::Value::IntegerOverflow);
     }
   } else {
     static_assert(std::numeric_limits<T>::is_iec559, "Unsupported platform!");
@@ -77,7 +77,7 @@ TypeI<T> Executor::runRemOp(const AST::Instruction &Instr, ValVariant &Val1,
     spdlog::error(ErrInfo::InfoInstruction(
         Instr.getOpCode(), Instr.getOffset(), {Val1, Val2},
         {ValTypeFromType<T>(), ValTypeFromType<T>()}, std::is_signed_v<T>));
-    return Unexpect(ErrCode::Value::DivideByZero);
+    return raiseTrap(ErrCode::Value::DivideByZero);
   }
   // Else, return the i1 % i2. Signed case is handled.
   if (std::is_signed_v<T> && I2 == static_cast<T>(-1)) {
@@ -45,13 +45,13 @@ TypeFI<TIn, TOut> Executor::runTruncateOp(const AST::Instruction &Instr,
     spdlog::error(ErrCode::Value::InvalidConvToInt);
     spdlog::error(ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset(),
                                            {Val}, {ValTypeFromType<TIn>()}));
-    return Unexpect(ErrCode::Value::InvalidConvToInt);
+    return raiseTrap(ErrCode::Value::InvalidConvToInt);
   }
   if (std::isinf(Z)) {
     spdlog::error(ErrCode::Value::IntegerOverflow);
     spdlog::error(ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset(),
                                            {Val}, {ValTypeFromType<TIn>()}));
-    return Unexpect(ErrCode::Value::IntegerOverflow);
+    return raiseTrap(ErrCode::Value::IntegerOverflow);
   }
   // If trunc(z) is out of range of target type, then the result is undefined.
   Z = std::trunc(Z);
@@ -64,7 +64,7 @@ TypeFI<TIn, TOut> Executor::runTruncateOp(const AST::Instruction &Instr,
       spdlog::error(ErrInfo::InfoInstruction(Instr.getOpCode(),
                                              Instr.getOffset(), {Val},
                                              {ValTypeFromType<TIn>()}));
-      return Unexpect(ErrCode::Value::IntegerOverflow);
+      return raiseTrap(ErrCode::Value::IntegerOverflow);
     }
   } else {
     // Floating precision is worse than integer case.
@@ -73,7 +73,7 @@ TypeFI<TIn, TOut> Executor::runTruncateOp(const AST::Instruction &Instr,
       spdlog::error(ErrInfo::InfoInstruction(Instr.getOpCode(),
                                              Instr.getOffset(), {Val},
                                              {ValTypeFromType<TIn>()}));
-      return Unexpect(ErrCode::Value::IntegerOverflow);
+      return raiseTrap(ErrCode::Value::IntegerOverflow);
     }
   }
   // Else, return trunc(z). Signed case handled.
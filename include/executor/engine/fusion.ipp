@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "executor/executor.h"
+
+namespace WasmEdge {
+namespace Executor {
+
+template <OpCode Fused, bool IsGuarded>
+Expect<void> Executor::runFusedOp(Runtime::StackManager &StackMgr,
+                                  AST::InstrView::iterator &PC) noexcept {
+  // Only the first instruction is rewritten into the fused opcode. The
+  // operands of the others are read from themselves.
+  if constexpr (Fused == OpCode::Fused__local_get_local_get_i32_add) {
+    // local.get; local.get; i32.add
+    ValVariant Val = StackMgr.getTopN(PC->getStackOffset());
+    // The second local.get is at the stack height + 1.
+    Val.get<uint32_t>() +=
+        StackMgr.getTopN((PC + 1)->getStackOffset() - 1).get<uint32_t>();
+    StackMgr.push(Val);
+    PC += 2;
+    return {};
+  } else if constexpr (Fused == OpCode::Fused__i32_const_i32_add) {
+    // i32.const; i32.add
+    StackMgr.getTop().get<uint32_t>() += PC->getNum().get<uint32_t>();
+    PC += 1;
+    return {};
+  } else if constexpr (Fused == OpCode::Fused__local_get_i32_load) {
+    // local.get; i32.load
+    StackMgr.push(StackMgr.getTopN(PC->getStackOffset()));
+    PC += 1;
+    // The error information refers to the load instruction.
+    return runLoadOp<uint32_t, 32, IsGuarded>(
+        StackMgr, *getMemInstByIdx(StackMgr, PC->getTargetIndex()), *PC);
+  } else if constexpr (Fused == OpCode::Fused__i32_eqz_br_if) {
+    // i32.eqz; br_if
+    const bool IsZero = StackMgr.pop().get<uint32_t>() == 0;
+    PC += 1;
+    if (IsZero) {
+      return runBrOp(StackMgr, *PC, PC);
+    }
+    return {};
+  } else {
+    assumingUnreachable();
+  }
+}
+
+} // namespace Executor
+} // namespace WasmEdge
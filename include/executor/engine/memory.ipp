@@ -9,12 +9,22 @@
 namespace WasmEdge {
 namespace Executor {
 
-template <typename T, uint32_t BitWidth>
+template <typename T, uint32_t BitWidth, bool IsGuarded>
 TypeT<T> Executor::runLoadOp(Runtime::StackManager &StackMgr,
                              Runtime::Instance::MemoryInstance &MemInst,
                              const AST::Instruction &Instr) {
   // Calculate EA
   ValVariant &Val = StackMgr.getTop();
+  if constexpr (IsGuarded) {
+    // The 33-bit EA never exceeds the guard region unless the offset is huge.
+    if (likely(Instr.getMemoryOffset() <=
+               std::numeric_limits<uint32_t>::max() - BitWidth / 8)) {
+      const uint64_t EA =
+          static_cast<uint64_t>(Val.get<uint32_t>()) + Instr.getMemoryOffset();
+      MemInst.loadGuardedValue<T, BitWidth / 8>(Val.emplace<T>(), EA);
+      return {};
+    }
+  }
   if (Val.get<uint32_t>() >
       std::numeric_limits<uint32_t>::max() - Instr.getMemoryOffset()) {
     spdlog::error(ErrCode::Value::MemoryOutOfBounds);
@@ -23,7 +33,7 @@ TypeT<T> Executor::runLoadOp(Runtime::StackManager &StackMgr,
         BitWidth / 8, MemInst.getBoundIdx()));
     spdlog::error(
         ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
-    return Unexpect(ErrCode::Value::MemoryOutOfBounds);
+    return raiseTrap(ErrCode::Value::MemoryOutOfBounds);
   }
   uint32_t EA = Val.get<uint32_t>() + Instr.getMemoryOffset();
 
@@ -32,12 +42,12 @@ TypeT<T> Executor::runLoadOp(Runtime::StackManager &StackMgr,
       !Res) {
     spdlog::error(
         ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
-    return Unexpect(Res);
+    return raiseTrap(Res.error());
   }
   return {};
 }
 
-template <typename T, uint32_t BitWidth>
+template <typename T, uint32_t BitWidth, bool IsGuarded>
 TypeN<T> Executor::runStoreOp(Runtime::StackManager &StackMgr,
                               Runtime::Instance::MemoryInstance &MemInst,
                               const AST::Instruction &Instr) {
@@ -46,6 +56,15 @@ TypeN<T> Executor::runStoreOp(Runtime::StackManager &StackMgr,
 
   // Calculate EA = i + offset
   uint32_t I = StackMgr.pop().get<uint32_t>();
+  if constexpr (IsGuarded) {
+    // The 33-bit EA never exceeds the guard region unless the offset is huge.
+    if (likely(Instr.getMemoryOffset() <=
+               std::numeric_limits<uint32_t>::max() - BitWidth / 8)) {
+      MemInst.storeGuardedValue<T, BitWidth / 8>(
+          C, static_cast<uint64_t>(I) + Instr.getMemoryOffset());
+      return {};
+    }
+  }
   if (I > std::numeric_limits<uint32_t>::max() - Instr.getMemoryOffset()) {
     spdlog::error(ErrCode::Value::MemoryOutOfBounds);
     spdlog::error(ErrInfo::InfoBoundary(
@@ -53,7 +72,7 @@ TypeN<T> Executor::runStoreOp(Runtime::StackManager &StackMgr,
         MemInst.getBoundIdx()));
     spdlog::error(
         ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
-    return Unexpect(ErrCode::Value::MemoryOutOfBounds);
+    return raiseTrap(ErrCode::Value::MemoryOutOfBounds);
   }
   uint32_t EA = I + Instr.getMemoryOffset();
 
@@ -61,7 +80,7 @@ TypeN<T> Executor::runStoreOp(Runtime::StackManager &StackMgr,
   if (auto Res = MemInst.storeValue<T, BitWidth / 8>(C, EA); !Res) {
     spdlog::error(
         ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
-    return Unexpect(Res);
+    return raiseTrap(Res.error());
   }
   return {};
 }
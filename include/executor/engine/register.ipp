@@ -0,0 +1,285 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "executor/executor.h"
+
+namespace WasmEdge {
+namespace Executor {
+
+constexpr bool Executor::isRegOperation(OpCode Code) noexcept {
+  // The operations which never trap can be lowered into the register-based
+  // instructions.
+  switch (Code) {
+  case OpCode::I32__eq:
+  case OpCode::I32__ne:
+  case OpCode::I32__lt_s:
+  case OpCode::I32__lt_u:
+  case OpCode::I32__gt_s:
+  case OpCode::I32__gt_u:
+  case OpCode::I32__le_s:
+  case OpCode::I32__le_u:
+  case OpCode::I32__ge_s:
+  case OpCode::I32__ge_u:
+  case OpCode::I64__eq:
+  case OpCode::I64__ne:
+  case OpCode::I64__lt_s:
+  case OpCode::I64__lt_u:
+  case OpCode::I64__gt_s:
+  case OpCode::I64__gt_u:
+  case OpCode::I64__le_s:
+  case OpCode::I64__le_u:
+  case OpCode::I64__ge_s:
+  case OpCode::I64__ge_u:
+  case OpCode::F32__eq:
+  case OpCode::F32__ne:
+  case OpCode::F32__lt:
+  case OpCode::F32__gt:
+  case OpCode::F32__le:
+  case OpCode::F32__ge:
+  case OpCode::F64__eq:
+  case OpCode::F64__ne:
+  case OpCode::F64__lt:
+  case OpCode::F64__gt:
+  case OpCode::F64__le:
+  case OpCode::F64__ge:
+  case OpCode::I32__add:
+  case OpCode::I32__sub:
+  case OpCode::I32__mul:
+  case OpCode::I32__and:
+  case OpCode::I32__or:
+  case OpCode::I32__xor:
+  case OpCode::I32__shl:
+  case OpCode::I32__shr_s:
+  case OpCode::I32__shr_u:
+  case OpCode::I32__rotl:
+  case OpCode::I32__rotr:
+  case OpCode::I64__add:
+  case OpCode::I64__sub:
+  case OpCode::I64__mul:
+  case OpCode::I64__and:
+  case OpCode::I64__or:
+  case OpCode::I64__xor:
+  case OpCode::I64__shl:
+  case OpCode::I64__shr_s:
+  case OpCode::I64__shr_u:
+  case OpCode::I64__rotl:
+  case OpCode::I64__rotr:
+  case OpCode::F32__add:
+  case OpCode::F32__sub:
+  case OpCode::F32__mul:
+  case OpCode::F32__div:
+  case OpCode::F64__add:
+  case OpCode::F64__sub:
+  case OpCode::F64__mul:
+  case OpCode::F64__div:
+    return true;
+  default:
+    return false;
+  }
+}
+
+inline Expect<void>
+Executor::runRegOperation(OpCode Code, const AST::Instruction &Instr,
+                          ValVariant &Val1,
+                          const ValVariant &Val2) const noexcept {
+  switch (Code) {
+  case OpCode::I32__eq:
+    return runEqOp<uint32_t>(Val1, Val2);
+  case OpCode::I32__ne:
+    return runNeOp<uint32_t>(Val1, Val2);
+  case OpCode::I32__lt_s:
+    return runLtOp<int32_t>(Val1, Val2);
+  case OpCode::I32__lt_u:
+    return runLtOp<uint32_t>(Val1, Val2);
+  case OpCode::I32__gt_s:
+    return runGtOp<int32_t>(Val1, Val2);
+  case OpCode::I32__gt_u:
+    return runGtOp<uint32_t>(Val1, Val2);
+  case OpCode::I32__le_s:
+    return runLeOp<int32_t>(Val1, Val2);
+  case OpCode::I32__le_u:
+    return runLeOp<uint32_t>(Val1, Val2);
+  case OpCode::I32__ge_s:
+    return runGeOp<int32_t>(Val1, Val2);
+  case OpCode::I32__ge_u:
+    return runGeOp<uint32_t>(Val1, Val2);
+  case OpCode::I64__eq:
+    return runEqOp<uint64_t>(Val1, Val2);
+  case OpCode::I64__ne:
+    return runNeOp<uint64_t>(Val1, Val2);
+  case OpCode::I64__lt_s:
+    return runLtOp<int64_t>(Val1, Val2);
+  case OpCode::I64__lt_u:
+    return runLtOp<uint64_t>(Val1, Val2);
+  case OpCode::I64__gt_s:
+    return runGtOp<int64_t>(Val1, Val2);
+  case OpCode::I64__gt_u:
+    return runGtOp<uint64_t>(Val1, Val2);
+  case OpCode::I64__le_s:
+    return runLeOp<int64_t>(Val1, Val2);
+  case OpCode::I64__le_u:
+    return runLeOp<uint64_t>(Val1, Val2);
+  case OpCode::I64__ge_s:
+    return runGeOp<int64_t>(Val1, Val2);
+  case OpCode::I64__ge_u:
+    return runGeOp<uint64_t>(Val1, Val2);
+  case OpCode::F32__eq:
+    return runEqOp<float>(Val1, Val2);
+  case OpCode::F32__ne:
+    return runNeOp<float>(Val1, Val2);
+  case OpCode::F32__lt:
+    return runLtOp<float>(Val1, Val2);
+  case OpCode::F32__gt:
+    return runGtOp<float>(Val1, Val2);
+  case OpCode::F32__le:
+    return runLeOp<float>(Val1, Val2);
+  case OpCode::F32__ge:
+    return runGeOp<float>(Val1, Val2);
+  case OpCode::F64__eq:
+    return runEqOp<double>(Val1, Val2);
+  case OpCode::F64__ne:
+    return runNeOp<double>(Val1, Val2);
+  case OpCode::F64__lt:
+    return runLtOp<double>(Val1, Val2);
+  case OpCode::F64__gt:
+    return runGtOp<double>(Val1, Val2);
+  case OpCode::F64__le:
+    return runLeOp<double>(Val1, Val2);
+  case OpCode::F64__ge:
+    return runGeOp<double>(Val1, Val2);
+  case OpCode::I32__add:
+    return runAddOp<uint32_t>(Val1, Val2);
+  case OpCode::I32__sub:
+    return runSubOp<uint32_t>(Val1, Val2);
+  case OpCode::I32__mul:
+    return runMulOp<uint32_t>(Val1, Val2);
+  case OpCode::I32__and:
+    return runAndOp<uint32_t>(Val1, Val2);
+  case OpCode::I32__or:
+    return runOrOp<uint32_t>(Val1, Val2);
+  case OpCode::I32__xor:
+    return runXorOp<uint32_t>(Val1, Val2);
+  case OpCode::I32__shl:
+    return runShlOp<uint32_t>(Val1, Val2);
+  case OpCode::I32__shr_s:
+    return runShrOp<int32_t>(Val1, Val2);
+  case OpCode::I32__shr_u:
+    return runShrOp<uint32_t>(Val1, Val2);
+  case OpCode::I32__rotl:
+    return runRotlOp<uint32_t>(Val1, Val2);
+  case OpCode::I32__rotr:
+    return runRotrOp<uint32_t>(Val1, Val2);
+  case OpCode::I64__add:
+    return runAddOp<uint64_t>(Val1, Val2);
+  case OpCode::I64__sub:
+    return runSubOp<uint64_t>(Val1, Val2);
+  case OpCode::I64__mul:
+    return runMulOp<uint64_t>(Val1, Val2);
+  case OpCode::I64__and:
+    return runAndOp<uint64_t>(Val1, Val2);
+  case OpCode::I64__or:
+    return runOrOp<uint64_t>(Val1, Val2);
+  case OpCode::I64__xor:
+    return runXorOp<uint64_t>(Val1, Val2);
+  case OpCode::I64__shl:
+    return runShlOp<uint64_t>(Val1, Val2);
+  case OpCode::I64__shr_s:
+    return runShrOp<int64_t>(Val1, Val2);
+  case OpCode::I64__shr_u:
+    return runShrOp<uint64_t>(Val1, Val2);
+  case OpCode::I64__rotl:
+    return runRotlOp<uint64_t>(Val1, Val2);
+  case OpCode::I64__rotr:
+    return runRotrOp<uint64_t>(Val1, Val2);
+  case OpCode::F32__add:
+    return runAddOp<float>(Val1, Val2);
+  case OpCode::F32__sub:
+    return runSubOp<float>(Val1, Val2);
+  case OpCode::F32__mul:
+    return runMulOp<float>(Val1, Val2);
+  case OpCode::F32__div:
+    return runDivOp<float>(Instr, Val1, Val2);
+  case OpCode::F64__add:
+    return runAddOp<double>(Val1, Val2);
+  case OpCode::F64__sub:
+    return runSubOp<double>(Val1, Val2);
+  case OpCode::F64__mul:
+    return runMulOp<double>(Val1, Val2);
+  case OpCode::F64__div:
+    return runDivOp<double>(Instr, Val1, Val2);
+  default:
+    assumingUnreachable();
+  }
+}
+
+inline Expect<void>
+Executor::runRegLocalCopyOp(Runtime::StackManager &StackMgr,
+                            AST::InstrView::iterator &PC) const noexcept {
+  // local.get; local.set
+  StackMgr.getTopN(PC->getRegDst()) = StackMgr.getTopN(PC->getRegSrc1());
+  PC += 1;
+  return {};
+}
+
+template <OpCode Form>
+Expect<void>
+Executor::runRegBinaryOp(Runtime::StackManager &StackMgr,
+                         AST::InstrView::iterator &PC) const noexcept {
+  const AST::Instruction &Instr = *PC;
+  if constexpr (Form == OpCode::Reg__binop_ll ||
+                Form == OpCode::Reg__binop_ll_set ||
+                Form == OpCode::Reg__binop_lc ||
+                Form == OpCode::Reg__binop_lc_set) {
+    // local.get; (local.get | const); binop; [local.set]
+    ValVariant Val = StackMgr.getTopN(Instr.getRegSrc1());
+    if constexpr (Form == OpCode::Reg__binop_ll ||
+                  Form == OpCode::Reg__binop_ll_set) {
+      if (auto Res = runRegOperation(Instr.getRegOpCode(), Instr, Val,
+                                     StackMgr.getTopN(Instr.getRegSrc2()));
+          unlikely(!Res)) {
+        return Unexpect(Res);
+      }
+    } else {
+      // The constant is kept in the next instruction.
+      if (auto Res = runRegOperation(Instr.getRegOpCode(), Instr, Val,
+                                     (PC + 1)->getNum());
+          unlikely(!Res)) {
+        return Unexpect(Res);
+      }
+    }
+    if constexpr (Form == OpCode::Reg__binop_ll ||
+                  Form == OpCode::Reg__binop_lc) {
+      StackMgr.push(Val);
+      PC += 2;
+    } else {
+      StackMgr.getTopN(Instr.getRegDst()) = Val;
+      PC += 3;
+    }
+  } else if constexpr (Form == OpCode::Reg__binop_sl) {
+    // local.get; binop
+    if (auto Res =
+            runRegOperation(Instr.getRegOpCode(), Instr, StackMgr.getTop(),
+                            StackMgr.getTopN(Instr.getRegSrc2()));
+        unlikely(!Res)) {
+      return Unexpect(Res);
+    }
+    PC += 1;
+  } else if constexpr (Form == OpCode::Reg__binop_set) {
+    // binop; local.set
+    ValVariant Val2 = StackMgr.pop();
+    ValVariant Val1 = StackMgr.pop();
+    if (auto Res = runRegOperation(Instr.getRegOpCode(), Instr, Val1, Val2);
+        unlikely(!Res)) {
+      return Unexpect(Res);
+    }
+    // The destination offset is at the entry with the 2 operands.
+    StackMgr.getTopN(Instr.getRegDst() - 2) = Val1;
+    PC += 1;
+  } else {
+    assumingUnreachable();
+  }
+  return {};
+}
+
+} // namespace Executor
+} // namespace WasmEdge
@@ -19,6 +19,7 @@
 #include "common/configure.h"
 #include "common/defines.h"
 #include "common/errcode.h"
+#include "common/filesystem.h"
 #include "common/statistics.h"
 #include "runtime/callingframe.h"
 #include "runtime/instance/module.h"
@@ -42,6 +43,8 @@
 namespace WasmEdge {
 namespace Executor {
 
+class Snapshot;
+
 namespace {
 
 // Template return type aliasing
@@ -161,6 +164,27 @@ public:
   Expect<void> registerModule(Runtime::StoreManager &StoreMgr,
                               const Runtime::Instance::ModuleInstance &ModInst);
 
+  /// Instantiate a WASM Module into an anonymous module instance from the
+  /// snapshot of its initialized instance. The segments are not copied and
+  /// the start function is not executed again.
+  Expect<std::unique_ptr<Runtime::Instance::ModuleInstance>>
+  instantiateSnapshot(Runtime::StoreManager &StoreMgr, const AST::Module &Mod,
+                      const Snapshot &Snap);
+
+  /// Save the snapshot of the defined instances in the module instance.
+  Expect<void> saveSnapshot(const Runtime::Instance::ModuleInstance &ModInst,
+                            const std::filesystem::path &Path);
+
+  /// Capture the snapshot of the defined instances in the module instance in
+  /// memory. The snapshot also keeps the live segments to reset instances.
+  Expect<std::unique_ptr<Snapshot>>
+  captureSnapshot(const Runtime::Instance::ModuleInstance &ModInst);
+
+  /// Reset the module instance to the state in the snapshot captured from an
+  /// instance of the same module. The imported instances are not reset.
+  Expect<void> resetInstance(Runtime::Instance::ModuleInstance &ModInst,
+                             const Snapshot &Snap);
+
   /// Register a host function which will be invoked before calling a
   /// host function.
   Expect<void> registerPreHostFunction(void *HostData,
@@ -171,6 +195,18 @@ public:
   Expect<void> registerPostHostFunction(void *HostData,
                                         std::function<void(void *)> HostFunc);
 
+  /// Register a function which will be invoked when a wasm function becomes
+  /// hot in the tiered execution.
+  Expect<void> registerTierUpFunction(
+      std::function<void(const Runtime::Instance::FunctionInstance &)> Func);
+
+  /// Switch the wasm functions of a module instance to the compiled codes of
+  /// the executable in the tiered execution.
+  Expect<void>
+  loadTieredExecutable(const AST::Module &Mod,
+                       const Runtime::Instance::ModuleInstance &ModInst,
+                       std::shared_ptr<Executable> Exec) noexcept;
+
   /// Invoke a WASM function by function instance.
   Expect<std::vector<std::pair<ValVariant, ValType>>>
   invoke(const Runtime::Instance::FunctionInstance *FuncInst,
@@ -202,12 +238,23 @@ private:
                        const AST::InstrView::iterator Start,
                        const AST::InstrView::iterator End);
 
+  /// Execute instructions with the specialized statistics variant. The
+  /// variants without statistics take the traps out of band and should run
+  /// under a fault handler. The guarded variant checks the memory boundary of
+  /// loads and stores by the guard pages.
+  template <bool IsCounting, bool IsMeasuring, bool IsBlockMeasuring,
+            bool IsGuarded>
+  Expect<void> execute(Runtime::StackManager &StackMgr,
+                       const AST::InstrView::iterator Start,
+                       const AST::InstrView::iterator End);
+
   /// \name Functions for instantiation.
   /// @{
   /// Instantiation of Module Instance.
   Expect<std::unique_ptr<Runtime::Instance::ModuleInstance>>
   instantiate(Runtime::StoreManager &StoreMgr, const AST::Module &Mod,
-              std::optional<std::string_view> Name = std::nullopt);
+              std::optional<std::string_view> Name = std::nullopt,
+              const Snapshot *Snap = nullptr);
 
   /// Instantiation of Imports.
   Expect<void> instantiate(Runtime::StoreManager &StoreMgr,
@@ -251,13 +298,33 @@ private:
                            Runtime::Instance::ModuleInstance &ModInst,
                            const AST::DataSection &DataSec);
 
-  /// Initialize memory with Data Instances.
+  /// Initialize memory with Data Instances. The memories with the initial
+  /// images of the module are mapped from the images instead.
   Expect<void> initMemory(Runtime::StackManager &StackMgr,
-                          const AST::DataSection &DataSec);
+                          const AST::Module &Mod);
 
   /// Instantiation of Exports.
   Expect<void> instantiate(Runtime::Instance::ModuleInstance &ModInst,
                            const AST::ExportSection &ExportSec);
+
+  /// Record the states of the defined instances into the snapshot. The
+  /// memory contents and the live segments are also kept in memory.
+  Expect<void> recordSnapshot(const Runtime::Instance::ModuleInstance &ModInst,
+                              Snapshot &Snap, bool InMemory);
+
+  /// Restore the memories, tables, globals, and segments from the snapshot
+  /// instead of initializing them.
+  Expect<void> restoreSnapshot(Runtime::Instance::ModuleInstance &ModInst,
+                               const Snapshot &Snap);
+
+  /// Lower the validated function body into the register-based bytecode with
+  /// the superinstructions.
+  void lowerInstrs(AST::InstrVec &Instrs) const noexcept;
+
+  /// Prepare the costs of the basic blocks in the validated function body for
+  /// metering per basic block. The costs are output as the side table.
+  void prepareBlockCost(AST::InstrVec &Instrs,
+                        std::vector<uint32_t> &Costs) const noexcept;
   /// @}
 
   /// \name Helper Functions for block controls.
@@ -268,6 +335,16 @@ private:
                 const Runtime::Instance::FunctionInstance &Func,
                 const AST::InstrView::iterator RetIt, bool IsTailCall = false);
 
+  /// Helper function for counting the calls and the loop iterations in the
+  /// tiered execution. Returns the compiled code if it is ready.
+  const Runtime::Instance::FunctionInstance::TieredCode *
+  tierUp(const Runtime::Instance::FunctionInstance &Func) noexcept;
+
+  /// Helper function for loading the function body on the first call in the
+  /// lazy loading mode.
+  Expect<void>
+  loadLazyFunction(const Runtime::Instance::FunctionInstance &Func) const;
+
   /// Helper function for branching to label.
   Expect<void> branchToLabel(Runtime::StackManager &StackMgr,
                              const AST::Instruction::JumpDescriptor &JumpDesc,
@@ -277,6 +354,11 @@ private:
   Expect<void> throwException(Runtime::StackManager &StackMgr,
                               Runtime::Instance::TagInstance &TagInst,
                               AST::InstrView::iterator &PC) noexcept;
+
+  /// Helper function for reporting a trap of the instruction handlers. The
+  /// error code and information should be logged before. If the execution loop
+  /// takes the traps out of band, jump to its fault handler directly.
+  static Unexpected<ErrCode> raiseTrap(ErrCode Code) noexcept;
   /// @}
 
   /// \name Helper Functions for getting instances or types.
@@ -380,6 +462,20 @@ private:
                               uint32_t Idx) const noexcept;
   Expect<void> runGlobalSetOp(Runtime::StackManager &StackMgr,
                               uint32_t Idx) const noexcept;
+  /// ======= Register-based instructions =======
+  static constexpr bool isRegOperation(OpCode Code) noexcept;
+  Expect<void> runRegOperation(OpCode Code, const AST::Instruction &Instr,
+                               ValVariant &Val1,
+                               const ValVariant &Val2) const noexcept;
+  Expect<void> runRegLocalCopyOp(Runtime::StackManager &StackMgr,
+                                 AST::InstrView::iterator &PC) const noexcept;
+  template <OpCode Form>
+  Expect<void> runRegBinaryOp(Runtime::StackManager &StackMgr,
+                              AST::InstrView::iterator &PC) const noexcept;
+  /// ======= Superinstructions =======
+  template <OpCode Fused, bool IsGuarded = false>
+  Expect<void> runFusedOp(Runtime::StackManager &StackMgr,
+                          AST::InstrView::iterator &PC) noexcept;
   /// ======= Reference instructions =======
   Expect<void> runRefNullOp(Runtime::StackManager &StackMgr,
                             const ValType &Type) const noexcept;
@@ -474,11 +570,13 @@ private:
                               Runtime::Instance::TableInstance &TabInst,
                               const AST::Instruction &Instr);
   /// ======= Memory instructions =======
-  template <typename T, uint32_t BitWidth = sizeof(T) * 8>
+  template <typename T, uint32_t BitWidth = sizeof(T) * 8,
+            bool IsGuarded = false>
   TypeT<T> runLoadOp(Runtime::StackManager &StackMgr,
                      Runtime::Instance::MemoryInstance &MemInst,
                      const AST::Instruction &Instr);
-  template <typename T, uint32_t BitWidth = sizeof(T) * 8>
+  template <typename T, uint32_t BitWidth = sizeof(T) * 8,
+            bool IsGuarded = false>
   TypeN<T> runStoreOp(Runtime::StackManager &StackMgr,
                       Runtime::Instance::MemoryInstance &MemInst,
                       const AST::Instruction &Instr);
@@ -850,6 +948,10 @@ private:
   static thread_local Runtime::StackManager *CurrentStack;
   /// Execution context for compiled functions
   static thread_local ExecutionContextStruct ExecutionContext;
+  /// The current execution loop takes the traps out of band
+  static thread_local bool IsTrapByFault;
+  /// The raised trap is logged by the instruction handler
+  static thread_local bool IsTrapLogged;
   /// @}
 
 private:
@@ -861,6 +963,10 @@ private:
   std::atomic_uint32_t StopToken = 0;
   /// Executor Host Function Handler
   HostFuncHandler HostFuncHelper = {};
+  /// Tiered execution: the threshold of the hotness, which is 0 if disabled,
+  /// and the function invoked for the hot functions.
+  uint32_t TierUpThreshold = 0;
+  std::function<void(const Runtime::Instance::FunctionInstance &)> TierUpFunc;
 };
 
 } // namespace Executor
@@ -869,6 +975,8 @@ private:
 #include "engine/atomic.ipp"
 #include "engine/binary_numeric.ipp"
 #include "engine/cast_numeric.ipp"
+#include "engine/fusion.ipp"
 #include "engine/memory.ipp"
+#include "engine/register.ipp"
 #include "engine/relation_numeric.ipp"
 #include "engine/unary_numeric.ipp"
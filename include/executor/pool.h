@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/executor/pool.h - Instance pool class definition ---------===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the declaration of the InstancePool class, which keeps
+/// the instantiated module instances of a module for reuse.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include "ast/module.h"
+#include "common/errcode.h"
+#include "executor/executor.h"
+#include "executor/snapshot.h"
+#include "runtime/instance/module.h"
+#include "runtime/storemgr.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace WasmEdge {
+namespace Executor {
+
+/// Pool of the anonymous module instances of a module. The first instance is
+/// instantiated as usual and its state is captured in memory. The other
+/// instances are instantiated from the captured state, and the released
+/// instances are reset to it, so an acquired instance is in the same state as
+/// a newly instantiated one. The imported instances are shared by the
+/// instances in the pool and are not reset.
+class InstancePool {
+public:
+  /// Create the pool with the instances in the size, which is at least 1. The
+  /// executor, the store, and the module should outlive the pool.
+  static Expect<std::unique_ptr<InstancePool>>
+  create(Executor &Exec, Runtime::StoreManager &StoreMgr,
+         const AST::Module &Mod, uint32_t Size);
+
+  /// Take an idle instance. A new instance is added into the pool if there is
+  /// no idle one.
+  Expect<Runtime::Instance::ModuleInstance *> acquire();
+
+  /// Reset the acquired instance and put it back. The instance is removed
+  /// from the pool if the reset failed.
+  Expect<void> release(Runtime::Instance::ModuleInstance *ModInst);
+
+  /// Getter of the count of the instances in the pool.
+  uint32_t getInstanceCount() const noexcept;
+
+  /// Getter of the count of the idle instances in the pool.
+  uint32_t getIdleCount() const noexcept;
+
+private:
+  InstancePool(Executor &E, Runtime::StoreManager &S,
+               const AST::Module &M) noexcept
+      : Exec(E), StoreMgr(S), Mod(M) {}
+
+  Executor &Exec;
+  Runtime::StoreManager &StoreMgr;
+  const AST::Module &Mod;
+  /// State of the instances right after the instantiation.
+  std::unique_ptr<Snapshot> Snap;
+
+  mutable std::mutex Mutex;
+  std::vector<std::unique_ptr<Runtime::Instance::ModuleInstance>> Instances;
+  std::vector<Runtime::Instance::ModuleInstance *> Idle;
+  std::unordered_set<const Runtime::Instance::ModuleInstance *> Acquired;
+};
+
+} // namespace Executor
+} // namespace WasmEdge
@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/executor/snapshot.h - Snapshot class definition ----------===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the declaration of the Snapshot class, which records the
+/// state of an initialized module instance and instantiates the module from it
+/// without running the initialization again.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include "common/errcode.h"
+#include "common/filesystem.h"
+#include "common/types.h"
+#include "system/memimage.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace WasmEdge {
+namespace Executor {
+
+class Executor;
+
+/// Snapshot of the module instance. The snapshot file contains the defined
+/// memories, globals, and tables of the module instance, and the dropped
+/// element and data segments. The memory contents are aligned to the wasm
+/// page size in the file, and are mapped copy-on-write into the memory
+/// instances on instantiation.
+class Snapshot {
+public:
+  /// Load the snapshot file. Only the states out of the memories are read.
+  static Expect<std::unique_ptr<Snapshot>>
+  load(const std::filesystem::path &Path);
+
+private:
+  friend class Executor;
+
+  /// Reference to the function in the function index space of the module
+  /// instance, or the null reference in the type.
+  struct RefRecord {
+    ValType Type;
+    uint32_t FuncIdx;
+    uint32_t Reserved;
+  };
+  static inline constexpr uint32_t kNullFuncIdx = UINT32_MAX;
+
+  struct GlobalRecord {
+    ValType Type;
+    uint64_t Reserved;
+    uint128_t Value;
+    RefRecord Ref;
+  };
+
+  struct MemoryRecord {
+    uint32_t Pages;
+    uint32_t Reserved;
+    uint64_t Offset;
+  };
+
+  std::filesystem::path Path;
+  uint32_t FuncNum = 0;
+  std::vector<MemoryRecord> Memories;
+  std::vector<std::unique_ptr<MemoryImage>> MemoryImages;
+  std::vector<GlobalRecord> Globals;
+  std::vector<std::vector<RefRecord>> Tables;
+  std::vector<uint8_t> ElemDropped;
+  std::vector<uint8_t> DataDropped;
+  /// The memory contents which could not be kept in the images, and the live
+  /// element and data segments. They are only recorded by the snapshots
+  /// captured in memory, which restore the dropped segments on reset.
+  std::vector<std::vector<Byte>> MemoryContents;
+  std::vector<std::vector<RefRecord>> Elems;
+  std::vector<std::shared_ptr<const std::vector<Byte>>> Datas;
+};
+
+} // namespace Executor
+} // namespace WasmEdge
@@ -21,6 +21,7 @@
 #include "llvm/data.h"
 
 #include <mutex>
+#include <string>
 
 namespace WasmEdge::LLVM {
 
@@ -31,6 +32,10 @@ public:
 
   Expect<Data> compile(const AST::Module &Module) noexcept;
 
+  /// Get the description of the target machine which the compiled code is
+  /// specialized for, including the triple, the CPU name and the features.
+  static std::string getTarget(const Configure &Conf) noexcept;
+
   struct CompileContext;
 
 private:
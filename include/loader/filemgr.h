@@ -21,6 +21,8 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
@@ -41,6 +43,8 @@ public:
     MachO_64,
     // AOT compiled WASM as Windows DLL.
     DLL,
+    // Pre-decoded module image.
+    Image,
     // Unknown file header.
     Unknown
   };
@@ -54,12 +58,35 @@ public:
   /// Set the binary data.
   Expect<void> setCode(std::vector<Byte> CodeData);
 
+  /// Streaming source reader. Read the data into the buffer, and return the
+  /// read size. Returning 0 means the end of the stream.
+  using StreamReader = std::function<Expect<size_t>(Span<Byte>)>;
+
+  /// Set the streaming source. The data will be read from the source
+  /// incrementally when reading over the received data.
+  Expect<void> setStream(StreamReader Reader);
+
+  /// Check the data is from the streaming source.
+  bool isStream() const noexcept { return IsStream; }
+
+  /// Set the binary data as a view of the other file manager, and start
+  /// reading at the offset. The data should outlive this file manager.
+  Expect<void> setView(const FileMgr &Parent, uint64_t Offset);
+
   /// Read one byte.
   Expect<Byte> readByte();
 
   /// Read number of bytes into a vector.
   Expect<std::vector<Byte>> readBytes(size_t SizeToRead);
 
+  /// Read number of bytes as a view of the data. The view is valid until the
+  /// data is reset, or kept alive by the holder of the data.
+  Expect<Span<const Byte>> readBytesView(size_t SizeToRead);
+
+  /// Get the holder which keeps the data of the mapped file alive. Returns
+  /// null if the data is not from a mapped file.
+  std::shared_ptr<const void> getDataHolder() const noexcept { return FileMap; }
+
   /// Read an unsigned int.
   Expect<uint32_t> readU32();
 
@@ -98,15 +125,33 @@ public:
   /// Get last succeeded read offset.
   uint64_t getLastOffset() const noexcept { return LastPos; }
 
+  /// Get the binary data before the current offset.
+  Span<const Byte> getReadData() const noexcept { return {Data, Pos}; }
+
   /// Get remain size.
   uint64_t getRemainSize() const noexcept { return Size - Pos; }
 
+  /// Check the remain size is not less than the size. The streaming source
+  /// will be read until enough or the end of the stream.
+  bool hasRemainSize(uint64_t Read) {
+    if (unlikely(getRemainSize() < Read && Stream) && !fill(Pos + Read)) {
+      return false;
+    }
+    return getRemainSize() >= Read;
+  }
+
   /// Jump the content with size (size + content).
   Expect<void> jumpContent();
 
   /// Change the access position of the file.
   void seek(uint64_t NewPos) {
     if (Status != ErrCode::Value::IllegalPath) {
+      if (unlikely(NewPos > Size && Stream) && unlikely(!fill(NewPos))) {
+        // Keep the failed status of reading the streaming source.
+        Pos = Size;
+        LastPos = Pos;
+        return;
+      }
       Pos = std::min(NewPos, Size);
       LastPos = Pos;
       Status = ErrCode::Value::Success;
@@ -122,6 +167,8 @@ public:
     Data = nullptr;
     FileMap.reset();
     DataHolder.reset();
+    Stream = nullptr;
+    IsStream = false;
   }
 
 private:
@@ -131,6 +178,9 @@ private:
   /// Helper function for checking boundary.
   Expect<void> testRead(uint64_t Read);
 
+  /// Helper function for reading the streaming source until the size.
+  Expect<void> fill(uint64_t NewSize);
+
   /// File manager status.
   ErrCode::Value Status = ErrCode::Value::UnexpectedEnd;
 
@@ -148,8 +198,10 @@ private:
 
   /// File or data management.
   const Byte *Data;
-  std::optional<MMap> FileMap;
+  std::shared_ptr<MMap> FileMap;
   std::optional<std::vector<Byte>> DataHolder;
+  StreamReader Stream;
+  bool IsStream = false;
 };
 
 } // namespace WasmEdge
@@ -152,6 +152,9 @@ public:
   Expect<std::variant<std::unique_ptr<AST::Component::Component>,
                       std::unique_ptr<AST::Module>>>
   parseWasmUnit(Span<const uint8_t> Code);
+  Expect<std::variant<std::unique_ptr<AST::Component::Component>,
+                      std::unique_ptr<AST::Module>>>
+  parseWasmUnit(FileMgr::StreamReader Reader);
 
   /// Parse component from file path.
   Expect<std::unique_ptr<AST::Component::Component>>
@@ -168,9 +171,20 @@ public:
   /// Parse module from byte code.
   Expect<std::unique_ptr<AST::Module>> parseModule(Span<const uint8_t> Code);
 
+  /// Parse module from the streaming source. The sections are loaded when the
+  /// data arrived.
+  Expect<std::unique_ptr<AST::Module>>
+  parseModule(FileMgr::StreamReader Reader);
+
   /// Serialize module into byte code.
   Expect<std::vector<Byte>> serializeModule(const AST::Module &Mod);
 
+  /// Serialize the validated module into the pre-decoded module image. The
+  /// parse functions load the image without decoding and validating the
+  /// function bodies again. The image is only valid for the same build and
+  /// proposals.
+  Expect<std::vector<Byte>> serializeImage(const AST::Module &Mod);
+
   /// Reset status.
   void reset() noexcept { FMgr.reset(); }
 
@@ -218,7 +232,7 @@ private:
   Expect<uint32_t> loadVecCnt() {
     // Read the vector size.
     if (auto Res = FMgr.readU32()) {
-      if ((*Res) / 2 > FMgr.getRemainSize()) {
+      if (!FMgr.hasRemainSize((*Res) / 2)) {
         return Unexpect(ErrCode::Value::IntegerTooLong);
       }
       return *Res;
@@ -253,8 +267,9 @@ private:
   Expect<void> loadSectionContent(T &Sec, ElemLoader &&Func) {
     Sec.setStartOffset(FMgr.getOffset());
     if (auto Res = FMgr.readU32()) {
-      // Load the section size first.
-      if (unlikely(FMgr.getRemainSize() < (*Res))) {
+      // Load the section size first. For the streaming source, the section
+      // content is checked when reading.
+      if (unlikely(!FMgr.isStream() && FMgr.getRemainSize() < (*Res))) {
         return logLoadError(ErrCode::Value::LengthOutOfBounds,
                             FMgr.getLastOffset(), NodeAttrFromAST<T>());
       }
@@ -306,6 +321,7 @@ private:
   Expect<void> loadSection(AST::StartSection &Sec);
   Expect<void> loadSection(AST::ElementSection &Sec);
   Expect<void> loadSection(AST::CodeSection &Sec);
+  Expect<void> loadCodeSection(AST::CodeSection &Sec);
   Expect<void> loadSection(AST::DataSection &Sec);
   Expect<void> loadSection(AST::DataCountSection &Sec);
   Expect<void> loadSection(AST::TagSection &Sec);
@@ -425,6 +441,29 @@ private:
   Expect<void> loadInstruction(AST::Instruction &Instr);
   /// @}
 
+  /// \name Helper functions and data for the lazy loading of function bodies
+  /// @{
+  /// The module binary until the end of the code section, which is shared by
+  /// the lazily loaded function bodies to keep the offsets of the instructions.
+  struct LazyCode {
+    LazyCode(const Configure &Conf, bool HasDataSection) noexcept
+        : Conf(Conf), HasDataSection(HasDataSection) {}
+    const Configure Conf;
+    const bool HasDataSection;
+    std::vector<Byte> Code;
+  };
+  class LazyBody;
+  bool isLazyLoading() const noexcept;
+  std::shared_ptr<LazyCode> LazyCodeData;
+  /// @}
+
+  /// \name Helper functions for the pre-decoded module image
+  /// @{
+  Expect<std::unique_ptr<AST::Module>> loadImage();
+  Expect<void> loadImageCode(AST::CodeSection &Sec);
+  Expect<void> loadImageSegment(AST::CodeSegment &CodeSeg);
+  /// @}
+
   /// \name Loader members
   /// @{
   const Configure Conf;
@@ -435,7 +474,7 @@ private:
   bool HasDataSection;
 
   /// Input data type enumeration.
-  enum class InputType : uint8_t { WASM, UniversalWASM, SharedLibrary };
+  enum class InputType : uint8_t { WASM, UniversalWASM, SharedLibrary, Image };
   InputType WASMType = InputType::WASM;
   /// @}
 
@@ -16,6 +16,7 @@
 #include "common/span.h"
 #include "common/types.h"
 
+#include <memory>
 #include <vector>
 
 namespace WasmEdge {
@@ -26,36 +27,63 @@ class DataInstance {
 public:
   DataInstance() = delete;
   DataInstance(const uint32_t Offset, Span<const Byte> Init) noexcept
-      : Off(Offset), Data(Init.begin(), Init.end()) {}
+      : Off(Offset), Data(Init.begin(), Init.end()), View(Data) {}
+  /// Constructor of the data referencing the loaded image kept by the holder.
+  /// The data is copied if the holder is null.
+  DataInstance(const uint32_t Offset, Span<const Byte> Init,
+               std::shared_ptr<const void> DataHolder) noexcept
+      : Off(Offset), Holder(std::move(DataHolder)) {
+    if (Holder) {
+      View = Init;
+    } else {
+      Data.assign(Init.begin(), Init.end());
+      View = Data;
+    }
+  }
 
   /// Get offset in data instance.
   uint32_t getOffset() const noexcept { return Off; }
 
   /// Get data in data instance.
-  Span<const Byte> getData() const noexcept { return Data; }
+  Span<const Byte> getData() const noexcept { return View; }
 
   /// Load bytes to value.
   ValVariant loadValue(uint32_t Offset, uint32_t N) const noexcept {
     assuming(N <= 16);
     // Check the data boundary.
     if (unlikely(static_cast<uint64_t>(Offset) + static_cast<uint64_t>(N) >
-                 Data.size())) {
+                 View.size())) {
       return 0;
     }
     // Load the data to the value.
     uint128_t Value;
-    std::memcpy(&Value, &Data[Offset], N);
+    std::memcpy(&Value, &View[Offset], N);
     return Value;
   }
 
   /// Clear data in data instance.
-  void clear() { Data.clear(); }
+  void clear() {
+    Data.clear();
+    View = {};
+    Holder.reset();
+  }
+
+  /// Restore data of the dropped data instance, which is kept by the holder.
+  void restore(Span<const Byte> Init, std::shared_ptr<const void> DataHolder) {
+    Data.clear();
+    View = Init;
+    Holder = std::move(DataHolder);
+  }
 
 private:
   /// \name Data of data instance.
   /// @{
   const uint32_t Off;
   std::vector<Byte> Data;
+  /// The data view, which is in the owned data or in the image kept by the
+  /// holder.
+  Span<const Byte> View;
+  std::shared_ptr<const void> Holder;
   /// @}
 };
 
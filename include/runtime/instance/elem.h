@@ -43,6 +43,11 @@ public:
   /// Clear references in element instance.
   void clear() { Refs.clear(); }
 
+  /// Restore references of the dropped element instance.
+  void restore(Span<const RefVariant> Init) {
+    Refs.assign(Init.begin(), Init.end());
+  }
+
 private:
   /// \name Data of element instance.
   /// @{
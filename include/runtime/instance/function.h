@@ -14,11 +14,14 @@
 #pragma once
 
 #include "ast/instruction.h"
+#include "ast/segment.h"
 #include "common/symbol.h"
 #include "runtime/hostfunc.h"
 #include "runtime/instance/composite.h"
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <string>
 #include <vector>
@@ -33,22 +36,44 @@ class FunctionInstance : public CompositeBase {
 public:
   using CompiledFunction = void;
 
+  /// Compiled code of a wasm function in the tiered execution.
+  struct TieredCode {
+    Symbol<CompiledFunction> Code;
+    Symbol<Executable::Wrapper> Wrapper;
+  };
+
   FunctionInstance() = delete;
   /// Move constructor.
   FunctionInstance(FunctionInstance &&Inst) noexcept
       : CompositeBase(Inst.ModInst, Inst.TypeIdx), FuncType(Inst.FuncType),
-        Data(std::move(Inst.Data)) {
+        Data(std::move(Inst.Data)),
+        Hotness(Inst.Hotness.load(std::memory_order_relaxed)),
+        Tiered(Inst.Tiered.exchange(nullptr, std::memory_order_relaxed)) {
     assuming(ModInst);
   }
   /// Constructor for native function.
   FunctionInstance(const ModuleInstance *Mod, const uint32_t TIdx,
                    const AST::FunctionType &Type,
                    Span<const std::pair<uint32_t, ValType>> Locs,
-                   AST::InstrView Expr) noexcept
+                   AST::InstrView Expr, const uint32_t MaxHeight = 0,
+                   Span<const uint32_t> Costs = {}) noexcept
       : CompositeBase(Mod, TIdx), FuncType(Type),
-        Data(std::in_place_type_t<WasmFunction>(), Locs, Expr) {
+        Data(std::in_place_type_t<WasmFunction>(), Locs, Expr, MaxHeight,
+             Costs) {
     assuming(ModInst);
   }
+  /// Constructor for native function with the lazily loaded body.
+  FunctionInstance(const ModuleInstance *Mod, const uint32_t TIdx,
+                   const AST::FunctionType &Type,
+                   Span<const std::pair<uint32_t, ValType>> Locs,
+                   std::shared_ptr<const AST::LazyFunctionBody> Body) noexcept
+      : CompositeBase(Mod, TIdx), FuncType(Type),
+        Data(std::in_place_type_t<WasmFunction>(), Locs, AST::InstrView{}, 0,
+             Span<const uint32_t>{}) {
+    assuming(ModInst);
+    std::get_if<WasmFunction>(&Data)->Lazy =
+        std::make_unique<LazyState>(std::move(Body));
+  }
   /// Constructor for compiled function.
   FunctionInstance(const ModuleInstance *Mod, const uint32_t TIdx,
                    const AST::FunctionType &Type,
@@ -69,6 +94,10 @@ public:
       : CompositeBase(), FuncType(Func->getFuncType()),
         Data(std::in_place_type_t<std::unique_ptr<HostFunctionBase>>(),
              std::move(Func)) {}
+  /// Destructor.
+  ~FunctionInstance() noexcept {
+    delete Tiered.load(std::memory_order_relaxed);
+  }
 
   /// Getter of checking is native wasm function.
   bool isWasmFunction() const noexcept {
@@ -98,6 +127,42 @@ public:
     return std::get_if<WasmFunction>(&Data)->LocalNum;
   }
 
+  /// Getter of the maximum value stack height of the function body.
+  uint32_t getMaxStackHeight() const noexcept {
+    return std::get_if<WasmFunction>(&Data)->MaxStackHeight;
+  }
+
+  /// Getter of checking the function body is loaded lazily.
+  bool isLazyFunction() const noexcept {
+    const auto *Func = std::get_if<WasmFunction>(&Data);
+    return Func && Func->Lazy;
+  }
+
+  /// Load the function body on the first call in the lazy loading mode. The
+  /// loaded instructions and the basic block costs are prepared by the
+  /// `Prepare` function before running. The loading error is kept and returned
+  /// for every call.
+  template <typename PrepareFunc>
+  Expect<void> loadLazyBody(PrepareFunc &&Prepare) const {
+    auto &Func = const_cast<WasmFunction &>(*std::get_if<WasmFunction>(&Data));
+    auto &Lazy = *Func.Lazy;
+    std::call_once(Lazy.Flag, [&]() {
+      AST::Expression Expr;
+      uint32_t MaxHeight = 0;
+      Lazy.Result = Lazy.Body->load(Expr, MaxHeight);
+      if (Lazy.Result) {
+        const auto &Instrs = Expr.getInstrs();
+        Func.Instrs.reserve(Instrs.size() + 1);
+        Func.Instrs.assign(Instrs.begin(), Instrs.end());
+        Prepare(Func.Instrs, Func.MeterCosts);
+        Func.MaxStackHeight = MaxHeight;
+      }
+      // Release the binary after loaded.
+      Lazy.Body.reset();
+    });
+    return Lazy.Result;
+  }
+
   /// Getter of function body instrs.
   AST::InstrView getInstrs() const noexcept {
     if (std::holds_alternative<WasmFunction>(Data)) {
@@ -107,6 +172,38 @@ public:
     }
   }
 
+  /// Getter of the basic block metering cost of the instruction. The cost is
+  /// the sum of the costs from the instruction to the end of its basic block.
+  uint32_t getMeterCost(AST::InstrView::iterator It) const noexcept {
+    const auto &Func = *std::get_if<WasmFunction>(&Data);
+    return Func.MeterCosts[static_cast<size_t>(It - Func.Instrs.data())];
+  }
+
+  /// Increase the count of the calls and the loop iterations of the wasm
+  /// function in the tiered execution, and return the increased count.
+  uint32_t increaseHotness() const noexcept {
+    return Hotness.fetch_add(1, std::memory_order_relaxed) + 1;
+  }
+
+  /// Getter of the compiled code in the tiered execution. Nullptr if the
+  /// function is not compiled yet.
+  const TieredCode *getTieredCode() const noexcept {
+    return Tiered.load(std::memory_order_acquire);
+  }
+
+  /// Setter of the compiled code in the tiered execution. The compiled code can
+  /// only be set once because the executing threads may be using it.
+  void setTieredCode(Symbol<CompiledFunction> Code,
+                     Symbol<Executable::Wrapper> Wrapper) noexcept {
+    auto *New = new TieredCode{std::move(Code), std::move(Wrapper)};
+    const TieredCode *Expected = nullptr;
+    if (!Tiered.compare_exchange_strong(Expected, New,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed)) {
+      delete New;
+    }
+  }
+
   /// Getter of symbol
   auto &getSymbol() const noexcept {
     return *std::get_if<Symbol<CompiledFunction>>(&Data);
@@ -118,18 +215,36 @@ public:
   }
 
 private:
+  /// Loading states of the lazily loaded function body.
+  struct LazyState {
+    LazyState(std::shared_ptr<const AST::LazyFunctionBody> B) noexcept
+        : Body(std::move(B)) {}
+    std::shared_ptr<const AST::LazyFunctionBody> Body;
+    std::once_flag Flag;
+    Expect<void> Result;
+  };
+
   struct WasmFunction {
     const std::vector<std::pair<uint32_t, ValType>> Locals;
     const uint32_t LocalNum;
+    /// The maximum stack height, the instructions, and the costs are set once
+    /// when loading the lazily loaded function body.
+    uint32_t MaxStackHeight;
     AST::InstrVec Instrs;
+    /// The side table of the basic block costs for each instruction, which is
+    /// only prepared for the metering per basic block.
+    std::vector<uint32_t> MeterCosts;
+    std::unique_ptr<LazyState> Lazy;
     WasmFunction(Span<const std::pair<uint32_t, ValType>> Locs,
-                 AST::InstrView Expr) noexcept
+                 AST::InstrView Expr, const uint32_t MaxHeight,
+                 Span<const uint32_t> Costs) noexcept
         : Locals(Locs.begin(), Locs.end()),
           LocalNum(
               std::accumulate(Locals.begin(), Locals.end(), UINT32_C(0),
                               [](uint32_t N, const auto &Pair) -> uint32_t {
                                 return N + Pair.first;
-                              })) {
+                              })),
+          MaxStackHeight(MaxHeight), MeterCosts(Costs.begin(), Costs.end()) {
       // FIXME: Modify the capacity to prevent from connection of 2 vectors.
       Instrs.reserve(Expr.size() + 1);
       Instrs.assign(Expr.begin(), Expr.end());
@@ -143,6 +258,9 @@ private:
   std::variant<WasmFunction, Symbol<CompiledFunction>,
                std::unique_ptr<HostFunctionBase>>
       Data;
+  /// Tiered execution states of the wasm function.
+  mutable std::atomic<uint32_t> Hotness = 0;
+  std::atomic<const TieredCode *> Tiered = nullptr;
   /// @}
 };
 
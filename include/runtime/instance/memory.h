@@ -18,6 +18,7 @@
 #include "common/errinfo.h"
 #include "common/spdlog.h"
 #include "system/allocator.h"
+#include "system/memimage.h"
 
 #include <algorithm>
 #include <cstdint>
@@ -119,6 +120,34 @@ public:
     return true;
   }
 
+  /// Shrink page. The dropped pages are zero-filled when growing again.
+  bool shrinkPage(const uint32_t Count) noexcept {
+    if (Count == 0) {
+      return true;
+    }
+    const uint32_t Min = MemType.getLimit().getMin();
+    if (Count > Min) {
+      return false;
+    }
+    if (auto NewPtr = Allocator::resize(DataPtr, Min, Min - Count);
+        NewPtr == nullptr) {
+      return false;
+    } else {
+      DataPtr = NewPtr;
+    }
+    MemType.getLimit().setMin(Min - Count);
+    return true;
+  }
+
+  /// Map the initial memory image over the beginning of the memory.
+  bool mapImage(const MemoryImage &Image) noexcept {
+    if (DataPtr == nullptr ||
+        Image.size() > MemType.getLimit().getMin() * kPageSize) {
+      return false;
+    }
+    return Image.map(DataPtr);
+  }
+
   /// Get slice of Data[Offset : Offset + Length - 1]
   Expect<Span<Byte>> getBytes(uint32_t Offset, uint32_t Length) const noexcept {
     // Check the memory boundary.
@@ -277,6 +306,23 @@ public:
       return Unexpect(ErrCode::Value::MemoryOutOfBounds);
     }
     // Load the data to the value.
+    loadGuardedValue<T, Length>(Value, Offset);
+    return {};
+  }
+
+  /// Template of loading bytes and convert to a value without checking the
+  /// memory boundary.
+  ///
+  /// The caller should make sure that the loaded bytes are in the memory or
+  /// in the guard region reserved by the allocator. Accessing the guard region
+  /// raises the MemoryOutOfBounds fault.
+  ///
+  /// \param Value the constructed output value.
+  /// \param Offset the start offset in data array.
+  template <typename T, uint32_t Length = sizeof(T)>
+  typename std::enable_if_t<IsWasmNumV<T>, void>
+  loadGuardedValue(T &Value, uint64_t Offset) const noexcept {
+    static_assert(Length <= sizeof(T));
     if (likely(Length > 0)) {
       if constexpr (std::is_floating_point_v<T>) {
         // Floating case. Do the memory copy.
@@ -300,7 +346,6 @@ public:
         }
       }
     }
-    return {};
   }
 
   /// Template of loading bytes and convert to a value.
@@ -324,10 +369,26 @@ public:
       return Unexpect(ErrCode::Value::MemoryOutOfBounds);
     }
     // Copy the stored data to the value.
+    storeGuardedValue<T, Length>(Value, Offset);
+    return {};
+  }
+
+  /// Template of storing a value to bytes without checking the memory
+  /// boundary.
+  ///
+  /// The caller should make sure that the stored bytes are in the memory or in
+  /// the guard region reserved by the allocator. Accessing the guard region
+  /// raises the MemoryOutOfBounds fault.
+  ///
+  /// \param Value the value want to store into data array.
+  /// \param Offset the start offset in data array.
+  template <typename T, uint32_t Length = sizeof(T)>
+  typename std::enable_if_t<IsWasmNativeNumV<T>, void>
+  storeGuardedValue(const T &Value, uint64_t Offset) noexcept {
+    static_assert(Length <= sizeof(T));
     if (likely(Length > 0)) {
       std::memcpy(&DataPtr[Offset], &Value, Length);
     }
-    return {};
   }
 
   uint8_t *getDataPtr() const noexcept { return DataPtr; }
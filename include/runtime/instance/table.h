@@ -86,6 +86,17 @@ public:
     return growTable(Count, InitValue);
   }
 
+  /// Shrink table by dropping the last references.
+  bool shrinkTable(uint32_t Count) noexcept {
+    const uint32_t Min = TabType.getLimit().getMin();
+    if (Count > Min) {
+      return false;
+    }
+    Refs.resize(Refs.size() - Count);
+    TabType.getLimit().setMin(Min - Count);
+    return true;
+  }
+
   /// Get slice of Refs[Offset : Offset + Length - 1]
   Expect<Span<const RefVariant>> getRefs(uint32_t Offset,
                                          uint32_t Length) const noexcept {
@@ -15,8 +15,14 @@
 
 #include "ast/instruction.h"
 #include "runtime/instance/module.h"
+#include "system/allocator.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <new>
 #include <optional>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace WasmEdge {
@@ -37,103 +43,188 @@ public:
 
   struct Frame {
     Frame() = delete;
-    Frame(const Instance::ModuleInstance *Mod, AST::InstrView::iterator FromIt,
-          uint32_t L, uint32_t A, uint32_t V) noexcept
-        : Module(Mod), From(FromIt), Locals(L), Arity(A), VPos(V) {}
+    Frame(const Instance::ModuleInstance *Mod,
+          const Instance::FunctionInstance *F, AST::InstrView::iterator FromIt,
+          uint32_t L, uint32_t A, uint32_t V, uint32_t H) noexcept
+        : Module(Mod), Func(F), From(FromIt), Locals(L), Arity(A), VPos(V),
+          HPos(H) {}
     const Instance::ModuleInstance *Module;
+    /// The wasm function of this frame. Nullptr for the dummy and host
+    /// function frames.
+    const Instance::FunctionInstance *Func;
     AST::InstrView::iterator From;
     uint32_t Locals;
     uint32_t Arity;
     uint32_t VPos;
-    std::vector<Handler> HandlerStack;
+    /// The handlers of this frame start from this position in the handler
+    /// stack.
+    uint32_t HPos;
   };
 
+  /// The value, frame, and handler entries are placed in raw memory and never
+  /// destructed.
+  static_assert(std::is_trivially_copyable_v<Value> &&
+                std::is_trivially_destructible_v<Value>);
+  static_assert(std::is_trivially_copyable_v<Frame> &&
+                std::is_trivially_destructible_v<Frame>);
+  static_assert(std::is_trivially_copyable_v<Handler> &&
+                std::is_trivially_destructible_v<Handler>);
+
+  /// Default maximum depth of the call stack.
+  static inline constexpr const uint32_t kDefaultMaxCallDepth = 65536U;
+  /// Value stack entries reserved for each frame of the call stack depth.
+  static inline constexpr const uint32_t kValuesPerFrame = 16U;
+
   /// Stack manager provides the stack control for Wasm execution with VALIDATED
   /// modules. All operations of instructions passed validation, therefore no
   /// unexpect operations will occur.
-  StackManager() noexcept {
-    ValueStack.reserve(2048U);
-    FrameStack.reserve(16U);
+  ///
+  /// The value stack, the frame stack, and the handler stack are fixed-capacity
+  /// arrays in one memory arena, and each of them is followed by an
+  /// inaccessible guard region. The capacities are checked by the executor
+  /// when entering functions, so the stacks will never grow during execution.
+  StackManager(uint32_t MaxCallDepth = kDefaultMaxCallDepth) noexcept {
+    MaxCallDepth = std::max(MaxCallDepth, 1U);
+    const uint64_t ValueCap =
+        static_cast<uint64_t>(MaxCallDepth) * kValuesPerFrame;
+    const uint64_t ValueSize = alignUp(ValueCap * sizeof(Value));
+    const uint64_t FrameSize = alignUp(MaxCallDepth * sizeof(Frame));
+    const uint64_t HandlerSize = alignUp(MaxCallDepth * sizeof(Handler));
+    const uint64_t Size = ValueSize + FrameSize + HandlerSize + kGuardSize * 3;
+    if (Cache.Pointer != nullptr && Cache.Size == Size) {
+      // Reuse the arena released by the last stack manager on this thread.
+      Arena = std::exchange(Cache.Pointer, nullptr);
+    } else {
+      Arena = Allocator::allocate_chunk(Size);
+      if (Arena != nullptr &&
+          (!Allocator::set_chunk_inaccessible(Arena + ValueSize, kGuardSize) ||
+           !Allocator::set_chunk_inaccessible(
+               Arena + ValueSize + kGuardSize + FrameSize, kGuardSize) ||
+           !Allocator::set_chunk_inaccessible(Arena + Size - kGuardSize,
+                                              kGuardSize))) {
+        Allocator::release_chunk(Arena, Size);
+        Arena = nullptr;
+      }
+    }
+    if (Arena == nullptr) {
+      // Leave all the stacks in zero capacity. Every function entering will
+      // fail with the call stack exhausted error.
+      return;
+    }
+    ArenaSize = Size;
+    ValueBase = ValueTop = reinterpret_cast<Value *>(Arena);
+    ValueEnd = ValueBase + ValueCap;
+    FrameBase = FrameTop =
+        reinterpret_cast<Frame *>(Arena + ValueSize + kGuardSize);
+    FrameEnd = FrameBase + MaxCallDepth;
+    HandlerBase = HandlerTop = reinterpret_cast<Handler *>(
+        Arena + ValueSize + kGuardSize + FrameSize + kGuardSize);
+    HandlerEnd = HandlerBase + MaxCallDepth;
+  }
+  StackManager(const StackManager &) = delete;
+  StackManager &operator=(const StackManager &) = delete;
+  ~StackManager() noexcept {
+    if (Arena == nullptr) {
+      return;
+    }
+    if (Cache.Pointer == nullptr) {
+      Cache.Pointer = Arena;
+      Cache.Size = ArenaSize;
+    } else {
+      Allocator::release_chunk(Arena, ArenaSize);
+    }
   }
-  ~StackManager() = default;
 
   /// Getter of stack size.
-  size_t size() const noexcept { return ValueStack.size(); }
+  size_t size() const noexcept {
+    return static_cast<size_t>(ValueTop - ValueBase);
+  }
+
+  /// Check if there is no room to enter a function which needs N more value
+  /// entries. The tail calls reuse the current frame.
+  bool isExhausted(uint32_t N, bool IsTailCall = false) const noexcept {
+    return (!IsTailCall && FrameTop == FrameEnd) ||
+           static_cast<size_t>(ValueEnd - ValueTop) < N;
+  }
+
+  /// Check if there is no room to push a new handler.
+  bool isHandlerExhausted() const noexcept { return HandlerTop == HandlerEnd; }
 
   /// Unsafe getter of top entry of stack.
-  Value &getTop() { return ValueStack.back(); }
+  Value &getTop() { return *(ValueTop - 1); }
 
   /// Unsafe getter of top N-th value entry of stack.
   Value &getTopN(uint32_t Offset) noexcept {
-    assuming(0 < Offset && Offset <= ValueStack.size());
-    return ValueStack[ValueStack.size() - Offset];
+    assuming(0 < Offset && Offset <= size());
+    return *(ValueTop - Offset);
   }
 
   /// Unsafe getter of top N value entries of stack.
-  Span<Value> getTopSpan(uint32_t N) {
-    return Span<Value>(ValueStack.end() - N, N);
-  }
+  Span<Value> getTopSpan(uint32_t N) { return Span<Value>(ValueTop - N, N); }
 
   /// Push a new value entry to stack.
   template <typename T> void push(T &&Val) {
-    ValueStack.push_back(std::forward<T>(Val));
+    assuming(ValueTop < ValueEnd);
+    ::new (ValueTop) Value(std::forward<T>(Val));
+    ValueTop++;
   }
 
   /// Push a vector of value to stack
   void pushValVec(const std::vector<Value> &ValVec) {
-    ValueStack.insert(ValueStack.end(), ValVec.begin(), ValVec.end());
+    assuming(ValVec.size() <= static_cast<size_t>(ValueEnd - ValueTop));
+    ValueTop = std::uninitialized_copy(ValVec.begin(), ValVec.end(), ValueTop);
   }
 
   /// Unsafe pop and return the top entry.
-  Value pop() {
-    Value V = std::move(ValueStack.back());
-    ValueStack.pop_back();
-    return V;
-  }
+  Value pop() { return *--ValueTop; }
 
   /// Unsafe pop and return the top N entries.
   std::vector<Value> pop(uint32_t N) {
-    std::vector<Value> Vec;
-    Vec.reserve(N);
-    std::move(ValueStack.end() - N, ValueStack.end(), std::back_inserter(Vec));
-    ValueStack.erase(ValueStack.end() - N, ValueStack.end());
+    std::vector<Value> Vec(ValueTop - N, ValueTop);
+    ValueTop -= N;
     return Vec;
   }
 
   /// Push a new frame entry to stack.
   void pushFrame(const Instance::ModuleInstance *Module,
                  AST::InstrView::iterator From, uint32_t LocalNum = 0,
-                 uint32_t Arity = 0, bool IsTailCall = false) noexcept {
+                 uint32_t Arity = 0, bool IsTailCall = false,
+                 const Instance::FunctionInstance *Func = nullptr) noexcept {
     if (!IsTailCall) {
-      FrameStack.emplace_back(Module, From, LocalNum, Arity,
-                              static_cast<uint32_t>(ValueStack.size()));
+      assuming(FrameTop < FrameEnd);
+      ::new (FrameTop) Frame(Module, Func, From, LocalNum, Arity,
+                             static_cast<uint32_t>(size()),
+                             static_cast<uint32_t>(HandlerTop - HandlerBase));
+      FrameTop++;
     } else {
-      assuming(!FrameStack.empty());
-      assuming(FrameStack.back().VPos >= FrameStack.back().Locals);
-      assuming(FrameStack.back().VPos - FrameStack.back().Locals <=
-               ValueStack.size() - LocalNum);
-      ValueStack.erase(ValueStack.begin() + FrameStack.back().VPos -
-                           FrameStack.back().Locals,
-                       ValueStack.end() - LocalNum);
-      FrameStack.back().Module = Module;
-      FrameStack.back().Locals = LocalNum;
-      FrameStack.back().Arity = Arity;
-      FrameStack.back().VPos = static_cast<uint32_t>(ValueStack.size());
-      FrameStack.back().HandlerStack.clear();
+      assuming(FrameTop != FrameBase);
+      Frame &Top = *(FrameTop - 1);
+      assuming(Top.VPos >= Top.Locals);
+      assuming(Top.VPos - Top.Locals <= size() - LocalNum);
+      // Move the arguments and locals of the callee in place.
+      ValueTop = std::move(ValueTop - LocalNum, ValueTop,
+                           ValueBase + Top.VPos - Top.Locals);
+      Top.Module = Module;
+      Top.Func = Func;
+      Top.Locals = LocalNum;
+      Top.Arity = Arity;
+      Top.VPos = static_cast<uint32_t>(size());
+      HandlerTop = HandlerBase + Top.HPos;
     }
   }
 
   /// Unsafe pop top frame.
   AST::InstrView::iterator popFrame() noexcept {
-    assuming(!FrameStack.empty());
-    assuming(FrameStack.back().VPos >= FrameStack.back().Locals);
-    assuming(FrameStack.back().VPos - FrameStack.back().Locals <=
-             ValueStack.size() - FrameStack.back().Arity);
-    ValueStack.erase(ValueStack.begin() + FrameStack.back().VPos -
-                         FrameStack.back().Locals,
-                     ValueStack.end() - FrameStack.back().Arity);
-    auto From = FrameStack.back().From;
-    FrameStack.pop_back();
+    assuming(FrameTop != FrameBase);
+    const Frame &Top = *(FrameTop - 1);
+    assuming(Top.VPos >= Top.Locals);
+    assuming(Top.VPos - Top.Locals <= size() - Top.Arity);
+    // Move the return values in place.
+    ValueTop = std::move(ValueTop - Top.Arity, ValueTop,
+                         ValueBase + Top.VPos - Top.Locals);
+    HandlerTop = HandlerBase + Top.HPos;
+    auto From = Top.From;
+    FrameTop--;
     return From;
   }
 
@@ -141,39 +232,38 @@ public:
   void
   pushHandler(AST::InstrView::iterator TryIt, uint32_t BlockParamNum,
               Span<const AST::Instruction::CatchDescriptor> Catch) noexcept {
-    assuming(!FrameStack.empty());
-    FrameStack.back().HandlerStack.emplace_back(
-        TryIt, static_cast<uint32_t>(ValueStack.size()) - BlockParamNum, Catch);
+    assuming(FrameTop != FrameBase);
+    assuming(HandlerTop < HandlerEnd);
+    ::new (HandlerTop)
+        Handler(TryIt, static_cast<uint32_t>(size()) - BlockParamNum, Catch);
+    HandlerTop++;
   }
 
   /// Pop the top handler on the stack.
   std::optional<Handler> popTopHandler(uint32_t AssocValSize) noexcept {
-    while (!FrameStack.empty()) {
-      auto &Frame = FrameStack.back();
-      if (!Frame.HandlerStack.empty()) {
-        auto TopHandler = std::move(Frame.HandlerStack.back());
-        Frame.HandlerStack.pop_back();
-        assuming(TopHandler.VPos <= ValueStack.size() - AssocValSize);
-        ValueStack.erase(ValueStack.begin() + TopHandler.VPos,
-                         ValueStack.end() - AssocValSize);
+    while (FrameTop != FrameBase) {
+      if (HandlerTop > HandlerBase + (FrameTop - 1)->HPos) {
+        Handler TopHandler = *--HandlerTop;
+        assuming(TopHandler.VPos <= size() - AssocValSize);
+        ValueTop = std::move(ValueTop - AssocValSize, ValueTop,
+                             ValueBase + TopHandler.VPos);
         return TopHandler;
       }
-      FrameStack.pop_back();
+      FrameTop--;
     }
     return std::nullopt;
   }
 
   /// Unsafe remove inactive handler.
   void removeInactiveHandler(AST::InstrView::iterator PC) noexcept {
-    assuming(!FrameStack.empty());
+    assuming(FrameTop != FrameBase);
     // First pop the inactive handlers. Br instructions may cause the handlers
     // in current frame becomes inactive.
-    auto &HandlerStack = FrameStack.back().HandlerStack;
-    while (!HandlerStack.empty()) {
-      auto &Handler = HandlerStack.back();
-      if (PC < Handler.Try ||
-          PC > Handler.Try + Handler.Try->getTryCatch().JumpEnd) {
-        HandlerStack.pop_back();
+    Handler *const Bottom = HandlerBase + (FrameTop - 1)->HPos;
+    while (HandlerTop > Bottom) {
+      const Handler &Top = *(HandlerTop - 1);
+      if (PC < Top.Try || PC > Top.Try + Top.Try->getTryCatch().JumpEnd) {
+        HandlerTop--;
       } else {
         break;
       }
@@ -182,43 +272,80 @@ public:
 
   /// Unsafe erase value stack.
   void eraseValueStack(uint32_t EraseBegin, uint32_t EraseEnd) noexcept {
-    assuming(EraseEnd <= EraseBegin && EraseBegin <= ValueStack.size());
-    ValueStack.erase(ValueStack.end() - EraseBegin,
-                     ValueStack.end() - EraseEnd);
+    assuming(EraseEnd <= EraseBegin && EraseBegin <= size());
+    ValueTop =
+        std::move(ValueTop - EraseEnd, ValueTop, ValueTop - EraseBegin);
   }
 
   /// Unsafe leave top label.
   AST::InstrView::iterator
   maybePopFrameOrHandler(AST::InstrView::iterator PC) noexcept {
-    if (FrameStack.size() > 1 && PC->isExprLast()) {
+    if (FrameTop - FrameBase > 1 && PC->isExprLast()) {
       // Noted that there's always a base frame in stack.
       return popFrame();
     }
     if (PC->isTryBlockLast()) {
-      FrameStack.back().HandlerStack.pop_back();
+      HandlerTop--;
     }
     return PC;
   }
 
   /// Unsafe getter of module address.
   const Instance::ModuleInstance *getModule() const noexcept {
-    assuming(!FrameStack.empty());
-    return FrameStack.back().Module;
+    assuming(FrameTop != FrameBase);
+    return (FrameTop - 1)->Module;
+  }
+
+  /// Unsafe getter of the wasm function of the top frame.
+  const Instance::FunctionInstance *getFunction() const noexcept {
+    assuming(FrameTop != FrameBase);
+    return (FrameTop - 1)->Func;
   }
 
   /// Reset stack.
   void reset() noexcept {
-    ValueStack.clear();
-    FrameStack.clear();
+    ValueTop = ValueBase;
+    FrameTop = FrameBase;
+    HandlerTop = HandlerBase;
   }
 
 private:
+  /// Size of the guard regions, which is also the alignment of the stacks.
+  static inline constexpr const uint64_t kGuardSize = UINT64_C(65536);
+
+  static constexpr uint64_t alignUp(uint64_t Size) noexcept {
+    return (Size + kGuardSize - 1) & ~(kGuardSize - 1);
+  }
+
+  /// The arena released by the last destructed stack manager on this thread.
+  struct ArenaCache {
+    ~ArenaCache() noexcept {
+      if (Pointer != nullptr) {
+        Allocator::release_chunk(Pointer, Size);
+      }
+    }
+    uint8_t *Pointer = nullptr;
+    uint64_t Size = 0;
+  };
+  static thread_local ArenaCache Cache;
+
   /// \name Data of stack manager.
   /// @{
-  std::vector<Value> ValueStack;
-  std::vector<Frame> FrameStack;
+  uint8_t *Arena = nullptr;
+  uint64_t ArenaSize = 0;
+  Value *ValueBase = nullptr;
+  Value *ValueTop = nullptr;
+  Value *ValueEnd = nullptr;
+  Frame *FrameBase = nullptr;
+  Frame *FrameTop = nullptr;
+  Frame *FrameEnd = nullptr;
+  Handler *HandlerBase = nullptr;
+  Handler *HandlerTop = nullptr;
+  Handler *HandlerEnd = nullptr;
   /// @}
 };
 
+inline thread_local StackManager::ArenaCache StackManager::Cache;
+
 } // namespace Runtime
 } // namespace WasmEdge
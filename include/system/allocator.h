@@ -28,6 +28,8 @@ class Allocator {
 public:
   WASMEDGE_EXPORT static uint8_t *allocate(uint32_t PageCount) noexcept;
 
+  /// Grow or shrink the memory. The pages dropped by shrinking are
+  /// zero-filled when the memory grows again.
   WASMEDGE_EXPORT static uint8_t *resize(uint8_t *Pointer,
                                          uint32_t OldPageCount,
                                          uint32_t NewPageCount) noexcept;
@@ -35,12 +37,40 @@ public:
   WASMEDGE_EXPORT static void release(uint8_t *Pointer,
                                       uint32_t PageCount) noexcept;
 
+  /// Whether the allocated memory is followed by an inaccessible region which
+  /// covers all the 33-bit offsets from the start of the memory. Accessing
+  /// the region raises the MemoryOutOfBounds fault instead of touching other
+  /// mappings.
+  static bool has_guard_region() noexcept;
+
+  /// Set the count of the released memory reservations kept for reuse. The
+  /// released memories are reset to inaccessible and zero-filled pages, and
+  /// the reservations are taken by the next allocations instead of reserving
+  /// new regions. The missing slots are reserved immediately, and the default
+  /// capacity 0 disables the pool.
+  static void set_pool_capacity(uint32_t Capacity) noexcept;
+
+  /// Counters of the reservation pool in the current process.
+  struct PoolStatistics {
+    /// Count of the slots kept for reuse.
+    uint32_t Capacity = 0;
+    /// Count of the reservations in the pool now.
+    uint32_t Idle = 0;
+    /// Count of the allocated memories now, and its maximum.
+    uint64_t Live = 0;
+    uint64_t HighWater = 0;
+    /// Count of the allocations served by the pool.
+    uint64_t Reused = 0;
+  };
+  static PoolStatistics get_pool_statistics() noexcept;
+
   static uint8_t *allocate_chunk(uint64_t Size) noexcept;
   static void release_chunk(uint8_t *Pointer, uint64_t Size) noexcept;
   static bool set_chunk_executable(uint8_t *Pointer, uint64_t Size) noexcept;
   static bool set_chunk_readable(uint8_t *Pointer, uint64_t Size) noexcept;
   static bool set_chunk_readable_writable(uint8_t *Pointer,
                                           uint64_t Size) noexcept;
+  static bool set_chunk_inaccessible(uint8_t *Pointer, uint64_t Size) noexcept;
 };
 
 } // namespace WasmEdge
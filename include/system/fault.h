@@ -21,7 +21,9 @@ namespace WasmEdge {
 
 class Fault {
 public:
-  Fault();
+  /// The fault handler without handling the signals only catches the faults
+  /// emitted by emitFault.
+  Fault(bool HandleSignal = true);
 
   ~Fault() noexcept;
 
@@ -31,6 +33,7 @@ public:
 
 private:
   Fault *Prev = nullptr;
+  bool HandleSignal;
   std::jmp_buf Buffer;
 };
 
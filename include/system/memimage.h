@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/system/memimage.h - Memory image class definition --------===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the image of the initial linear memory contents, which
+/// is mapped copy-on-write into the memory instances.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include "common/filesystem.h"
+#include "common/span.h"
+#include "common/types.h"
+
+#include <cstdint>
+
+namespace WasmEdge {
+
+class MemoryImage {
+public:
+  /// Create a zero-filled anonymous image file in the size.
+  MemoryImage(uint64_t Size) noexcept;
+  /// Open the read-only image in the size at the offset of the file. The
+  /// offset should be aligned to the wasm page size.
+  MemoryImage(const std::filesystem::path &Path, uint64_t Offset,
+              uint64_t Size) noexcept;
+  ~MemoryImage() noexcept;
+  MemoryImage(const MemoryImage &) = delete;
+  MemoryImage &operator=(const MemoryImage &) = delete;
+
+  bool ok() const noexcept;
+  uint64_t size() const noexcept { return Size; }
+
+  /// Write the data into the image at the offset.
+  bool write(uint64_t Offset, Span<const Byte> Data) noexcept;
+
+  /// Read the data from the image at the offset.
+  bool read(uint64_t Offset, Span<Byte> Data) const noexcept;
+
+  /// Map the image privately over the beginning of the accessible memory. The
+  /// pages are shared with the image until written.
+  bool map(uint8_t *Pointer) const noexcept;
+
+  static bool supported() noexcept;
+
+private:
+  int File = -1;
+  uint64_t FileOffset = 0;
+  uint64_t Size = 0;
+};
+
+} // namespace WasmEdge
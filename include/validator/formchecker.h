@@ -62,6 +62,7 @@ public:
   auto &getTags() { return Tags; }
   uint32_t getNumImportFuncs() const { return NumImportFuncs; }
   uint32_t getNumImportGlobals() const { return NumImportGlobals; }
+  uint32_t getMaxStackHeight() const { return MaxStackHeight; }
 
   /// Helper function
   ValType VTypeToAST(const VType &V);
@@ -144,6 +145,8 @@ private:
   /// Running stack.
   std::vector<CtrlFrame> CtrlStack;
   std::vector<VType> ValStack;
+  /// Maximum height of the value stack in the checked expression.
+  uint32_t MaxStackHeight = 0;
 };
 
 } // namespace Validator
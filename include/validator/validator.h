@@ -48,7 +48,7 @@ private:
   Expect<void> validate(const AST::GlobalSegment &GlobSeg);
   Expect<void> validate(const AST::ElementSegment &ElemSeg);
   Expect<void> validate(const AST::CodeSegment &CodeSeg,
-                        const uint32_t TypeIdx);
+                        const uint32_t TypeIdx, FormChecker &CodeChecker);
   Expect<void> validate(const AST::DataSegment &DataSeg);
 
   /// Validate AST::Desc
@@ -20,17 +20,20 @@
 #include "common/types.h"
 
 #include "executor/executor.h"
+#include "executor/snapshot.h"
 #include "loader/loader.h"
 #include "validator/validator.h"
 
 #include "runtime/instance/module.h"
 #include "runtime/storemgr.h"
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <shared_mutex>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -44,7 +47,7 @@ public:
   VM() = delete;
   VM(const Configure &Conf);
   VM(const Configure &Conf, Runtime::StoreManager &S);
-  ~VM() = default;
+  ~VM();
 
   /// ======= Functions can be called before instantiated stage. =======
   /// Register wasm modules and host modules.
@@ -132,6 +135,13 @@ public:
     return unsafeInstantiate();
   }
 
+  /// Instantiate validated wasm module from the snapshot of its initialized
+  /// instance.
+  Expect<void> instantiate(const Executor::Snapshot &Snap) {
+    std::unique_lock Lock(Mutex);
+    return unsafeInstantiate(&Snap);
+  }
+
   /// ======= Functions can be called after instantiated stage. =======
   /// Execute wasm with given input.
   Expect<std::vector<std::pair<ValVariant, ValType>>>
@@ -150,6 +160,12 @@ public:
     return unsafeExecute(ModName, Func, Params, ParamTypes);
   }
 
+  /// Save the snapshot of the current instantiated module instance.
+  Expect<void> saveSnapshot(const std::filesystem::path &Path) {
+    std::shared_lock Lock(Mutex);
+    return unsafeSaveSnapshot(Path);
+  }
+
   /// Asynchronous execute wasm with given input.
   Async<Expect<std::vector<std::pair<ValVariant, ValType>>>>
   asyncExecute(std::string_view Func, Span<const ValVariant> Params = {},
@@ -242,7 +258,9 @@ private:
 
   Expect<void> unsafeValidate();
 
-  Expect<void> unsafeInstantiate();
+  Expect<void> unsafeInstantiate(const Executor::Snapshot *Snap = nullptr);
+
+  Expect<void> unsafeSaveSnapshot(const std::filesystem::path &Path);
 
   Expect<std::vector<std::pair<ValVariant, ValType>>>
   unsafeExecute(std::string_view Func, Span<const ValVariant> Params = {},
@@ -271,6 +289,18 @@ private:
   void unsafeRegisterBuiltInHosts();
   void unsafeRegisterPlugInHosts();
 
+  /// Helper functions for the AOT cache of the loaded module.
+  void unsafeLoadAOTCache(Span<const Byte> Code);
+  void unsafeStartAOTCache();
+
+  /// Helper functions for the module image cache of the loaded module.
+  bool unsafeLoadImageCache(Span<const Byte> Code);
+  void unsafeStartImageCache();
+
+  /// Helper functions for the tiered execution of the active module.
+  void unsafeInitTierUp(const AST::Module &Module);
+  void startTierUp(const Runtime::Instance::FunctionInstance &Func);
+
   /// Helper function for execution.
   Expect<std::vector<std::pair<ValVariant, ValType>>>
   unsafeExecute(const Runtime::Instance::ModuleInstance *ModInst,
@@ -312,6 +342,30 @@ private:
   /// Reference to the store.
   Runtime::StoreManager &StoreRef;
   /// @}
+
+  /// \name AOT cache of the loaded module.
+  /// @{
+  /// Wasm binary and cache path of the loaded module missing in the cache.
+  std::vector<Byte> AOTCacheCode;
+  std::filesystem::path AOTCachePath;
+  /// Background compilation thread, which publishes the module into the cache.
+  std::thread AOTCacheThread;
+  /// @}
+
+  /// \name Module image cache of the loaded module.
+  /// @{
+  /// Cache path of the loaded module missing in the cache.
+  std::filesystem::path ImageCachePath;
+  /// @}
+
+  /// \name Tiered execution of the active module.
+  /// @{
+  /// Copy of the loaded AST module for the background compilation.
+  std::shared_ptr<AST::Module> TierUpMod;
+  /// Background compilation thread, which is started once for the module.
+  std::thread TierUpThread;
+  std::atomic<bool> TierUpStarted = false;
+  /// @}
 };
 
 } // namespace VM
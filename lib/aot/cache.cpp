@@ -4,19 +4,34 @@
 #include "aot/cache.h"
 
 #include "aot/blake3.h"
+#include "aot/version.h"
 #include "common/config.h"
 #include "common/defines.h"
 #include "common/hexstr.h"
+#include "common/spdlog.h"
 #include "system/path.h"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <string>
 #include <system_error>
+#include <vector>
+
+#if WASMEDGE_OS_LINUX || WASMEDGE_OS_MACOS
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
 
 namespace WasmEdge {
 namespace AOT {
 
 namespace {
+std::atomic<uint64_t> HitCount = 0;
+std::atomic<uint64_t> MissCount = 0;
+std::atomic<uint64_t> EvictionCount = 0;
+
 std::filesystem::path getRoot(Cache::StorageScope Scope) {
   switch (Scope) {
   case Cache::StorageScope::Global:
@@ -31,6 +46,40 @@ std::filesystem::path getRoot(Cache::StorageScope Scope) {
     assumingUnreachable();
   }
 }
+
+/// Exclusive lock of the cache path between processes, which is released when
+/// the process exits.
+class FileLock {
+public:
+  FileLock(const std::filesystem::path &Path) noexcept {
+#if WASMEDGE_OS_LINUX || WASMEDGE_OS_MACOS
+    Fd = ::open(Path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (Fd >= 0 && ::flock(Fd, LOCK_EX | LOCK_NB) != 0) {
+      ::close(Fd);
+      Fd = -1;
+    }
+#else
+    // Rely on the atomic renaming only.
+    static_cast<void>(Path);
+    Fd = 0;
+#endif
+  }
+  ~FileLock() noexcept {
+#if WASMEDGE_OS_LINUX || WASMEDGE_OS_MACOS
+    if (Fd >= 0) {
+      ::flock(Fd, LOCK_UN);
+      ::close(Fd);
+    }
+#endif
+  }
+  FileLock(const FileLock &) = delete;
+  FileLock &operator=(const FileLock &) = delete;
+
+  bool isLocked() const noexcept { return Fd >= 0; }
+
+private:
+  int Fd = -1;
+};
 } // namespace
 
 Expect<std::filesystem::path> Cache::getPath(Span<const Byte> Data,
@@ -60,5 +109,138 @@ void Cache::clear(Cache::StorageScope Scope, std::string_view Key) {
   std::filesystem::remove_all(Root, ErrCode);
 }
 
+std::string Cache::getKey(const Configure &Conf, std::string_view Target) {
+  const auto &CompilerConf = Conf.getCompilerConfigure();
+  const auto &StatConf = Conf.getStatisticsConfigure();
+  std::vector<Byte> Options;
+  Options.push_back(static_cast<Byte>(CompilerConf.getOptimizationLevel()));
+  Options.push_back(static_cast<Byte>(CompilerConf.getOutputFormat()));
+  Options.push_back(CompilerConf.isGenericBinary());
+  Options.push_back(CompilerConf.isInterruptible());
+  Options.push_back(StatConf.isInstructionCounting());
+  Options.push_back(StatConf.isCostMeasuring());
+  Options.push_back(StatConf.isTimeMeasuring());
+  for (uint8_t I = 0; I < static_cast<uint8_t>(Proposal::Max); ++I) {
+    Options.push_back(Conf.hasProposal(static_cast<Proposal>(I)));
+  }
+
+  Blake3 Hasher;
+  Hasher.update(Span<const Byte>(
+      reinterpret_cast<const Byte *>(Target.data()), Target.size()));
+  Hasher.update(Options);
+  std::array<Byte, 8> Hash;
+  Hasher.finalize(Hash);
+  std::string HexStr;
+  convertBytesToHexStr(Hash, HexStr);
+
+  return fmt::format("v{}-{}"sv, kBinaryVersion, HexStr);
+}
+
+Expect<void> Cache::publish(
+    const std::filesystem::path &Path,
+    const std::function<Expect<void>(const std::filesystem::path &)> &Writer) {
+  std::error_code Error;
+  std::filesystem::create_directories(Path.parent_path(), Error);
+  if (Error) {
+    spdlog::error(ErrCode::Value::IllegalPath);
+    spdlog::error("    Create cache directory failed:{}"sv,
+                  Path.parent_path().u8string());
+    return Unexpect(ErrCode::Value::IllegalPath);
+  }
+
+  auto LockPath = Path;
+  LockPath += ".lock"sv;
+  FileLock Lock(LockPath);
+  if (!Lock.isLocked()) {
+    spdlog::debug("Cache {} is being compiled by another process."sv,
+                  Path.u8string());
+    return {};
+  }
+  if (std::filesystem::exists(Path, Error)) {
+    return {};
+  }
+
+  auto TmpPath = Path;
+  TmpPath += ".tmp"sv;
+  if (auto Res = Writer(TmpPath); !Res) {
+    std::filesystem::remove(TmpPath, Error);
+    return Unexpect(Res);
+  }
+  std::filesystem::rename(TmpPath, Path, Error);
+  if (Error) {
+    std::filesystem::remove(TmpPath, Error);
+    spdlog::error(ErrCode::Value::IllegalPath);
+    spdlog::error("    Publish cache failed:{}"sv, Path.u8string());
+    return Unexpect(ErrCode::Value::IllegalPath);
+  }
+  return {};
+}
+
+uint64_t Cache::prune(Cache::StorageScope Scope, uint64_t Budget) {
+  struct Entry {
+    std::filesystem::path Path;
+    std::filesystem::file_time_type Time;
+    uint64_t Size;
+  };
+  std::vector<Entry> Entries;
+  uint64_t Total = 0;
+  std::error_code Error;
+  for (std::filesystem::recursive_directory_iterator
+           It(getRoot(Scope), Error),
+       End;
+       !Error && It != End; It.increment(Error)) {
+    // Skip the lock files and the temporary files of the compilation.
+    if (!It->is_regular_file(Error) || It->path().has_extension()) {
+      continue;
+    }
+    const auto Size = It->file_size(Error);
+    const auto Time = It->last_write_time(Error);
+    if (Error) {
+      Error.clear();
+      continue;
+    }
+    Entries.push_back({It->path(), Time, Size});
+    Total += Size;
+  }
+
+  // Evict the oldest accessed modules first.
+  std::sort(Entries.begin(), Entries.end(),
+            [](const Entry &LHS, const Entry &RHS) {
+              return LHS.Time < RHS.Time;
+            });
+  uint64_t Evicted = 0;
+  for (const auto &E : Entries) {
+    if (Total <= Budget) {
+      break;
+    }
+    if (std::filesystem::remove(E.Path, Error)) {
+      spdlog::debug("Evict AOT cache {}"sv, E.Path.u8string());
+      Total -= E.Size;
+      ++Evicted;
+    }
+  }
+  EvictionCount.fetch_add(Evicted, std::memory_order_relaxed);
+  return Evicted;
+}
+
+void Cache::recordHit(const std::filesystem::path &Path) noexcept {
+  // The modification time of the cached module is the last access time for
+  // the eviction.
+  std::error_code Error;
+  std::filesystem::last_write_time(
+      Path, std::filesystem::file_time_type::clock::now(), Error);
+  HitCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Cache::recordMiss() noexcept {
+  MissCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+Cache::Statistics Cache::getStatistics() noexcept {
+  return {HitCount.load(std::memory_order_relaxed),
+          MissCount.load(std::memory_order_relaxed),
+          EvictionCount.load(std::memory_order_relaxed)};
+}
+
 } // namespace AOT
 } // namespace WasmEdge
@@ -3,12 +3,15 @@
 
 #include "wasmedge/wasmedge.h"
 
+#include "aot/cache.h"
 #include "common/defines.h"
 #include "driver/compiler.h"
 #include "driver/tool.h"
 #include "driver/unitool.h"
+#include "executor/pool.h"
 #include "host/wasi/wasimodule.h"
 #include "plugin/plugin.h"
+#include "system/allocator.h"
 #include "system/winapi.h"
 #include "vm/vm.h"
 #include "llvm/codegen.h"
@@ -357,6 +360,8 @@ CONVTO(Tag, Runtime::Instance::TagInstance, TagInstance, )
 CONVTO(Glob, Runtime::Instance::GlobalInstance, GlobalInstance, )
 CONVTO(CallFrame, Runtime::CallingFrame, CallingFrame, const)
 CONVTO(Plugin, Plugin::Plugin, Plugin, const)
+CONVTO(Snap, Executor::Snapshot, Snapshot, )
+CONVTO(Pool, Executor::InstancePool, InstancePool, )
 #undef CONVTO
 
 #define CONVFROM(SIMP, INST, NAME, QUANT)                                      \
@@ -397,6 +402,10 @@ CONVFROM(Glob, Runtime::Instance::GlobalInstance, GlobalInstance, )
 CONVFROM(Glob, Runtime::Instance::GlobalInstance, GlobalInstance, const)
 CONVFROM(CallFrame, Runtime::CallingFrame, CallingFrame, const)
 CONVFROM(Plugin, Plugin::Plugin, Plugin, const)
+CONVFROM(Snap, Executor::Snapshot, Snapshot, )
+CONVFROM(Snap, Executor::Snapshot, Snapshot, const)
+CONVFROM(Pool, Executor::InstancePool, InstancePool, )
+CONVFROM(Pool, Executor::InstancePool, InstancePool, const)
 #undef CONVFROM
 
 // C API Host function class
@@ -878,6 +887,150 @@ WasmEdge_ConfigureGetMaxMemoryPage(const WasmEdge_ConfigureContext *Cxt) {
   return 0;
 }
 
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureSetMaxCallStackDepth(WasmEdge_ConfigureContext *Cxt,
+                                       const uint32_t Depth) {
+  if (Cxt) {
+    Cxt->Conf.getRuntimeConfigure().setMaxCallStackDepth(Depth);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT uint32_t
+WasmEdge_ConfigureGetMaxCallStackDepth(const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return Cxt->Conf.getRuntimeConfigure().getMaxCallStackDepth();
+  }
+  return 0;
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureSetTieredJIT(WasmEdge_ConfigureContext *Cxt,
+                               const bool IsTieredJIT) {
+  if (Cxt) {
+    Cxt->Conf.getRuntimeConfigure().setEnableTieredJIT(IsTieredJIT);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT bool
+WasmEdge_ConfigureIsTieredJIT(const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return Cxt->Conf.getRuntimeConfigure().isEnableTieredJIT();
+  }
+  return false;
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureSetTierUpThreshold(WasmEdge_ConfigureContext *Cxt,
+                                     const uint32_t Threshold) {
+  if (Cxt) {
+    Cxt->Conf.getRuntimeConfigure().setTierUpThreshold(Threshold);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT uint32_t
+WasmEdge_ConfigureGetTierUpThreshold(const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return Cxt->Conf.getRuntimeConfigure().getTierUpThreshold();
+  }
+  return 0;
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureSetAOTCache(WasmEdge_ConfigureContext *Cxt,
+                              const bool IsAOTCache) {
+  if (Cxt) {
+    Cxt->Conf.getRuntimeConfigure().setEnableAOTCache(IsAOTCache);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT bool
+WasmEdge_ConfigureIsAOTCache(const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return Cxt->Conf.getRuntimeConfigure().isEnableAOTCache();
+  }
+  return false;
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureSetAOTCacheSizeLimit(WasmEdge_ConfigureContext *Cxt,
+                                       const uint64_t Limit) {
+  if (Cxt) {
+    Cxt->Conf.getRuntimeConfigure().setAOTCacheSizeLimit(Limit);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT uint64_t
+WasmEdge_ConfigureGetAOTCacheSizeLimit(const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return Cxt->Conf.getRuntimeConfigure().getAOTCacheSizeLimit();
+  }
+  return 0;
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureSetImageCache(WasmEdge_ConfigureContext *Cxt,
+                                const bool IsEnable) {
+  if (Cxt) {
+    Cxt->Conf.getRuntimeConfigure().setEnableImageCache(IsEnable);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT bool
+WasmEdge_ConfigureIsImageCache(const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return Cxt->Conf.getRuntimeConfigure().isEnableImageCache();
+  }
+  return false;
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureSetLoadingJobs(WasmEdge_ConfigureContext *Cxt,
+                                 const uint32_t Jobs) {
+  if (Cxt) {
+    Cxt->Conf.getRuntimeConfigure().setLoadingJobs(Jobs);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT uint32_t
+WasmEdge_ConfigureGetLoadingJobs(const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return Cxt->Conf.getRuntimeConfigure().getLoadingJobs();
+  }
+  return 0;
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureSetLazyLoading(WasmEdge_ConfigureContext *Cxt,
+                                 const bool IsLazyLoading) {
+  if (Cxt) {
+    Cxt->Conf.getRuntimeConfigure().setLazyLoading(IsLazyLoading);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT bool
+WasmEdge_ConfigureIsLazyLoading(const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return Cxt->Conf.getRuntimeConfigure().isLazyLoading();
+  }
+  return false;
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureSetValidationJobs(WasmEdge_ConfigureContext *Cxt,
+                                    const uint32_t Jobs) {
+  if (Cxt) {
+    Cxt->Conf.getRuntimeConfigure().setValidationJobs(Jobs);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT uint32_t
+WasmEdge_ConfigureGetValidationJobs(const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return Cxt->Conf.getRuntimeConfigure().getValidationJobs();
+  }
+  return 0;
+}
+
 WASMEDGE_CAPI_EXPORT void
 WasmEdge_ConfigureSetForceInterpreter(WasmEdge_ConfigureContext *Cxt,
                                       const bool IsForceInterpreter) {
@@ -910,6 +1063,57 @@ WasmEdge_ConfigureIsForceInterpreter(const WasmEdge_ConfigureContext *Cxt) {
   return false;
 }
 
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureSetThreadedInterpreter(WasmEdge_ConfigureContext *Cxt,
+                                         const bool IsThreadedInterpreter) {
+  if (Cxt) {
+    Cxt->Conf.getRuntimeConfigure().setThreadedInterpreter(
+        IsThreadedInterpreter);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT bool
+WasmEdge_ConfigureIsThreadedInterpreter(const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return Cxt->Conf.getRuntimeConfigure().isThreadedInterpreter();
+  }
+  return false;
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureSetRegisterInterpreter(WasmEdge_ConfigureContext *Cxt,
+                                         const bool IsRegisterInterpreter) {
+  if (Cxt) {
+    Cxt->Conf.getRuntimeConfigure().setRegisterInterpreter(
+        IsRegisterInterpreter);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT bool
+WasmEdge_ConfigureIsRegisterInterpreter(const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return Cxt->Conf.getRuntimeConfigure().isRegisterInterpreter();
+  }
+  return false;
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureSetGuardPageBoundsCheck(WasmEdge_ConfigureContext *Cxt,
+                                          const bool IsGuardPageBoundsCheck) {
+  if (Cxt) {
+    Cxt->Conf.getRuntimeConfigure().setGuardPageBoundsCheck(
+        IsGuardPageBoundsCheck);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT bool
+WasmEdge_ConfigureIsGuardPageBoundsCheck(const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return Cxt->Conf.getRuntimeConfigure().isGuardPageBoundsCheck();
+  }
+  return false;
+}
+
 WASMEDGE_CAPI_EXPORT void WasmEdge_ConfigureCompilerSetOptimizationLevel(
     WasmEdge_ConfigureContext *Cxt,
     const enum WasmEdge_CompilerOptimizationLevel Level) {
@@ -996,6 +1200,22 @@ WASMEDGE_CAPI_EXPORT bool WasmEdge_ConfigureCompilerIsInterruptible(
   return false;
 }
 
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureCompilerSetJobs(WasmEdge_ConfigureContext *Cxt,
+                                  const uint32_t Jobs) {
+  if (Cxt) {
+    Cxt->Conf.getCompilerConfigure().setJobs(Jobs);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT uint32_t
+WasmEdge_ConfigureCompilerGetJobs(const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return Cxt->Conf.getCompilerConfigure().getJobs();
+  }
+  return 0;
+}
+
 WASMEDGE_CAPI_EXPORT void WasmEdge_ConfigureStatisticsSetInstructionCounting(
     WasmEdge_ConfigureContext *Cxt, const bool IsCount) {
   if (Cxt) {
@@ -1027,6 +1247,22 @@ WASMEDGE_CAPI_EXPORT bool WasmEdge_ConfigureStatisticsIsCostMeasuring(
   return false;
 }
 
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureStatisticsSetBlockCostMeasuring(
+    WasmEdge_ConfigureContext *Cxt, const bool IsMeasure) {
+  if (Cxt) {
+    Cxt->Conf.getStatisticsConfigure().setBlockCostMeasuring(IsMeasure);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT bool WasmEdge_ConfigureStatisticsIsBlockCostMeasuring(
+    const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return Cxt->Conf.getStatisticsConfigure().isBlockCostMeasuring();
+  }
+  return false;
+}
+
 WASMEDGE_CAPI_EXPORT void
 WasmEdge_ConfigureStatisticsSetTimeMeasuring(WasmEdge_ConfigureContext *Cxt,
                                              const bool IsMeasure) {
@@ -1733,6 +1969,53 @@ WasmEdge_CompilerDelete(WasmEdge_CompilerContext *Cxt) {
 
 // <<<<<<<< WasmEdge AOT compiler functions <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
+// >>>>>>>> WasmEdge AOT cache functions >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+WASMEDGE_CAPI_EXPORT void WasmEdge_AOTCacheGetStatistics(uint64_t *Hits,
+                                                         uint64_t *Misses,
+                                                         uint64_t *Evictions) {
+  const auto Stat = WasmEdge::AOT::Cache::getStatistics();
+  if (Hits) {
+    *Hits = Stat.Hits;
+  }
+  if (Misses) {
+    *Misses = Stat.Misses;
+  }
+  if (Evictions) {
+    *Evictions = Stat.Evictions;
+  }
+}
+
+// <<<<<<<< WasmEdge AOT cache functions <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+// >>>>>>>> WasmEdge memory pool functions >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_MemoryPoolSetCapacity(const uint32_t Capacity) {
+  WasmEdge::Allocator::set_pool_capacity(Capacity);
+}
+
+WASMEDGE_CAPI_EXPORT void WasmEdge_MemoryPoolGetStatistics(uint32_t *Idle,
+                                                           uint64_t *Live,
+                                                           uint64_t *HighWater,
+                                                           uint64_t *Reused) {
+  const auto Stat = WasmEdge::Allocator::get_pool_statistics();
+  if (Idle) {
+    *Idle = Stat.Idle;
+  }
+  if (Live) {
+    *Live = Stat.Live;
+  }
+  if (HighWater) {
+    *HighWater = Stat.HighWater;
+  }
+  if (Reused) {
+    *Reused = Stat.Reused;
+  }
+}
+
+// <<<<<<<< WasmEdge memory pool functions <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
 // >>>>>>>> WasmEdge loader functions >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 
 WASMEDGE_CAPI_EXPORT WasmEdge_LoaderContext *
@@ -1776,6 +2059,27 @@ WASMEDGE_CAPI_EXPORT WasmEdge_Result WasmEdge_LoaderParseFromBytes(
       Module);
 }
 
+WASMEDGE_CAPI_EXPORT WasmEdge_Result WasmEdge_LoaderParseFromStream(
+    WasmEdge_LoaderContext *Cxt, WasmEdge_ASTModuleContext **Module,
+    WasmEdge_StreamReadFunc_t ReadFunc, void *Data) {
+  return wrap(
+      [&]() {
+        return fromLoaderCxt(Cxt)->parseModule(
+            [ReadFunc, Data](Span<Byte> Buf) -> Expect<size_t> {
+              const int64_t Read = ReadFunc(
+                  Data, Buf.data(),
+                  static_cast<uint32_t>(std::min(
+                      Buf.size(), static_cast<size_t>(UINT32_MAX))));
+              if (Read < 0) {
+                return Unexpect(ErrCode::Value::ReadError);
+              }
+              return static_cast<size_t>(Read);
+            });
+      },
+      [&](auto &&Res) { *Module = toASTModCxt((*Res).release()); }, Cxt,
+      Module, ReadFunc);
+}
+
 WASMEDGE_CAPI_EXPORT WasmEdge_Result WasmEdge_LoaderSerializeASTModule(
     WasmEdge_LoaderContext *Cxt, const WasmEdge_ASTModuleContext *ASTCxt,
     WasmEdge_Bytes *Buf) {
@@ -1863,6 +2167,32 @@ WASMEDGE_CAPI_EXPORT WasmEdge_Result WasmEdge_ExecutorInstantiate(
       ModuleCxt, StoreCxt, ASTCxt);
 }
 
+WASMEDGE_CAPI_EXPORT WasmEdge_Result WasmEdge_ExecutorInstantiateSnapshot(
+    WasmEdge_ExecutorContext *Cxt, WasmEdge_ModuleInstanceContext **ModuleCxt,
+    WasmEdge_StoreContext *StoreCxt, const WasmEdge_ASTModuleContext *ASTCxt,
+    const WasmEdge_SnapshotContext *SnapCxt) {
+  return wrap(
+      [&]() {
+        return fromExecutorCxt(Cxt)->instantiateSnapshot(
+            *fromStoreCxt(StoreCxt), *fromASTModCxt(ASTCxt),
+            *fromSnapCxt(SnapCxt));
+      },
+      [&](auto &&Res) { *ModuleCxt = toModCxt((*Res).release()); }, Cxt,
+      ModuleCxt, StoreCxt, ASTCxt, SnapCxt);
+}
+
+WASMEDGE_CAPI_EXPORT WasmEdge_Result
+WasmEdge_ExecutorSaveSnapshot(WasmEdge_ExecutorContext *Cxt,
+                              const WasmEdge_ModuleInstanceContext *ModuleCxt,
+                              const char *Path) {
+  return wrap(
+      [&]() {
+        return fromExecutorCxt(Cxt)->saveSnapshot(
+            *fromModCxt(ModuleCxt), std::filesystem::absolute(Path));
+      },
+      EmptyThen, Cxt, ModuleCxt, Path);
+}
+
 WASMEDGE_CAPI_EXPORT WasmEdge_Result WasmEdge_ExecutorRegister(
     WasmEdge_ExecutorContext *Cxt, WasmEdge_ModuleInstanceContext **ModuleCxt,
     WasmEdge_StoreContext *StoreCxt, const WasmEdge_ASTModuleContext *ASTCxt,
@@ -1925,6 +2255,72 @@ WasmEdge_ExecutorDelete(WasmEdge_ExecutorContext *Cxt) {
 
 // <<<<<<<< WasmEdge executor functions <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
+// >>>>>>>> WasmEdge snapshot functions >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+WASMEDGE_CAPI_EXPORT WasmEdge_Result
+WasmEdge_SnapshotLoad(WasmEdge_SnapshotContext **Cxt, const char *Path) {
+  return wrap(
+      [&]() {
+        return WasmEdge::Executor::Snapshot::load(
+            std::filesystem::absolute(Path));
+      },
+      [&](auto &&Res) { *Cxt = toSnapCxt((*Res).release()); }, Cxt, Path);
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_SnapshotDelete(WasmEdge_SnapshotContext *Cxt) {
+  delete fromSnapCxt(Cxt);
+}
+
+// <<<<<<<< WasmEdge snapshot functions <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+// >>>>>>>> WasmEdge instance pool functions >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+WASMEDGE_CAPI_EXPORT WasmEdge_Result WasmEdge_InstancePoolCreate(
+    WasmEdge_InstancePoolContext **Cxt, WasmEdge_ExecutorContext *ExecCxt,
+    WasmEdge_StoreContext *StoreCxt, const WasmEdge_ASTModuleContext *ASTCxt,
+    const uint32_t Size) {
+  return wrap(
+      [&]() {
+        return WasmEdge::Executor::InstancePool::create(
+            *fromExecutorCxt(ExecCxt), *fromStoreCxt(StoreCxt),
+            *fromASTModCxt(ASTCxt), Size);
+      },
+      [&](auto &&Res) { *Cxt = toPoolCxt((*Res).release()); }, Cxt, ExecCxt,
+      StoreCxt, ASTCxt);
+}
+
+WASMEDGE_CAPI_EXPORT WasmEdge_Result
+WasmEdge_InstancePoolAcquire(WasmEdge_InstancePoolContext *Cxt,
+                             WasmEdge_ModuleInstanceContext **ModuleCxt) {
+  return wrap([&]() { return fromPoolCxt(Cxt)->acquire(); },
+              [&](auto &&Res) { *ModuleCxt = toModCxt(*Res); }, Cxt,
+              ModuleCxt);
+}
+
+WASMEDGE_CAPI_EXPORT WasmEdge_Result
+WasmEdge_InstancePoolRelease(WasmEdge_InstancePoolContext *Cxt,
+                             WasmEdge_ModuleInstanceContext *ModuleCxt) {
+  return wrap(
+      [&]() { return fromPoolCxt(Cxt)->release(fromModCxt(ModuleCxt)); },
+      EmptyThen, Cxt, ModuleCxt);
+}
+
+WASMEDGE_CAPI_EXPORT uint32_t
+WasmEdge_InstancePoolGetIdleCount(const WasmEdge_InstancePoolContext *Cxt) {
+  if (Cxt) {
+    return fromPoolCxt(Cxt)->getIdleCount();
+  }
+  return 0;
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_InstancePoolDelete(WasmEdge_InstancePoolContext *Cxt) {
+  delete fromPoolCxt(Cxt);
+}
+
+// <<<<<<<< WasmEdge instance pool functions <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
 // >>>>>>>> WasmEdge store functions >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 
 WASMEDGE_CAPI_EXPORT WasmEdge_StoreContext *WasmEdge_StoreCreate(void) {
@@ -2965,6 +3361,20 @@ WasmEdge_VMInstantiate(WasmEdge_VMContext *Cxt) {
   return wrap([&]() { return Cxt->VM.instantiate(); }, EmptyThen, Cxt);
 }
 
+WASMEDGE_CAPI_EXPORT WasmEdge_Result
+WasmEdge_VMInstantiateSnapshot(WasmEdge_VMContext *Cxt,
+                               const WasmEdge_SnapshotContext *SnapCxt) {
+  return wrap([&]() { return Cxt->VM.instantiate(*fromSnapCxt(SnapCxt)); },
+              EmptyThen, Cxt, SnapCxt);
+}
+
+WASMEDGE_CAPI_EXPORT WasmEdge_Result
+WasmEdge_VMSaveSnapshot(WasmEdge_VMContext *Cxt, const char *Path) {
+  return wrap(
+      [&]() { return Cxt->VM.saveSnapshot(std::filesystem::absolute(Path)); },
+      EmptyThen, Cxt, Path);
+}
+
 WASMEDGE_CAPI_EXPORT WasmEdge_Result
 WasmEdge_VMExecute(WasmEdge_VMContext *Cxt, const WasmEdge_String FuncName,
                    const WasmEdge_Value *Params, const uint32_t ParamLen,
@@ -0,0 +1,281 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/lib/baseline/assembler.h - x86-64 encoder ----------------===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the minimal x86-64 instruction encoder used by the
+/// baseline compiler.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <vector>
+
+namespace WasmEdge::Baseline {
+
+/// General purpose registers.
+enum class Reg : uint8_t {
+  RAX,
+  RCX,
+  RDX,
+  RBX,
+  RSP,
+  RBP,
+  RSI,
+  RDI,
+  R8,
+  R9,
+  R10,
+  R11,
+  R12,
+  R13,
+  R14,
+  R15,
+};
+
+/// SSE registers.
+enum class XReg : uint8_t { XMM0, XMM1 };
+
+/// Condition codes.
+enum class Cond : uint8_t {
+  O,
+  NO,
+  B,
+  AE,
+  E,
+  NE,
+  BE,
+  A,
+  S,
+  NS,
+  P,
+  NP,
+  L,
+  GE,
+  LE,
+  G,
+};
+
+/// Memory operand of [Base + Index + Disp].
+struct Mem {
+  Reg Base;
+  int32_t Disp = 0;
+  bool HasIndex = false;
+  Reg Index = Reg::RAX;
+};
+
+/// Encoder of the instructions. Memory operands are always encoded with the
+/// 32-bit displacement, and the branches with the 32-bit relative offset.
+class Assembler {
+public:
+  std::vector<uint8_t> &getCode() noexcept { return Code; }
+  size_t size() const noexcept { return Code.size(); }
+
+  void byte(uint8_t B) { Code.push_back(B); }
+  void dword(uint32_t D) {
+    for (uint32_t I = 0; I < 4; ++I) {
+      Code.push_back(static_cast<uint8_t>(D >> (I * 8)));
+    }
+  }
+  void qword(uint64_t Q) {
+    for (uint32_t I = 0; I < 8; ++I) {
+      Code.push_back(static_cast<uint8_t>(Q >> (I * 8)));
+    }
+  }
+
+  /// Encode the prefix, REX, opcode and ModRM with a register operand.
+  void rr(uint8_t Prefix, bool W, std::initializer_list<uint8_t> Op,
+          uint8_t R, uint8_t RM) {
+    if (Prefix) {
+      byte(Prefix);
+    }
+    rex(W, R, 0, RM);
+    for (auto B : Op) {
+      byte(B);
+    }
+    byte(static_cast<uint8_t>(0xC0 | ((R & 7) << 3) | (RM & 7)));
+  }
+
+  /// Encode the prefix, REX, opcode and ModRM with a memory operand.
+  void rm(uint8_t Prefix, bool W, std::initializer_list<uint8_t> Op,
+          uint8_t R, const Mem &M) {
+    const uint8_t Base = static_cast<uint8_t>(M.Base);
+    const uint8_t Index = M.HasIndex ? static_cast<uint8_t>(M.Index) : 0;
+    if (Prefix) {
+      byte(Prefix);
+    }
+    rex(W, R, Index, Base);
+    for (auto B : Op) {
+      byte(B);
+    }
+    if (M.HasIndex) {
+      byte(static_cast<uint8_t>(0x80 | ((R & 7) << 3) | 4));
+      byte(static_cast<uint8_t>(((Index & 7) << 3) | (Base & 7)));
+    } else if ((Base & 7) == 4) {
+      byte(static_cast<uint8_t>(0x80 | ((R & 7) << 3) | 4));
+      byte(0x24);
+    } else {
+      byte(static_cast<uint8_t>(0x80 | ((R & 7) << 3) | (Base & 7)));
+    }
+    dword(static_cast<uint32_t>(M.Disp));
+  }
+
+  /// \name General purpose instructions.
+  /// @{
+  void movLoad(bool W, Reg R, const Mem &M) { rm(0, W, {0x8B}, r(R), M); }
+  void movStore(bool W, const Mem &M, Reg R) { rm(0, W, {0x89}, r(R), M); }
+  void movStore16(const Mem &M, Reg R) { rm(0x66, false, {0x89}, r(R), M); }
+  void movStore8(const Mem &M, Reg R) { rm(0, false, {0x88}, r(R), M); }
+  void movRR(bool W, Reg Dst, Reg Src) { rr(0, W, {0x8B}, r(Dst), r(Src)); }
+  void movImm32(Reg R, uint32_t Imm) {
+    rex(false, 0, 0, r(R));
+    byte(static_cast<uint8_t>(0xB8 | (r(R) & 7)));
+    dword(Imm);
+  }
+  void movImm64(Reg R, uint64_t Imm) {
+    rex(true, 0, 0, r(R));
+    byte(static_cast<uint8_t>(0xB8 | (r(R) & 7)));
+    qword(Imm);
+  }
+  void lea(Reg R, const Mem &M) { rm(0, true, {0x8D}, r(R), M); }
+  /// ALU operation with the opcode of the `reg, r/m` form.
+  void aluRM(uint8_t Op, bool W, Reg R, const Mem &M) {
+    rm(0, W, {Op}, r(R), M);
+  }
+  void aluRR(uint8_t Op, bool W, Reg Dst, Reg Src) {
+    rr(0, W, {Op}, r(Dst), r(Src));
+  }
+  /// ALU operation with the 32-bit immediate, `Ext` is the ModRM extension.
+  void aluImm(uint8_t Ext, bool W, Reg R, uint32_t Imm) {
+    rr(0, W, {0x81}, Ext, r(R));
+    dword(Imm);
+  }
+  void testRR(bool W, Reg A, Reg B) { rr(0, W, {0x85}, r(B), r(A)); }
+  void imulRM(bool W, Reg R, const Mem &M) { rm(0, W, {0x0F, 0xAF}, r(R), M); }
+  /// Unary group 3 operation, `Ext` is the ModRM extension.
+  void unary(uint8_t Ext, bool W, Reg R) { rr(0, W, {0xF7}, Ext, r(R)); }
+  /// Shift group 2 operation by CL, `Ext` is the ModRM extension.
+  void shiftCL(uint8_t Ext, bool W, Reg R) { rr(0, W, {0xD3}, Ext, r(R)); }
+  void shiftImm(uint8_t Ext, bool W, Reg R, uint8_t Imm) {
+    rr(0, W, {0xC1}, Ext, r(R));
+    byte(Imm);
+  }
+  /// Bit test group 8 operation, `Ext` is the ModRM extension.
+  void bitImm(uint8_t Ext, bool W, Reg R, uint8_t Imm) {
+    rr(0, W, {0x0F, 0xBA}, Ext, r(R));
+    byte(Imm);
+  }
+  void signExtendAcc(bool W) {
+    if (W) {
+      byte(0x48);
+    }
+    byte(0x99);
+  }
+  void setcc(Cond C, Reg R) {
+    rr(0, false, {0x0F, static_cast<uint8_t>(0x90 | uint8_t(C))}, 0, r(R));
+  }
+  void movzx8(Reg Dst, Reg Src) { rr(0, false, {0x0F, 0xB6}, r(Dst), r(Src)); }
+  void cmov(Cond C, bool W, Reg Dst, Reg Src) {
+    rr(0, W, {0x0F, static_cast<uint8_t>(0x40 | uint8_t(C))}, r(Dst), r(Src));
+  }
+  void cmovLoad(Cond C, bool W, Reg Dst, const Mem &M) {
+    rm(0, W, {0x0F, static_cast<uint8_t>(0x40 | uint8_t(C))}, r(Dst), M);
+  }
+  void push(Reg R) {
+    rex(false, 0, 0, r(R));
+    byte(static_cast<uint8_t>(0x50 | (r(R) & 7)));
+  }
+  void pop(Reg R) {
+    rex(false, 0, 0, r(R));
+    byte(static_cast<uint8_t>(0x58 | (r(R) & 7)));
+  }
+  void callMem(const Mem &M) { rm(0, false, {0xFF}, 2, M); }
+  void jmpReg(Reg R) { rr(0, false, {0xFF}, 4, r(R)); }
+  void ret() { byte(0xC3); }
+  void ud2() {
+    byte(0x0F);
+    byte(0x0B);
+  }
+  /// @}
+
+  /// \name SSE instructions. `Prefix` selects the single (0xF3) or double
+  /// (0xF2) precision.
+  /// @{
+  void sseLoad(uint8_t Prefix, XReg X, const Mem &M) {
+    rm(Prefix, false, {0x0F, 0x10}, x(X), M);
+  }
+  void sseStore(uint8_t Prefix, const Mem &M, XReg X) {
+    rm(Prefix, false, {0x0F, 0x11}, x(X), M);
+  }
+  void sseRM(uint8_t Prefix, uint8_t Op, XReg X, const Mem &M) {
+    rm(Prefix, false, {0x0F, Op}, x(X), M);
+  }
+  void sseRR(uint8_t Prefix, uint8_t Op, XReg Dst, XReg Src) {
+    rr(Prefix, false, {0x0F, Op}, x(Dst), x(Src));
+  }
+  void movToX(bool W, XReg X, Reg R) {
+    rr(0x66, W, {0x0F, 0x6E}, x(X), r(R));
+  }
+  void cvtIntToFP(uint8_t Prefix, bool W, XReg X, Reg R) {
+    rr(Prefix, W, {0x0F, 0x2A}, x(X), r(R));
+  }
+  void cvtFPToInt(uint8_t Prefix, bool W, Reg R, XReg X) {
+    rr(Prefix, W, {0x0F, 0x2C}, r(R), x(X));
+  }
+  void round(bool Double, XReg X, const Mem &M, uint8_t Mode) {
+    rm(0x66, false, {0x0F, 0x3A, static_cast<uint8_t>(Double ? 0x0B : 0x0A)},
+       x(X), M);
+    byte(Mode);
+  }
+  /// @}
+
+  /// \name Branches. The returned position is the rel32 field to patch.
+  /// @{
+  size_t jmp() {
+    byte(0xE9);
+    dword(0);
+    return Code.size() - 4;
+  }
+  size_t jcc(Cond C) {
+    byte(0x0F);
+    byte(static_cast<uint8_t>(0x80 | uint8_t(C)));
+    dword(0);
+    return Code.size() - 4;
+  }
+  void jmpTo(size_t Target) { patch(jmp(), Target); }
+  void jccTo(Cond C, size_t Target) { patch(jcc(C), Target); }
+  void patch(size_t Pos, size_t Target) {
+    const auto Rel = static_cast<int32_t>(static_cast<int64_t>(Target) -
+                                          static_cast<int64_t>(Pos + 4));
+    std::memcpy(&Code[Pos], &Rel, sizeof(Rel));
+  }
+  void patchHere(size_t Pos) { patch(Pos, Code.size()); }
+  void patchDword(size_t Pos, uint32_t D) {
+    std::memcpy(&Code[Pos], &D, sizeof(D));
+  }
+  /// @}
+
+private:
+  static uint8_t r(Reg R) noexcept { return static_cast<uint8_t>(R); }
+  static uint8_t x(XReg X) noexcept { return static_cast<uint8_t>(X); }
+  void rex(bool W, uint8_t R, uint8_t X, uint8_t B) {
+    const uint8_t Rex = static_cast<uint8_t>(
+        (W ? 0x08 : 0) | ((R & 8) ? 0x04 : 0) | ((X & 8) ? 0x02 : 0) |
+        ((B & 8) ? 0x01 : 0));
+    if (Rex) {
+      byte(static_cast<uint8_t>(0x40 | Rex));
+    }
+  }
+
+  std::vector<uint8_t> Code;
+};
+
+} // namespace WasmEdge::Baseline
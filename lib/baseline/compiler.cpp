@@ -0,0 +1,1572 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "baseline/compiler.h"
+#include "common/spdlog.h"
+#include "system/allocator.h"
+
+#include "assembler.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <map>
+
+using namespace std::literals;
+
+namespace WasmEdge::Baseline {
+
+namespace {
+
+/// Mandatory prefixes of the single and double precision SSE instructions.
+constexpr uint8_t kSS = 0xF3;
+constexpr uint8_t kSD = 0xF2;
+
+/// Limits of the function frame. The larger functions keep running in the
+/// interpreter.
+constexpr uint32_t kMaxLocalNum = 65536;
+constexpr uint32_t kMaxFrameSize = 1024 * 1024;
+
+/// Offsets of the saved registers and the value slots from RBP.
+constexpr int32_t kSavedRegsSize = 40;
+
+bool isScalar(const ValType &Type) noexcept {
+  switch (Type.getCode()) {
+  case TypeCode::I32:
+  case TypeCode::I64:
+  case TypeCode::F32:
+  case TypeCode::F64:
+    return true;
+  default:
+    return false;
+  }
+}
+
+bool is64(const ValType &Type) noexcept {
+  return Type.getCode() == TypeCode::I64 || Type.getCode() == TypeCode::F64;
+}
+
+bool isScalar(const AST::FunctionType &Type) noexcept {
+  return std::all_of(Type.getParamTypes().begin(), Type.getParamTypes().end(),
+                     [](const ValType &T) { return isScalar(T); }) &&
+         std::all_of(Type.getReturnTypes().begin(),
+                     Type.getReturnTypes().end(),
+                     [](const ValType &T) { return isScalar(T); });
+}
+
+template <typename T> uint64_t bitsOf(T Value) noexcept {
+  if constexpr (sizeof(T) == 4) {
+    uint32_t Bits;
+    std::memcpy(&Bits, &Value, sizeof(Bits));
+    return Bits;
+  } else {
+    uint64_t Bits;
+    std::memcpy(&Bits, &Value, sizeof(Bits));
+    return Bits;
+  }
+}
+
+/// Module level information shared by the function compilers.
+struct ModuleInfo {
+  Span<const AST::SubType> SubTypes;
+  std::vector<uint32_t> FuncTypeIdxs;
+  std::vector<ValType> GlobalTypes;
+  uint32_t MemoryNum = 0;
+  bool HasPopcnt = false;
+  bool HasSSE41 = false;
+
+  const AST::FunctionType *getFuncType(uint32_t TypeIdx) const noexcept {
+    if (TypeIdx >= SubTypes.size() ||
+        !SubTypes[TypeIdx].getCompositeType().isFunc()) {
+      return nullptr;
+    }
+    return &SubTypes[TypeIdx].getCompositeType().getFuncType();
+  }
+};
+
+/// Single-pass compiler of a function body. Every local and operand stack
+/// entry lives in an 8-byte slot of the native frame, and each instruction
+/// is expanded into a fixed template over the slots.
+///
+/// Register usage:
+///   RBX: execution context, R12: memory pointers, R13: returns,
+///   R14: base of the memory 0, R15: global pointers,
+///   RAX, RCX, RDX, XMM0, XMM1: scratch.
+///
+/// The generated function has the signature of the type wrappers, so that the
+/// wrapper of every type is a single jump to the function.
+class FunctionCompiler {
+public:
+  FunctionCompiler(const ModuleInfo &Info,
+                   const Executable::IntrinsicsTable *const *Slot) noexcept
+      : Info(Info), IntrinsicsSlot(Slot) {}
+
+  bool compile(const AST::FunctionType &Type, const AST::CodeSegment &Code);
+
+  std::vector<uint8_t> &getCode() noexcept { return A.getCode(); }
+
+private:
+  enum class BlockKind : uint8_t { Function, Block, Loop, If };
+  struct Control {
+    BlockKind Kind;
+    uint32_t Height;
+    uint32_t Params;
+    uint32_t Results;
+    size_t LoopStart = 0;
+    size_t ElseFixup = 0;
+    bool HasElse = false;
+    std::vector<size_t> Fixups;
+  };
+
+  bool compile(const AST::Instruction &Instr);
+
+  /// \name Value slots.
+  /// @{
+  Mem slot(uint32_t Index) const noexcept {
+    return Mem{Reg::RBP,
+               -kSavedRegsSize - 8 - static_cast<int32_t>(Index) * 8};
+  }
+  Mem stack(uint32_t Pos) const noexcept { return slot(LocalNum + Pos); }
+  Mem top(uint32_t Depth = 0) const noexcept {
+    return stack(Height - 1 - Depth);
+  }
+  void push() noexcept {
+    ++Height;
+    MaxHeight = std::max(MaxHeight, Height);
+  }
+  void pop(uint32_t N = 1) noexcept { Height -= N; }
+  void copySlot(const Mem &Dst, const Mem &Src) {
+    if (Dst.Disp != Src.Disp) {
+      A.movLoad(true, Reg::RAX, Src);
+      A.movStore(true, Dst, Reg::RAX);
+    }
+  }
+  /// @}
+
+  /// \name Control flow.
+  /// @{
+  bool getBlockArity(const BlockType &BType, uint32_t &Params,
+                     uint32_t &Results) const noexcept;
+  void pushControl(BlockKind Kind, uint32_t Params, uint32_t Results) {
+    Ctrl.push_back(Control{Kind, Height - Params, Params, Results, 0, 0, false, {}});
+  }
+  void emitBranch(uint32_t Depth);
+  void emitReturn();
+  void emitReturnValues();
+  void markDead() noexcept {
+    Dead = true;
+    DeadDepth = 0;
+  }
+  void trapIf(Cond C, ErrCode::Value Code) {
+    Traps[static_cast<uint32_t>(Code)].push_back(A.jcc(C));
+  }
+  void trap(ErrCode::Value Code) {
+    Traps[static_cast<uint32_t>(Code)].push_back(A.jmp());
+  }
+  /// @}
+
+  /// \name Calls.
+  /// @{
+  void callIntrinsic(Executable::Intrinsics Index) {
+    A.movImm64(Reg::RAX, reinterpret_cast<uintptr_t>(IntrinsicsSlot));
+    A.movLoad(true, Reg::RAX, Mem{Reg::RAX});
+    A.callMem(Mem{Reg::RAX, static_cast<int32_t>(Index) * 8});
+  }
+  void reloadMemory() {
+    if (Info.MemoryNum > 0) {
+      A.movLoad(true, Reg::R14, Mem{Reg::R12});
+    }
+  }
+  bool emitCall(const AST::FunctionType *Type, Executable::Intrinsics Index,
+                uint32_t Arg0, uint32_t Arg1, bool HasElemIndex);
+  /// @}
+
+  /// \name Instruction templates.
+  /// @{
+  Mem memOperand(const AST::Instruction &Instr, uint32_t AddrDepth);
+  void emitLoad(const AST::Instruction &Instr, bool W,
+                std::initializer_list<uint8_t> Op);
+  void emitStore(const AST::Instruction &Instr, uint32_t Bytes);
+  void emitBinary(uint8_t Op, bool W);
+  void emitCompare(Cond C, bool W);
+  void emitShift(uint8_t Ext, bool W);
+  void emitDivRem(bool W, bool Signed, bool Rem);
+  void emitFPBinary(bool D, uint8_t Op);
+  void emitFPCompare(bool D, Cond C, bool Swap);
+  void emitFPMinMax(bool D, bool Min);
+  void emitUComi(bool D, XReg Lhs, XReg Rhs) {
+    A.sseRR(D ? 0x66 : 0, 0x2E, Lhs, Rhs);
+  }
+  void loadFPConst(bool D, XReg X, double Value);
+  void emitConvertU64(bool D);
+  void emitTrunc(bool SrcD, bool DstW, bool Signed, bool Sat);
+  /// @}
+
+  const ModuleInfo &Info;
+  const Executable::IntrinsicsTable *const *IntrinsicsSlot;
+  Assembler A;
+  std::vector<ValType> LocalTypes;
+  Span<const ValType> Returns;
+  uint32_t LocalNum = 0;
+  uint32_t Height = 0;
+  uint32_t MaxHeight = 0;
+  uint32_t CallArea = 0;
+  std::vector<Control> Ctrl;
+  std::vector<size_t> EpilogueFixups;
+  std::map<uint32_t, std::vector<size_t>> Traps;
+  bool Dead = false;
+  uint32_t DeadDepth = 0;
+};
+
+bool FunctionCompiler::compile(const AST::FunctionType &Type,
+                               const AST::CodeSegment &Code) {
+  if (!isScalar(Type)) {
+    return false;
+  }
+  LocalTypes = Type.getParamTypes();
+  if (LocalTypes.size() > kMaxLocalNum) {
+    return false;
+  }
+  for (const auto &[Count, LocalType] : Code.getLocals()) {
+    if (!isScalar(LocalType) || Count > kMaxLocalNum - LocalTypes.size()) {
+      return false;
+    }
+    LocalTypes.insert(LocalTypes.end(), Count, LocalType);
+  }
+  Returns = Type.getReturnTypes();
+  LocalNum = static_cast<uint32_t>(LocalTypes.size());
+  const uint32_t ParamNum =
+      static_cast<uint32_t>(Type.getParamTypes().size());
+
+  // Prologue. The arguments are (ExecCtx, Function, Args, Rets).
+  A.push(Reg::RBP);
+  A.movRR(true, Reg::RBP, Reg::RSP);
+  A.push(Reg::RBX);
+  A.push(Reg::R12);
+  A.push(Reg::R13);
+  A.push(Reg::R14);
+  A.push(Reg::R15);
+  A.rr(0, true, {0x81}, 5, static_cast<uint8_t>(Reg::RSP));
+  const size_t FrameSizePos = A.size();
+  A.dword(0);
+  A.movRR(true, Reg::RBX, Reg::RDI);
+  A.movRR(true, Reg::R13, Reg::RCX);
+  // The execution context starts with the memory and the global pointers.
+  A.movLoad(true, Reg::R12, Mem{Reg::RBX, 0});
+  A.movLoad(true, Reg::R15, Mem{Reg::RBX, 8});
+  for (uint32_t I = 0; I < ParamNum; ++I) {
+    A.movLoad(true, Reg::RAX, Mem{Reg::RDX, static_cast<int32_t>(I * 16)});
+    A.movStore(true, slot(I), Reg::RAX);
+  }
+  if (LocalNum > ParamNum) {
+    A.aluRR(0x33, false, Reg::RAX, Reg::RAX);
+    for (uint32_t I = ParamNum; I < LocalNum; ++I) {
+      A.movStore(true, slot(I), Reg::RAX);
+    }
+  }
+  reloadMemory();
+
+  pushControl(BlockKind::Function, 0,
+              static_cast<uint32_t>(Returns.size()));
+  for (const auto &Instr : Code.getExpr().getInstrs()) {
+    if (!compile(Instr)) {
+      return false;
+    }
+    if (Ctrl.empty()) {
+      break;
+    }
+  }
+  if (!Ctrl.empty()) {
+    return false;
+  }
+
+  // Epilogue.
+  for (auto Pos : EpilogueFixups) {
+    A.patchHere(Pos);
+  }
+  A.lea(Reg::RSP, Mem{Reg::RBP, -kSavedRegsSize});
+  A.pop(Reg::R15);
+  A.pop(Reg::R14);
+  A.pop(Reg::R13);
+  A.pop(Reg::R12);
+  A.pop(Reg::RBX);
+  A.pop(Reg::RBP);
+  A.ret();
+
+  // Out of line trap stubs.
+  for (const auto &[Code, Fixups] : Traps) {
+    for (auto Pos : Fixups) {
+      A.patchHere(Pos);
+    }
+    A.movImm32(Reg::RDI, Code);
+    callIntrinsic(Executable::Intrinsics::kTrap);
+    A.ud2();
+  }
+
+  // Keep RSP 16-byte aligned at the calls after pushing 6 registers.
+  const uint64_t FrameSize =
+      ((uint64_t(LocalNum + MaxHeight) * 8 + uint64_t(CallArea) * 16 + 8 +
+        15) &
+       ~UINT64_C(15)) -
+      8;
+  if (FrameSize > kMaxFrameSize) {
+    return false;
+  }
+  A.patchDword(FrameSizePos, static_cast<uint32_t>(FrameSize));
+  return true;
+}
+
+bool FunctionCompiler::getBlockArity(const BlockType &BType, uint32_t &Params,
+                                     uint32_t &Results) const noexcept {
+  if (BType.isEmpty()) {
+    Params = Results = 0;
+    return true;
+  }
+  if (BType.isValType()) {
+    Params = 0;
+    Results = 1;
+    return isScalar(BType.getValType());
+  }
+  const auto *Type = Info.getFuncType(BType.getTypeIndex());
+  if (!Type || !isScalar(*Type)) {
+    return false;
+  }
+  Params = static_cast<uint32_t>(Type->getParamTypes().size());
+  Results = static_cast<uint32_t>(Type->getReturnTypes().size());
+  return true;
+}
+
+void FunctionCompiler::emitBranch(uint32_t Depth) {
+  auto &Target = Ctrl[Ctrl.size() - 1 - Depth];
+  if (Target.Kind == BlockKind::Function) {
+    emitReturn();
+    return;
+  }
+  const uint32_t Arity =
+      Target.Kind == BlockKind::Loop ? Target.Params : Target.Results;
+  for (uint32_t I = 0; I < Arity; ++I) {
+    copySlot(stack(Target.Height + I), stack(Height - Arity + I));
+  }
+  if (Target.Kind == BlockKind::Loop) {
+    A.jmpTo(Target.LoopStart);
+  } else {
+    Target.Fixups.push_back(A.jmp());
+  }
+}
+
+void FunctionCompiler::emitReturnValues() {
+  const auto N = static_cast<uint32_t>(Returns.size());
+  for (uint32_t I = 0; I < N; ++I) {
+    A.movLoad(true, Reg::RAX, stack(Height - N + I));
+    A.movStore(is64(Returns[I]), Mem{Reg::R13, static_cast<int32_t>(I * 16)},
+               Reg::RAX);
+  }
+}
+
+void FunctionCompiler::emitReturn() {
+  emitReturnValues();
+  EpilogueFixups.push_back(A.jmp());
+}
+
+bool FunctionCompiler::emitCall(const AST::FunctionType *Type,
+                                Executable::Intrinsics Index, uint32_t Arg0,
+                                uint32_t Arg1, bool HasElemIndex) {
+  if (!Type || !isScalar(*Type)) {
+    return false;
+  }
+  const auto ArgsN = static_cast<uint32_t>(Type->getParamTypes().size());
+  const auto RetsN = static_cast<uint32_t>(Type->getReturnTypes().size());
+  // The proxies consume the arguments before writing the returns, so both
+  // share the call area at the bottom of the frame.
+  CallArea = std::max({CallArea, ArgsN, RetsN});
+  if (HasElemIndex) {
+    A.movLoad(false, Reg::RDX, top());
+    pop();
+  }
+  for (uint32_t I = 0; I < ArgsN; ++I) {
+    A.movLoad(true, Reg::RAX, stack(Height - ArgsN + I));
+    A.movStore(true, Mem{Reg::RSP, static_cast<int32_t>(I * 16)}, Reg::RAX);
+  }
+  pop(ArgsN);
+  A.movImm32(Reg::RDI, Arg0);
+  if (HasElemIndex) {
+    // callIndirect(TableIdx, FuncTypeIdx, ElemIdx, Args, Rets)
+    A.movImm32(Reg::RSI, Arg1);
+    A.movRR(true, Reg::RCX, Reg::RSP);
+    A.movRR(true, Reg::R8, Reg::RSP);
+  } else {
+    // call(FuncIdx, Args, Rets)
+    A.movRR(true, Reg::RSI, Reg::RSP);
+    A.movRR(true, Reg::RDX, Reg::RSP);
+  }
+  callIntrinsic(Index);
+  for (uint32_t I = 0; I < RetsN; ++I) {
+    push();
+    A.movLoad(true, Reg::RAX, Mem{Reg::RSP, static_cast<int32_t>(I * 16)});
+    A.movStore(true, top(), Reg::RAX);
+  }
+  reloadMemory();
+  return true;
+}
+
+Mem FunctionCompiler::memOperand(const AST::Instruction &Instr,
+                                 uint32_t AddrDepth) {
+  // The 32-bit address is zero extended, and the effective address with the
+  // offset lands in the memory or in the guard region after it.
+  A.movLoad(false, Reg::RAX, top(AddrDepth));
+  Reg Base = Reg::R14;
+  if (Instr.getTargetIndex() != 0) {
+    A.movLoad(true, Reg::RDX,
+              Mem{Reg::R12, static_cast<int32_t>(Instr.getTargetIndex() * 8)});
+    Base = Reg::RDX;
+  }
+  uint32_t Offset = Instr.getMemoryOffset();
+  if (Offset > static_cast<uint32_t>(std::numeric_limits<int32_t>::max())) {
+    A.movImm32(Reg::RCX, Offset);
+    A.aluRR(0x03, true, Reg::RAX, Reg::RCX);
+    Offset = 0;
+  }
+  return Mem{Base, static_cast<int32_t>(Offset), true, Reg::RAX};
+}
+
+void FunctionCompiler::emitLoad(const AST::Instruction &Instr, bool W,
+                                std::initializer_list<uint8_t> Op) {
+  const Mem M = memOperand(Instr, 0);
+  A.rm(0, W, Op, static_cast<uint8_t>(Reg::RAX), M);
+  A.movStore(true, top(), Reg::RAX);
+}
+
+void FunctionCompiler::emitStore(const AST::Instruction &Instr,
+                                 uint32_t Bytes) {
+  const Mem M = memOperand(Instr, 1);
+  A.movLoad(true, Reg::RCX, top());
+  switch (Bytes) {
+  case 1:
+    A.movStore8(M, Reg::RCX);
+    break;
+  case 2:
+    A.movStore16(M, Reg::RCX);
+    break;
+  case 4:
+    A.movStore(false, M, Reg::RCX);
+    break;
+  default:
+    A.movStore(true, M, Reg::RCX);
+    break;
+  }
+  pop(2);
+}
+
+void FunctionCompiler::emitBinary(uint8_t Op, bool W) {
+  A.movLoad(true, Reg::RAX, top(1));
+  if (Op == 0xAF) {
+    A.imulRM(W, Reg::RAX, top(0));
+  } else {
+    A.aluRM(Op, W, Reg::RAX, top(0));
+  }
+  pop();
+  A.movStore(true, top(), Reg::RAX);
+}
+
+void FunctionCompiler::emitCompare(Cond C, bool W) {
+  A.movLoad(true, Reg::RAX, top(1));
+  A.aluRM(0x3B, W, Reg::RAX, top(0));
+  A.setcc(C, Reg::RAX);
+  A.movzx8(Reg::RAX, Reg::RAX);
+  pop();
+  A.movStore(true, top(), Reg::RAX);
+}
+
+void FunctionCompiler::emitShift(uint8_t Ext, bool W) {
+  // The hardware masks the count by the operand width as wasm does.
+  A.movLoad(true, Reg::RCX, top(0));
+  A.movLoad(true, Reg::RAX, top(1));
+  A.shiftCL(Ext, W, Reg::RAX);
+  pop();
+  A.movStore(true, top(), Reg::RAX);
+}
+
+void FunctionCompiler::emitDivRem(bool W, bool Signed, bool Rem) {
+  A.movLoad(true, Reg::RCX, top(0));
+  A.movLoad(true, Reg::RAX, top(1));
+  A.testRR(W, Reg::RCX, Reg::RCX);
+  trapIf(Cond::E, ErrCode::Value::DivideByZero);
+  if (Signed) {
+    size_t Done = 0;
+    A.aluImm(7, W, Reg::RCX, UINT32_C(0xFFFFFFFF));
+    const size_t NotMinusOne = A.jcc(Cond::NE);
+    if (Rem) {
+      A.aluRR(0x33, false, Reg::RDX, Reg::RDX);
+      Done = A.jmp();
+    } else if (W) {
+      A.movImm64(Reg::RDX, UINT64_C(0x8000000000000000));
+      A.aluRR(0x3B, true, Reg::RAX, Reg::RDX);
+      trapIf(Cond::E, ErrCode::Value::IntegerOverflow);
+    } else {
+      A.aluImm(7, false, Reg::RAX, UINT32_C(0x80000000));
+      trapIf(Cond::E, ErrCode::Value::IntegerOverflow);
+    }
+    A.patchHere(NotMinusOne);
+    A.signExtendAcc(W);
+    A.unary(7, W, Reg::RCX);
+    if (Rem) {
+      A.patchHere(Done);
+    }
+  } else {
+    A.aluRR(0x33, false, Reg::RDX, Reg::RDX);
+    A.unary(6, W, Reg::RCX);
+  }
+  pop();
+  A.movStore(true, top(), Rem ? Reg::RDX : Reg::RAX);
+}
+
+void FunctionCompiler::emitFPBinary(bool D, uint8_t Op) {
+  const uint8_t P = D ? kSD : kSS;
+  A.sseLoad(P, XReg::XMM0, top(1));
+  A.sseRM(P, Op, XReg::XMM0, top(0));
+  pop();
+  A.sseStore(P, top(), XReg::XMM0);
+}
+
+void FunctionCompiler::emitFPCompare(bool D, Cond C, bool Swap) {
+  // Unordered operands set ZF, PF and CF, so only the `above` conditions and
+  // the explicit parity checks are false for NaNs.
+  const uint8_t P = D ? kSD : kSS;
+  A.sseLoad(P, XReg::XMM0, Swap ? top(0) : top(1));
+  A.sseRM(D ? 0x66 : 0, 0x2E, XReg::XMM0, Swap ? top(1) : top(0));
+  A.setcc(C, Reg::RAX);
+  if (C == Cond::E) {
+    A.setcc(Cond::NP, Reg::RCX);
+    A.aluRR(0x23, false, Reg::RAX, Reg::RCX);
+  } else if (C == Cond::NE) {
+    A.setcc(Cond::P, Reg::RCX);
+    A.aluRR(0x0B, false, Reg::RAX, Reg::RCX);
+  }
+  A.movzx8(Reg::RAX, Reg::RAX);
+  pop();
+  A.movStore(true, top(), Reg::RAX);
+}
+
+void FunctionCompiler::emitFPMinMax(bool D, bool Min) {
+  const uint8_t P = D ? kSD : kSS;
+  A.sseLoad(P, XReg::XMM0, top(1));
+  A.sseLoad(P, XReg::XMM1, top(0));
+  emitUComi(D, XReg::XMM0, XReg::XMM1);
+  const size_t IsNaN = A.jcc(Cond::P);
+  const size_t NotEqual = A.jcc(Cond::NE);
+  // Equal operands may differ in the sign of zero.
+  A.sseRR(0, Min ? 0x56 : 0x54, XReg::XMM0, XReg::XMM1);
+  const size_t Done1 = A.jmp();
+  A.patchHere(NotEqual);
+  A.sseRR(P, Min ? 0x5D : 0x5F, XReg::XMM0, XReg::XMM1);
+  const size_t Done2 = A.jmp();
+  A.patchHere(IsNaN);
+  A.sseRR(P, 0x58, XReg::XMM0, XReg::XMM1);
+  A.patchHere(Done1);
+  A.patchHere(Done2);
+  pop();
+  A.sseStore(P, top(), XReg::XMM0);
+}
+
+void FunctionCompiler::loadFPConst(bool D, XReg X, double Value) {
+  if (D) {
+    A.movImm64(Reg::RAX, bitsOf(Value));
+    A.movToX(true, X, Reg::RAX);
+  } else {
+    A.movImm32(Reg::RAX,
+               static_cast<uint32_t>(bitsOf(static_cast<float>(Value))));
+    A.movToX(false, X, Reg::RAX);
+  }
+}
+
+void FunctionCompiler::emitConvertU64(bool D) {
+  const uint8_t P = D ? kSD : kSS;
+  A.movLoad(true, Reg::RAX, top());
+  A.testRR(true, Reg::RAX, Reg::RAX);
+  const size_t Negative = A.jcc(Cond::S);
+  A.cvtIntToFP(P, true, XReg::XMM0, Reg::RAX);
+  const size_t Done = A.jmp();
+  // Halve the value with the lowest bit kept for rounding, and double it.
+  A.patchHere(Negative);
+  A.movRR(true, Reg::RCX, Reg::RAX);
+  A.shiftImm(5, true, Reg::RCX, 1);
+  A.aluImm(4, false, Reg::RAX, 1);
+  A.aluRR(0x0B, true, Reg::RCX, Reg::RAX);
+  A.cvtIntToFP(P, true, XReg::XMM0, Reg::RCX);
+  A.sseRR(P, 0x58, XReg::XMM0, XReg::XMM0);
+  A.patchHere(Done);
+  A.sseStore(P, top(), XReg::XMM0);
+}
+
+void FunctionCompiler::emitTrunc(bool SrcD, bool DstW, bool Signed,
+                                 bool Sat) {
+  const uint8_t P = SrcD ? kSD : kSS;
+  // The valid range is [Lower, Upper) when the lower bound is inclusive, and
+  // (Lower, Upper) otherwise.
+  double Upper, Lower;
+  bool LowerInclusive;
+  uint64_t MaxValue, MinValue;
+  if (Signed) {
+    Upper = DstW ? 9223372036854775808.0 : 2147483648.0;
+    LowerInclusive = DstW || !SrcD;
+    Lower = (DstW || !SrcD) ? -Upper : -2147483649.0;
+    MaxValue = DstW ? UINT64_C(0x7FFFFFFFFFFFFFFF) : UINT64_C(0x7FFFFFFF);
+    MinValue = DstW ? UINT64_C(0x8000000000000000) : UINT64_C(0x80000000);
+  } else {
+    Upper = DstW ? 18446744073709551616.0 : 4294967296.0;
+    LowerInclusive = false;
+    Lower = -1.0;
+    MaxValue = DstW ? UINT64_MAX : UINT64_C(0xFFFFFFFF);
+    MinValue = 0;
+  }
+
+  A.sseLoad(P, XReg::XMM0, top());
+  size_t IsNaN = 0, TooLarge = 0, TooSmall = 0;
+  emitUComi(SrcD, XReg::XMM0, XReg::XMM0);
+  if (Sat) {
+    IsNaN = A.jcc(Cond::P);
+  } else {
+    trapIf(Cond::P, ErrCode::Value::InvalidConvToInt);
+  }
+  loadFPConst(SrcD, XReg::XMM1, Upper);
+  emitUComi(SrcD, XReg::XMM0, XReg::XMM1);
+  if (Sat) {
+    TooLarge = A.jcc(Cond::AE);
+  } else {
+    trapIf(Cond::AE, ErrCode::Value::IntegerOverflow);
+  }
+  loadFPConst(SrcD, XReg::XMM1, Lower);
+  emitUComi(SrcD, XReg::XMM0, XReg::XMM1);
+  const Cond Below = LowerInclusive ? Cond::B : Cond::BE;
+  if (Sat) {
+    TooSmall = A.jcc(Below);
+  } else {
+    trapIf(Below, ErrCode::Value::IntegerOverflow);
+  }
+
+  if (Signed) {
+    A.cvtFPToInt(P, DstW, Reg::RAX, XReg::XMM0);
+  } else if (!DstW) {
+    // The unsigned 32-bit range fits in the signed 64-bit conversion.
+    A.cvtFPToInt(P, true, Reg::RAX, XReg::XMM0);
+  } else {
+    loadFPConst(SrcD, XReg::XMM1, 9223372036854775808.0);
+    emitUComi(SrcD, XReg::XMM0, XReg::XMM1);
+    const size_t Large = A.jcc(Cond::AE);
+    A.cvtFPToInt(P, true, Reg::RAX, XReg::XMM0);
+    const size_t Done = A.jmp();
+    A.patchHere(Large);
+    A.sseRR(P, 0x5C, XReg::XMM0, XReg::XMM1);
+    A.cvtFPToInt(P, true, Reg::RAX, XReg::XMM0);
+    A.bitImm(7, true, Reg::RAX, 63);
+    A.patchHere(Done);
+  }
+
+  if (Sat) {
+    const size_t Done = A.jmp();
+    A.patchHere(IsNaN);
+    A.aluRR(0x33, false, Reg::RAX, Reg::RAX);
+    const size_t Done1 = A.jmp();
+    A.patchHere(TooLarge);
+    A.movImm64(Reg::RAX, MaxValue);
+    const size_t Done2 = A.jmp();
+    A.patchHere(TooSmall);
+    A.movImm64(Reg::RAX, MinValue);
+    A.patchHere(Done);
+    A.patchHere(Done1);
+    A.patchHere(Done2);
+  }
+  A.movStore(true, top(), Reg::RAX);
+}
+
+bool FunctionCompiler::compile(const AST::Instruction &Instr) {
+  const auto Code = Instr.getOpCode();
+
+  // Skip the unreachable instructions until the end of the current block.
+  if (Dead) {
+    switch (Code) {
+    case OpCode::Block:
+    case OpCode::Loop:
+    case OpCode::If:
+      ++DeadDepth;
+      return true;
+    case OpCode::Try:
+    case OpCode::Try_table:
+      return false;
+    case OpCode::Else:
+      if (DeadDepth > 0) {
+        return true;
+      }
+      break;
+    case OpCode::End:
+      if (DeadDepth > 0) {
+        --DeadDepth;
+        return true;
+      }
+      break;
+    default:
+      return true;
+    }
+  }
+
+  switch (Code) {
+  // Control instructions.
+  case OpCode::Unreachable:
+    trap(ErrCode::Value::Unreachable);
+    markDead();
+    return true;
+  case OpCode::Nop:
+    return true;
+  case OpCode::Block:
+  case OpCode::Loop:
+  case OpCode::If: {
+    uint32_t Params, Results;
+    if (!getBlockArity(Instr.getBlockType(), Params, Results)) {
+      return false;
+    }
+    size_t ElseFixup = 0;
+    if (Code == OpCode::If) {
+      A.movLoad(false, Reg::RAX, top());
+      pop();
+      A.testRR(false, Reg::RAX, Reg::RAX);
+      ElseFixup = A.jcc(Cond::E);
+    }
+    pushControl(Code == OpCode::Block  ? BlockKind::Block
+                : Code == OpCode::Loop ? BlockKind::Loop
+                                       : BlockKind::If,
+                Params, Results);
+    Ctrl.back().LoopStart = A.size();
+    Ctrl.back().ElseFixup = ElseFixup;
+    return true;
+  }
+  case OpCode::Else: {
+    auto &Frame = Ctrl.back();
+    if (!Dead) {
+      Frame.Fixups.push_back(A.jmp());
+    }
+    A.patchHere(Frame.ElseFixup);
+    Frame.HasElse = true;
+    Height = Frame.Height + Frame.Params;
+    Dead = false;
+    return true;
+  }
+  case OpCode::End: {
+    auto Frame = std::move(Ctrl.back());
+    Ctrl.pop_back();
+    if (Frame.Kind == BlockKind::Function) {
+      if (!Dead) {
+        emitReturnValues();
+      }
+      return true;
+    }
+    if (Frame.Kind == BlockKind::If && !Frame.HasElse) {
+      A.patchHere(Frame.ElseFixup);
+    }
+    for (auto Pos : Frame.Fixups) {
+      A.patchHere(Pos);
+    }
+    Height = Frame.Height + Frame.Results;
+    Dead = false;
+    return true;
+  }
+  case OpCode::Br:
+    emitBranch(Instr.getJump().TargetIndex);
+    markDead();
+    return true;
+  case OpCode::Br_if: {
+    A.movLoad(false, Reg::RAX, top());
+    pop();
+    A.testRR(false, Reg::RAX, Reg::RAX);
+    const size_t Skip = A.jcc(Cond::E);
+    emitBranch(Instr.getJump().TargetIndex);
+    A.patchHere(Skip);
+    return true;
+  }
+  case OpCode::Br_table: {
+    auto Labels = Instr.getLabelList();
+    A.movLoad(false, Reg::RCX, top());
+    pop();
+    for (uint32_t I = 0; I + 1 < Labels.size(); ++I) {
+      A.aluImm(7, false, Reg::RCX, I);
+      const size_t Skip = A.jcc(Cond::NE);
+      emitBranch(Labels[I].TargetIndex);
+      A.patchHere(Skip);
+    }
+    emitBranch(Labels.back().TargetIndex);
+    markDead();
+    return true;
+  }
+  case OpCode::Return:
+    emitReturn();
+    markDead();
+    return true;
+  case OpCode::Call: {
+    const uint32_t FuncIdx = Instr.getTargetIndex();
+    if (FuncIdx >= Info.FuncTypeIdxs.size()) {
+      return false;
+    }
+    return emitCall(Info.getFuncType(Info.FuncTypeIdxs[FuncIdx]),
+                    Executable::Intrinsics::kCall, FuncIdx, 0, false);
+  }
+  case OpCode::Call_indirect:
+    return emitCall(Info.getFuncType(Instr.getTargetIndex()),
+                    Executable::Intrinsics::kCallIndirect,
+                    Instr.getSourceIndex(), Instr.getTargetIndex(), true);
+
+  // Parametric instructions.
+  case OpCode::Drop:
+    pop();
+    return true;
+  case OpCode::Select_t:
+    if (Instr.getValTypeList().size() != 1 ||
+        !isScalar(Instr.getValTypeList()[0])) {
+      return false;
+    }
+    [[fallthrough]];
+  case OpCode::Select:
+    A.movLoad(false, Reg::RCX, top(0));
+    A.movLoad(true, Reg::RAX, top(2));
+    A.testRR(false, Reg::RCX, Reg::RCX);
+    A.cmovLoad(Cond::E, true, Reg::RAX, top(1));
+    pop(2);
+    A.movStore(true, top(), Reg::RAX);
+    return true;
+
+  // Variable instructions.
+  case OpCode::Local__get:
+    push();
+    copySlot(top(), slot(Instr.getTargetIndex()));
+    return true;
+  case OpCode::Local__set:
+    copySlot(slot(Instr.getTargetIndex()), top());
+    pop();
+    return true;
+  case OpCode::Local__tee:
+    copySlot(slot(Instr.getTargetIndex()), top());
+    return true;
+  case OpCode::Global__get:
+  case OpCode::Global__set: {
+    const uint32_t Idx = Instr.getTargetIndex();
+    if (Idx >= Info.GlobalTypes.size() || !isScalar(Info.GlobalTypes[Idx])) {
+      return false;
+    }
+    const bool W = is64(Info.GlobalTypes[Idx]);
+    const Mem Ptr{Reg::R15, static_cast<int32_t>(Idx * 8)};
+    if (Code == OpCode::Global__get) {
+      A.movLoad(true, Reg::RAX, Ptr);
+      A.movLoad(W, Reg::RAX, Mem{Reg::RAX});
+      push();
+      A.movStore(true, top(), Reg::RAX);
+    } else {
+      A.movLoad(true, Reg::RCX, Ptr);
+      A.movLoad(true, Reg::RAX, top());
+      A.movStore(W, Mem{Reg::RCX}, Reg::RAX);
+      pop();
+    }
+    return true;
+  }
+
+  // Memory instructions.
+  case OpCode::I32__load:
+  case OpCode::F32__load:
+  case OpCode::I64__load32_u:
+    emitLoad(Instr, false, {0x8B});
+    return true;
+  case OpCode::I64__load:
+  case OpCode::F64__load:
+    emitLoad(Instr, true, {0x8B});
+    return true;
+  case OpCode::I32__load8_s:
+    emitLoad(Instr, false, {0x0F, 0xBE});
+    return true;
+  case OpCode::I32__load8_u:
+  case OpCode::I64__load8_u:
+    emitLoad(Instr, false, {0x0F, 0xB6});
+    return true;
+  case OpCode::I32__load16_s:
+    emitLoad(Instr, false, {0x0F, 0xBF});
+    return true;
+  case OpCode::I32__load16_u:
+  case OpCode::I64__load16_u:
+    emitLoad(Instr, false, {0x0F, 0xB7});
+    return true;
+  case OpCode::I64__load8_s:
+    emitLoad(Instr, true, {0x0F, 0xBE});
+    return true;
+  case OpCode::I64__load16_s:
+    emitLoad(Instr, true, {0x0F, 0xBF});
+    return true;
+  case OpCode::I64__load32_s:
+    emitLoad(Instr, true, {0x63});
+    return true;
+  case OpCode::I32__store:
+  case OpCode::F32__store:
+  case OpCode::I64__store32:
+    emitStore(Instr, 4);
+    return true;
+  case OpCode::I64__store:
+  case OpCode::F64__store:
+    emitStore(Instr, 8);
+    return true;
+  case OpCode::I32__store8:
+  case OpCode::I64__store8:
+    emitStore(Instr, 1);
+    return true;
+  case OpCode::I32__store16:
+  case OpCode::I64__store16:
+    emitStore(Instr, 2);
+    return true;
+  case OpCode::Memory__size:
+    A.movImm32(Reg::RDI, Instr.getTargetIndex());
+    callIntrinsic(Executable::Intrinsics::kMemSize);
+    push();
+    A.movStore(true, top(), Reg::RAX);
+    return true;
+  case OpCode::Memory__grow:
+    A.movImm32(Reg::RDI, Instr.getTargetIndex());
+    A.movLoad(false, Reg::RSI, top());
+    callIntrinsic(Executable::Intrinsics::kMemGrow);
+    A.movStore(true, top(), Reg::RAX);
+    reloadMemory();
+    return true;
+  case OpCode::Memory__copy:
+    A.movImm32(Reg::RDI, Instr.getTargetIndex());
+    A.movImm32(Reg::RSI, Instr.getSourceIndex());
+    A.movLoad(false, Reg::RDX, top(2));
+    A.movLoad(false, Reg::RCX, top(1));
+    A.movLoad(false, Reg::R8, top(0));
+    callIntrinsic(Executable::Intrinsics::kMemCopy);
+    pop(3);
+    return true;
+  case OpCode::Memory__fill:
+    A.movImm32(Reg::RDI, Instr.getTargetIndex());
+    A.movLoad(false, Reg::RSI, top(2));
+    A.movLoad(false, Reg::RDX, top(1));
+    A.movLoad(false, Reg::RCX, top(0));
+    callIntrinsic(Executable::Intrinsics::kMemFill);
+    pop(3);
+    return true;
+
+  // Const numeric instructions.
+  case OpCode::I32__const:
+  case OpCode::F32__const:
+    push();
+    A.movImm32(Reg::RAX, Instr.getNum().get<uint32_t>());
+    A.movStore(true, top(), Reg::RAX);
+    return true;
+  case OpCode::I64__const:
+  case OpCode::F64__const:
+    push();
+    A.movImm64(Reg::RAX, Instr.getNum().get<uint64_t>());
+    A.movStore(true, top(), Reg::RAX);
+    return true;
+
+  // Integer numeric instructions.
+  case OpCode::I32__eqz:
+  case OpCode::I64__eqz:
+    A.movLoad(true, Reg::RAX, top());
+    A.testRR(Code == OpCode::I64__eqz, Reg::RAX, Reg::RAX);
+    A.setcc(Cond::E, Reg::RAX);
+    A.movzx8(Reg::RAX, Reg::RAX);
+    A.movStore(true, top(), Reg::RAX);
+    return true;
+  case OpCode::I32__eq:
+    emitCompare(Cond::E, false);
+    return true;
+  case OpCode::I32__ne:
+    emitCompare(Cond::NE, false);
+    return true;
+  case OpCode::I32__lt_s:
+    emitCompare(Cond::L, false);
+    return true;
+  case OpCode::I32__lt_u:
+    emitCompare(Cond::B, false);
+    return true;
+  case OpCode::I32__gt_s:
+    emitCompare(Cond::G, false);
+    return true;
+  case OpCode::I32__gt_u:
+    emitCompare(Cond::A, false);
+    return true;
+  case OpCode::I32__le_s:
+    emitCompare(Cond::LE, false);
+    return true;
+  case OpCode::I32__le_u:
+    emitCompare(Cond::BE, false);
+    return true;
+  case OpCode::I32__ge_s:
+    emitCompare(Cond::GE, false);
+    return true;
+  case OpCode::I32__ge_u:
+    emitCompare(Cond::AE, false);
+    return true;
+  case OpCode::I64__eq:
+    emitCompare(Cond::E, true);
+    return true;
+  case OpCode::I64__ne:
+    emitCompare(Cond::NE, true);
+    return true;
+  case OpCode::I64__lt_s:
+    emitCompare(Cond::L, true);
+    return true;
+  case OpCode::I64__lt_u:
+    emitCompare(Cond::B, true);
+    return true;
+  case OpCode::I64__gt_s:
+    emitCompare(Cond::G, true);
+    return true;
+  case OpCode::I64__gt_u:
+    emitCompare(Cond::A, true);
+    return true;
+  case OpCode::I64__le_s:
+    emitCompare(Cond::LE, true);
+    return true;
+  case OpCode::I64__le_u:
+    emitCompare(Cond::BE, true);
+    return true;
+  case OpCode::I64__ge_s:
+    emitCompare(Cond::GE, true);
+    return true;
+  case OpCode::I64__ge_u:
+    emitCompare(Cond::AE, true);
+    return true;
+  case OpCode::I32__clz:
+  case OpCode::I64__clz: {
+    const bool W = Code == OpCode::I64__clz;
+    // clz(x) = (W ? 63 : 31) - bsr(x), and bsr(0) is taken as -1.
+    A.rm(0, W, {0x0F, 0xBD}, static_cast<uint8_t>(Reg::RAX), top());
+    A.movImm64(Reg::RCX, UINT64_MAX);
+    A.cmov(Cond::E, W, Reg::RAX, Reg::RCX);
+    A.unary(3, W, Reg::RAX);
+    A.aluImm(0, W, Reg::RAX, W ? 63 : 31);
+    A.movStore(true, top(), Reg::RAX);
+    return true;
+  }
+  case OpCode::I32__ctz:
+  case OpCode::I64__ctz: {
+    const bool W = Code == OpCode::I64__ctz;
+    A.rm(0, W, {0x0F, 0xBC}, static_cast<uint8_t>(Reg::RAX), top());
+    A.movImm32(Reg::RCX, W ? 64 : 32);
+    A.cmov(Cond::E, W, Reg::RAX, Reg::RCX);
+    A.movStore(true, top(), Reg::RAX);
+    return true;
+  }
+  case OpCode::I32__popcnt:
+  case OpCode::I64__popcnt:
+    if (!Info.HasPopcnt) {
+      return false;
+    }
+    A.rm(kSS, Code == OpCode::I64__popcnt, {0x0F, 0xB8},
+         static_cast<uint8_t>(Reg::RAX), top());
+    A.movStore(true, top(), Reg::RAX);
+    return true;
+  case OpCode::I32__add:
+    emitBinary(0x03, false);
+    return true;
+  case OpCode::I32__sub:
+    emitBinary(0x2B, false);
+    return true;
+  case OpCode::I32__mul:
+    emitBinary(0xAF, false);
+    return true;
+  case OpCode::I32__and:
+    emitBinary(0x23, false);
+    return true;
+  case OpCode::I32__or:
+    emitBinary(0x0B, false);
+    return true;
+  case OpCode::I32__xor:
+    emitBinary(0x33, false);
+    return true;
+  case OpCode::I64__add:
+    emitBinary(0x03, true);
+    return true;
+  case OpCode::I64__sub:
+    emitBinary(0x2B, true);
+    return true;
+  case OpCode::I64__mul:
+    emitBinary(0xAF, true);
+    return true;
+  case OpCode::I64__and:
+    emitBinary(0x23, true);
+    return true;
+  case OpCode::I64__or:
+    emitBinary(0x0B, true);
+    return true;
+  case OpCode::I64__xor:
+    emitBinary(0x33, true);
+    return true;
+  case OpCode::I32__div_s:
+    emitDivRem(false, true, false);
+    return true;
+  case OpCode::I32__div_u:
+    emitDivRem(false, false, false);
+    return true;
+  case OpCode::I32__rem_s:
+    emitDivRem(false, true, true);
+    return true;
+  case OpCode::I32__rem_u:
+    emitDivRem(false, false, true);
+    return true;
+  case OpCode::I64__div_s:
+    emitDivRem(true, true, false);
+    return true;
+  case OpCode::I64__div_u:
+    emitDivRem(true, false, false);
+    return true;
+  case OpCode::I64__rem_s:
+    emitDivRem(true, true, true);
+    return true;
+  case OpCode::I64__rem_u:
+    emitDivRem(true, false, true);
+    return true;
+  case OpCode::I32__shl:
+    emitShift(4, false);
+    return true;
+  case OpCode::I32__shr_s:
+    emitShift(7, false);
+    return true;
+  case OpCode::I32__shr_u:
+    emitShift(5, false);
+    return true;
+  case OpCode::I32__rotl:
+    emitShift(0, false);
+    return true;
+  case OpCode::I32__rotr:
+    emitShift(1, false);
+    return true;
+  case OpCode::I64__shl:
+    emitShift(4, true);
+    return true;
+  case OpCode::I64__shr_s:
+    emitShift(7, true);
+    return true;
+  case OpCode::I64__shr_u:
+    emitShift(5, true);
+    return true;
+  case OpCode::I64__rotl:
+    emitShift(0, true);
+    return true;
+  case OpCode::I64__rotr:
+    emitShift(1, true);
+    return true;
+
+  // Floating-point numeric instructions.
+  case OpCode::F32__abs:
+    A.movLoad(false, Reg::RAX, top());
+    A.aluImm(4, false, Reg::RAX, UINT32_C(0x7FFFFFFF));
+    A.movStore(true, top(), Reg::RAX);
+    return true;
+  case OpCode::F32__neg:
+    A.movLoad(false, Reg::RAX, top());
+    A.aluImm(6, false, Reg::RAX, UINT32_C(0x80000000));
+    A.movStore(true, top(), Reg::RAX);
+    return true;
+  case OpCode::F64__abs:
+  case OpCode::F64__neg:
+    A.movLoad(true, Reg::RAX, top());
+    A.bitImm(Code == OpCode::F64__abs ? 6 : 7, true, Reg::RAX, 63);
+    A.movStore(true, top(), Reg::RAX);
+    return true;
+  case OpCode::F32__copysign:
+    A.movLoad(false, Reg::RAX, top(1));
+    A.movLoad(false, Reg::RCX, top(0));
+    A.aluImm(4, false, Reg::RAX, UINT32_C(0x7FFFFFFF));
+    A.aluImm(4, false, Reg::RCX, UINT32_C(0x80000000));
+    A.aluRR(0x0B, false, Reg::RAX, Reg::RCX);
+    pop();
+    A.movStore(true, top(), Reg::RAX);
+    return true;
+  case OpCode::F64__copysign:
+    A.movLoad(true, Reg::RAX, top(1));
+    A.movLoad(true, Reg::RCX, top(0));
+    A.bitImm(6, true, Reg::RAX, 63);
+    A.shiftImm(5, true, Reg::RCX, 63);
+    A.shiftImm(4, true, Reg::RCX, 63);
+    A.aluRR(0x0B, true, Reg::RAX, Reg::RCX);
+    pop();
+    A.movStore(true, top(), Reg::RAX);
+    return true;
+  case OpCode::F32__ceil:
+  case OpCode::F32__floor:
+  case OpCode::F32__trunc:
+  case OpCode::F32__nearest:
+  case OpCode::F64__ceil:
+  case OpCode::F64__floor:
+  case OpCode::F64__trunc:
+  case OpCode::F64__nearest: {
+    if (!Info.HasSSE41) {
+      return false;
+    }
+    const bool D = Code == OpCode::F64__ceil || Code == OpCode::F64__floor ||
+                   Code == OpCode::F64__trunc || Code == OpCode::F64__nearest;
+    uint8_t Mode;
+    switch (Code) {
+    case OpCode::F32__nearest:
+    case OpCode::F64__nearest:
+      Mode = 0;
+      break;
+    case OpCode::F32__floor:
+    case OpCode::F64__floor:
+      Mode = 1;
+      break;
+    case OpCode::F32__ceil:
+    case OpCode::F64__ceil:
+      Mode = 2;
+      break;
+    default:
+      Mode = 3;
+      break;
+    }
+    // Suppress the precision exception.
+    A.round(D, XReg::XMM0, top(), static_cast<uint8_t>(Mode | 8));
+    A.sseStore(D ? kSD : kSS, top(), XReg::XMM0);
+    return true;
+  }
+  case OpCode::F32__sqrt:
+  case OpCode::F64__sqrt: {
+    const uint8_t P = Code == OpCode::F64__sqrt ? kSD : kSS;
+    A.sseRM(P, 0x51, XReg::XMM0, top());
+    A.sseStore(P, top(), XReg::XMM0);
+    return true;
+  }
+  case OpCode::F32__add:
+    emitFPBinary(false, 0x58);
+    return true;
+  case OpCode::F32__sub:
+    emitFPBinary(false, 0x5C);
+    return true;
+  case OpCode::F32__mul:
+    emitFPBinary(false, 0x59);
+    return true;
+  case OpCode::F32__div:
+    emitFPBinary(false, 0x5E);
+    return true;
+  case OpCode::F64__add:
+    emitFPBinary(true, 0x58);
+    return true;
+  case OpCode::F64__sub:
+    emitFPBinary(true, 0x5C);
+    return true;
+  case OpCode::F64__mul:
+    emitFPBinary(true, 0x59);
+    return true;
+  case OpCode::F64__div:
+    emitFPBinary(true, 0x5E);
+    return true;
+  case OpCode::F32__min:
+    emitFPMinMax(false, true);
+    return true;
+  case OpCode::F32__max:
+    emitFPMinMax(false, false);
+    return true;
+  case OpCode::F64__min:
+    emitFPMinMax(true, true);
+    return true;
+  case OpCode::F64__max:
+    emitFPMinMax(true, false);
+    return true;
+  case OpCode::F32__eq:
+    emitFPCompare(false, Cond::E, false);
+    return true;
+  case OpCode::F32__ne:
+    emitFPCompare(false, Cond::NE, false);
+    return true;
+  case OpCode::F32__lt:
+    emitFPCompare(false, Cond::A, true);
+    return true;
+  case OpCode::F32__gt:
+    emitFPCompare(false, Cond::A, false);
+    return true;
+  case OpCode::F32__le:
+    emitFPCompare(false, Cond::AE, true);
+    return true;
+  case OpCode::F32__ge:
+    emitFPCompare(false, Cond::AE, false);
+    return true;
+  case OpCode::F64__eq:
+    emitFPCompare(true, Cond::E, false);
+    return true;
+  case OpCode::F64__ne:
+    emitFPCompare(true, Cond::NE, false);
+    return true;
+  case OpCode::F64__lt:
+    emitFPCompare(true, Cond::A, true);
+    return true;
+  case OpCode::F64__gt:
+    emitFPCompare(true, Cond::A, false);
+    return true;
+  case OpCode::F64__le:
+    emitFPCompare(true, Cond::AE, true);
+    return true;
+  case OpCode::F64__ge:
+    emitFPCompare(true, Cond::AE, false);
+    return true;
+
+  // Conversion instructions. The slots keep the bits, so the wrapping and the
+  // reinterpretations are no-ops.
+  case OpCode::I32__wrap_i64:
+  case OpCode::I32__reinterpret_f32:
+  case OpCode::I64__reinterpret_f64:
+  case OpCode::F32__reinterpret_i32:
+  case OpCode::F64__reinterpret_i64:
+    return true;
+  case OpCode::I64__extend_i32_u:
+    A.movLoad(false, Reg::RAX, top());
+    A.movStore(true, top(), Reg::RAX);
+    return true;
+  case OpCode::I64__extend_i32_s:
+  case OpCode::I64__extend32_s:
+    A.rm(0, true, {0x63}, static_cast<uint8_t>(Reg::RAX), top());
+    A.movStore(true, top(), Reg::RAX);
+    return true;
+  case OpCode::I32__extend8_s:
+  case OpCode::I64__extend8_s:
+    A.rm(0, Code == OpCode::I64__extend8_s, {0x0F, 0xBE},
+         static_cast<uint8_t>(Reg::RAX), top());
+    A.movStore(true, top(), Reg::RAX);
+    return true;
+  case OpCode::I32__extend16_s:
+  case OpCode::I64__extend16_s:
+    A.rm(0, Code == OpCode::I64__extend16_s, {0x0F, 0xBF},
+         static_cast<uint8_t>(Reg::RAX), top());
+    A.movStore(true, top(), Reg::RAX);
+    return true;
+  case OpCode::F32__demote_f64:
+    A.sseRM(kSD, 0x5A, XReg::XMM0, top());
+    A.sseStore(kSS, top(), XReg::XMM0);
+    return true;
+  case OpCode::F64__promote_f32:
+    A.sseRM(kSS, 0x5A, XReg::XMM0, top());
+    A.sseStore(kSD, top(), XReg::XMM0);
+    return true;
+  case OpCode::F32__convert_i32_s:
+  case OpCode::F32__convert_i64_s:
+  case OpCode::F64__convert_i32_s:
+  case OpCode::F64__convert_i64_s: {
+    const uint8_t P = (Code == OpCode::F64__convert_i32_s ||
+                       Code == OpCode::F64__convert_i64_s)
+                          ? kSD
+                          : kSS;
+    A.rm(P,
+         Code == OpCode::F32__convert_i64_s ||
+             Code == OpCode::F64__convert_i64_s,
+         {0x0F, 0x2A}, static_cast<uint8_t>(XReg::XMM0), top());
+    A.sseStore(P, top(), XReg::XMM0);
+    return true;
+  }
+  case OpCode::F32__convert_i32_u:
+  case OpCode::F64__convert_i32_u: {
+    const uint8_t P = Code == OpCode::F64__convert_i32_u ? kSD : kSS;
+    A.movLoad(false, Reg::RAX, top());
+    A.cvtIntToFP(P, true, XReg::XMM0, Reg::RAX);
+    A.sseStore(P, top(), XReg::XMM0);
+    return true;
+  }
+  case OpCode::F32__convert_i64_u:
+    emitConvertU64(false);
+    return true;
+  case OpCode::F64__convert_i64_u:
+    emitConvertU64(true);
+    return true;
+  case OpCode::I32__trunc_f32_s:
+    emitTrunc(false, false, true, false);
+    return true;
+  case OpCode::I32__trunc_f32_u:
+    emitTrunc(false, false, false, false);
+    return true;
+  case OpCode::I32__trunc_f64_s:
+    emitTrunc(true, false, true, false);
+    return true;
+  case OpCode::I32__trunc_f64_u:
+    emitTrunc(true, false, false, false);
+    return true;
+  case OpCode::I64__trunc_f32_s:
+    emitTrunc(false, true, true, false);
+    return true;
+  case OpCode::I64__trunc_f32_u:
+    emitTrunc(false, true, false, false);
+    return true;
+  case OpCode::I64__trunc_f64_s:
+    emitTrunc(true, true, true, false);
+    return true;
+  case OpCode::I64__trunc_f64_u:
+    emitTrunc(true, true, false, false);
+    return true;
+  case OpCode::I32__trunc_sat_f32_s:
+    emitTrunc(false, false, true, true);
+    return true;
+  case OpCode::I32__trunc_sat_f32_u:
+    emitTrunc(false, false, false, true);
+    return true;
+  case OpCode::I32__trunc_sat_f64_s:
+    emitTrunc(true, false, true, true);
+    return true;
+  case OpCode::I32__trunc_sat_f64_u:
+    emitTrunc(true, false, false, true);
+    return true;
+  case OpCode::I64__trunc_sat_f32_s:
+    emitTrunc(false, true, true, true);
+    return true;
+  case OpCode::I64__trunc_sat_f32_u:
+    emitTrunc(false, true, false, true);
+    return true;
+  case OpCode::I64__trunc_sat_f64_s:
+    emitTrunc(true, true, true, true);
+    return true;
+  case OpCode::I64__trunc_sat_f64_u:
+    emitTrunc(true, true, false, true);
+    return true;
+
+  default:
+    // The reference types, SIMD, atomic, GC, exception handling and tail call
+    // instructions are left to the interpreter.
+    return false;
+  }
+}
+
+} // namespace
+
+CodeLibrary::~CodeLibrary() noexcept {
+  if (Binary) {
+    Allocator::release_chunk(Binary, BinarySize);
+  }
+}
+
+Expect<void> CodeLibrary::load(std::vector<uint8_t> Code,
+                               std::vector<uint64_t> Offsets) noexcept {
+  BinarySize = Code.size();
+  Binary = Allocator::allocate_chunk(BinarySize);
+  if (unlikely(!Binary)) {
+    spdlog::error(ErrCode::Value::MemoryOutOfBounds);
+    return Unexpect(ErrCode::Value::MemoryOutOfBounds);
+  }
+  std::copy(Code.begin(), Code.end(), Binary);
+  if (!Allocator::set_chunk_executable(Binary, BinarySize)) {
+    spdlog::error(ErrCode::Value::MemoryOutOfBounds);
+    spdlog::error("    set_chunk_executable failed:{}", std::strerror(errno));
+    return Unexpect(ErrCode::Value::MemoryOutOfBounds);
+  }
+  CodeOffsets = std::move(Offsets);
+  return {};
+}
+
+Symbol<const Executable::IntrinsicsTable *>
+CodeLibrary::getIntrinsics() noexcept {
+  return createSymbol<const IntrinsicsTable *>(&IntrinsicsSlot);
+}
+
+std::vector<Symbol<Executable::Wrapper>>
+CodeLibrary::getTypes(size_t Size) noexcept {
+  // The functions have the wrapper signature. The wrapper of every type is
+  // the jump stub at the beginning of the code.
+  std::vector<Symbol<Wrapper>> Result;
+  Result.reserve(Size);
+  for (size_t I = 0; I < Size; ++I) {
+    Result.push_back(createSymbol<Wrapper>(reinterpret_cast<Wrapper *>(Binary)));
+  }
+  return Result;
+}
+
+std::vector<Symbol<void>> CodeLibrary::getCodes(size_t, size_t Size) noexcept {
+  std::vector<Symbol<void>> Result;
+  Result.reserve(Size);
+  for (size_t I = 0; I < Size; ++I) {
+    if (I < CodeOffsets.size() && CodeOffsets[I] != kNoCode) {
+      Result.push_back(createSymbol<void>(Binary + CodeOffsets[I]));
+    } else {
+      Result.emplace_back();
+    }
+  }
+  return Result;
+}
+
+bool Compiler::isSupported(const Configure &Conf) noexcept {
+#if defined(__x86_64__) && !WASMEDGE_OS_WINDOWS
+  // The memory accesses are checked by the guard region, and the code is
+  // neither metered nor interruptible.
+  return Allocator::has_guard_region() &&
+         !Conf.getStatisticsConfigure().isInstructionCounting() &&
+         !Conf.getStatisticsConfigure().isCostMeasuring() &&
+         !Conf.getCompilerConfigure().isInterruptible();
+#else
+  static_cast<void>(Conf);
+  return false;
+#endif
+}
+
+Expect<std::shared_ptr<Executable>>
+Compiler::compile(const AST::Module &Module) {
+  if (!isSupported(Conf)) {
+    spdlog::error(ErrCode::Value::IllegalPath);
+    spdlog::error("    Baseline compiler is unsupported on this host or with "
+                  "the metering and interruptible configurations."sv);
+    return Unexpect(ErrCode::Value::IllegalPath);
+  }
+
+  ModuleInfo Info;
+  Info.SubTypes = Module.getTypeSection().getContent();
+  for (const auto &ImpDesc : Module.getImportSection().getContent()) {
+    switch (ImpDesc.getExternalType()) {
+    case ExternalType::Function:
+      Info.FuncTypeIdxs.push_back(ImpDesc.getExternalFuncTypeIdx());
+      break;
+    case ExternalType::Global:
+      Info.GlobalTypes.push_back(
+          ImpDesc.getExternalGlobalType().getValType());
+      break;
+    case ExternalType::Memory:
+      ++Info.MemoryNum;
+      break;
+    default:
+      break;
+    }
+  }
+  const auto TypeIdxs = Module.getFunctionSection().getContent();
+  Info.FuncTypeIdxs.insert(Info.FuncTypeIdxs.end(), TypeIdxs.begin(),
+                           TypeIdxs.end());
+  for (const auto &GlobSeg : Module.getGlobalSection().getContent()) {
+    Info.GlobalTypes.push_back(GlobSeg.getGlobalType().getValType());
+  }
+  Info.MemoryNum +=
+      static_cast<uint32_t>(Module.getMemorySection().getContent().size());
+#if defined(__x86_64__) && defined(__GNUC__)
+  Info.HasPopcnt = __builtin_cpu_supports("popcnt");
+  Info.HasSSE41 = __builtin_cpu_supports("sse4.1");
+#endif
+
+  auto Library = std::make_shared<CodeLibrary>();
+  std::vector<uint8_t> Code;
+  std::vector<uint64_t> Offsets;
+  // The type wrapper stub: jmp rsi.
+  Code.push_back(0xFF);
+  Code.push_back(0xE6);
+
+  const auto CodeSegs = Module.getCodeSection().getContent();
+  uint32_t CompiledNum = 0;
+  Offsets.reserve(CodeSegs.size());
+  for (size_t I = 0; I < CodeSegs.size(); ++I) {
+    const auto *Type = Info.getFuncType(TypeIdxs[I]);
+    FunctionCompiler FuncCompiler(Info, Library->getIntrinsicsSlot());
+    if (!Type || !FuncCompiler.compile(*Type, CodeSegs[I])) {
+      Offsets.push_back(CodeLibrary::kNoCode);
+      continue;
+    }
+    // Align the function entries with int3.
+    Code.resize((Code.size() + 15) & ~size_t(15), 0xCC);
+    Offsets.push_back(Code.size());
+    const auto &FuncCode = FuncCompiler.getCode();
+    Code.insert(Code.end(), FuncCode.begin(), FuncCode.end());
+    ++CompiledNum;
+  }
+  spdlog::debug("Baseline compiler: {} of {} functions compiled, {} bytes."sv,
+                CompiledNum, CodeSegs.size(), Code.size());
+
+  if (auto Res = Library->load(std::move(Code), std::move(Offsets)); !Res) {
+    return Unexpect(Res);
+  }
+  return Library;
+}
+
+} // namespace WasmEdge::Baseline
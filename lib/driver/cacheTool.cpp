@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "aot/cache.h"
+#include "common/configure.h"
+#include "common/defines.h"
+#include "common/filesystem.h"
+#include "driver/cache.h"
+#include "loader/loader.h"
+#include "validator/validator.h"
+#include "llvm/codegen.h"
+#include "llvm/compiler.h"
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace WasmEdge {
+namespace Driver {
+
+int Cache([[maybe_unused]] struct DriverCacheOptions &Opt) noexcept {
+  using namespace std::literals;
+
+  std::ios::sync_with_stdio(false);
+  Log::setInfoLoggingLevel();
+
+#ifdef WASMEDGE_USE_LLVM
+  const auto Scope = AOT::Cache::StorageScope::Local;
+  if (Opt.Clear.value()) {
+    AOT::Cache::clear(Scope);
+  }
+
+  // Pre-warm the cache with the default configuration, which is the same as
+  // the runtime tool loads the cache with.
+  Configure Conf;
+  const auto Key = AOT::Cache::getKey(Conf, LLVM::Compiler::getTarget(Conf));
+  // Set force interpreter here to load instructions of function body forcibly.
+  Conf.getRuntimeConfigure().setForceInterpreter(true);
+  Loader::Loader Loader(Conf);
+  Validator::Validator ValidatorEngine(Conf);
+  int Status = EXIT_SUCCESS;
+  for (const auto &WasmName : Opt.WasmNames.value()) {
+    const auto InputPath =
+        std::filesystem::absolute(std::filesystem::u8path(WasmName));
+    std::vector<Byte> Data;
+    if (auto Res = Loader.loadFile(InputPath)) {
+      Data = std::move(*Res);
+    } else {
+      const auto Err = static_cast<uint32_t>(Res.error());
+      spdlog::error("Load {} failed. Error code: {}", WasmName, Err);
+      Status = EXIT_FAILURE;
+      continue;
+    }
+
+    std::unique_ptr<AST::Module> Module;
+    if (auto Res = Loader.parseModule(Data)) {
+      Module = std::move(*Res);
+    } else {
+      const auto Err = static_cast<uint32_t>(Res.error());
+      spdlog::error("Parse Module {} failed. Error code: {}", WasmName, Err);
+      Status = EXIT_FAILURE;
+      continue;
+    }
+    if (auto Res = ValidatorEngine.validate(*Module); !Res) {
+      const auto Err = static_cast<uint32_t>(Res.error());
+      spdlog::error("Validate Module {} failed. Error code: {}", WasmName, Err);
+      Status = EXIT_FAILURE;
+      continue;
+    }
+
+    auto Path = AOT::Cache::getPath(Data, Scope, Key);
+    if (!Path) {
+      Status = EXIT_FAILURE;
+      continue;
+    }
+    auto Res = AOT::Cache::publish(
+        *Path, [&](const std::filesystem::path &TmpPath) -> Expect<void> {
+          LLVM::Compiler Compiler(Conf);
+          LLVM::CodeGen CodeGen(Conf);
+          auto Compiled = Compiler.compile(*Module);
+          if (!Compiled) {
+            return Unexpect(Compiled);
+          }
+          return CodeGen.codegen(Data, std::move(*Compiled), TmpPath);
+        });
+    if (!Res) {
+      const auto Err = static_cast<uint32_t>(Res.error());
+      spdlog::error("Compilation of {} failed. Error code: {}", WasmName, Err);
+      Status = EXIT_FAILURE;
+      continue;
+    }
+    spdlog::info("Cached {} into {}", WasmName, Path->u8string());
+  }
+
+  if (Opt.SizeLimit.value() > 0) {
+    const auto Evicted = AOT::Cache::prune(Scope, Opt.SizeLimit.value());
+    spdlog::info("Evicted {} cached modules.", Evicted);
+  }
+
+  return Status;
+#else
+  spdlog::error("AOT cache is not supported!");
+
+  return EXIT_FAILURE;
+#endif
+}
+
+} // namespace Driver
+} // namespace WasmEdge
@@ -8,6 +8,7 @@
 #include "common/version.h"
 #include "driver/tool.h"
 #include "host/wasi/wasimodule.h"
+#include "system/allocator.h"
 #include "vm/vm.h"
 
 #include <chrono>
@@ -105,6 +106,10 @@ int Tool(struct DriverToolOptions &Opt) noexcept {
     Conf.getRuntimeConfigure().setMaxMemoryPage(
         static_cast<uint32_t>(Opt.MemLim.value().back()));
   }
+  if (Opt.CallDepthLim.value().size() > 0) {
+    Conf.getRuntimeConfigure().setMaxCallStackDepth(
+        static_cast<uint32_t>(Opt.CallDepthLim.value().back()));
+  }
   if (Opt.ConfEnableAllStatistics.value()) {
     Conf.getStatisticsConfigure().setInstructionCounting(true);
     Conf.getStatisticsConfigure().setCostMeasuring(true);
@@ -120,14 +125,52 @@ int Tool(struct DriverToolOptions &Opt) noexcept {
       Conf.getStatisticsConfigure().setTimeMeasuring(true);
     }
   }
+  if (Opt.ConfEnableBlockGasMeasuring.value()) {
+    Conf.getStatisticsConfigure().setCostMeasuring(true);
+    Conf.getStatisticsConfigure().setBlockCostMeasuring(true);
+  }
   if (Opt.ConfEnableJIT.value()) {
     Conf.getRuntimeConfigure().setEnableJIT(true);
     Conf.getCompilerConfigure().setOptimizationLevel(
         WasmEdge::CompilerConfigure::OptimizationLevel::O1);
   }
+  if (Opt.ConfEnableTieredJIT.value()) {
+    Conf.getRuntimeConfigure().setEnableTieredJIT(true);
+  }
+  if (Opt.TierUpThreshold.value().size() > 0) {
+    Conf.getRuntimeConfigure().setTierUpThreshold(
+        static_cast<uint32_t>(Opt.TierUpThreshold.value().back()));
+  }
+  if (Opt.ConfEnableAOTCache.value()) {
+    Conf.getRuntimeConfigure().setEnableAOTCache(true);
+  }
+  if (Opt.ConfEnableImageCache.value()) {
+    Conf.getRuntimeConfigure().setEnableImageCache(true);
+  }
+  if (Opt.AOTCacheSizeLimit.value() > 0) {
+    Conf.getRuntimeConfigure().setAOTCacheSizeLimit(
+        Opt.AOTCacheSizeLimit.value());
+  }
+  if (Opt.MemoryPoolSize.value() > 0) {
+    Allocator::set_pool_capacity(Opt.MemoryPoolSize.value());
+  }
+  Conf.getRuntimeConfigure().setLoadingJobs(Opt.LoadingJobs.value());
+  Conf.getRuntimeConfigure().setValidationJobs(Opt.ValidationJobs.value());
   if (Opt.ConfForceInterpreter.value()) {
     Conf.getRuntimeConfigure().setForceInterpreter(true);
   }
+  if (Opt.ConfThreadedInterpreter.value()) {
+    Conf.getRuntimeConfigure().setThreadedInterpreter(true);
+  }
+  if (Opt.ConfRegisterInterpreter.value()) {
+    Conf.getRuntimeConfigure().setRegisterInterpreter(true);
+  }
+  if (Opt.ConfLazyLoading.value()) {
+    Conf.getRuntimeConfigure().setLazyLoading(true);
+  }
+  if (Opt.ConfGuardPageBoundsCheck.value()) {
+    Conf.getRuntimeConfigure().setGuardPageBoundsCheck(true);
+  }
 
   for (const auto &Name : Opt.ForbiddenPlugins.value()) {
     Conf.addForbiddenPlugins(Name);
@@ -147,7 +190,19 @@ int Tool(struct DriverToolOptions &Opt) noexcept {
   if (auto Result = VM.validate(); !Result) {
     return EXIT_FAILURE;
   }
-  if (auto Result = VM.instantiate(); !Result) {
+  // The module instance is restored from the snapshot, which is taken after
+  // the `_initialize` function.
+  const bool HasSnapshot = !Opt.SnapshotName.value().empty();
+  if (HasSnapshot) {
+    auto Snap = Executor::Snapshot::load(std::filesystem::absolute(
+        std::filesystem::u8path(Opt.SnapshotName.value())));
+    if (!Snap) {
+      return EXIT_FAILURE;
+    }
+    if (auto Result = VM.instantiate(**Snap); !Result) {
+      return EXIT_FAILURE;
+    }
+  } else if (auto Result = VM.instantiate(); !Result) {
     return EXIT_FAILURE;
   }
 
@@ -216,7 +271,7 @@ int Tool(struct DriverToolOptions &Opt) noexcept {
 
     for (const auto &Func : VM.getFunctionList()) {
       if (Func.first == InitFunc) {
-        HasInit = true;
+        HasInit = !HasSnapshot;
       } else if (Func.first == FuncName) {
         FuncType = Func.second;
       }
@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "common/configure.h"
+#include "common/filesystem.h"
+#include "common/spdlog.h"
+#include "driver/snapshot.h"
+#include "host/wasi/wasimodule.h"
+#include "vm/vm.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace WasmEdge {
+namespace Driver {
+
+int Snapshot(struct DriverSnapshotOptions &Opt) noexcept {
+  using namespace std::literals;
+
+  std::ios::sync_with_stdio(false);
+  Log::setInfoLoggingLevel();
+
+  // The snapshot is taken with the default configuration, which is the same
+  // as the runtime tool instantiates the module with.
+  Configure Conf;
+  Conf.addHostRegistration(HostRegistration::Wasi);
+  const auto InputPath =
+      std::filesystem::absolute(std::filesystem::u8path(Opt.WasmName.value()));
+  const auto OutputPath = std::filesystem::absolute(
+      std::filesystem::u8path(Opt.SnapshotName.value()));
+  VM::VM VM(Conf);
+
+  Host::WasiModule *WasiMod = dynamic_cast<Host::WasiModule *>(
+      VM.getImportModule(HostRegistration::Wasi));
+  WasiMod->getEnv().init(
+      Opt.Dir.value(),
+      InputPath.filename()
+          .replace_extension(std::filesystem::u8path("wasm"sv))
+          .u8string(),
+      {}, Opt.Env.value());
+
+  if (auto Result = VM.loadWasm(InputPath); !Result) {
+    return EXIT_FAILURE;
+  }
+  if (auto Result = VM.validate(); !Result) {
+    return EXIT_FAILURE;
+  }
+  if (auto Result = VM.instantiate(); !Result) {
+    return EXIT_FAILURE;
+  }
+
+  const auto InitFunc = Opt.InitFunc.value().empty() ? "_initialize"s
+                                                     : Opt.InitFunc.value();
+  for (const auto &Func : VM.getFunctionList()) {
+    if (Func.first != InitFunc) {
+      continue;
+    }
+    auto Result = VM.execute(InitFunc);
+    if (!Result && Result.error() != ErrCode::Value::Terminated) {
+      const auto Err = static_cast<uint32_t>(Result.error());
+      spdlog::error("Initialize {} failed. Error code: {}"sv, InitFunc, Err);
+      return EXIT_FAILURE;
+    }
+    break;
+  }
+
+  if (auto Result = VM.saveSnapshot(OutputPath); !Result) {
+    const auto Err = static_cast<uint32_t>(Result.error());
+    spdlog::error("Save snapshot {} failed. Error code: {}"sv,
+                  OutputPath.u8string(), Err);
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+} // namespace Driver
+} // namespace WasmEdge
@@ -3,7 +3,9 @@
 
 #include "driver/unitool.h"
 #include "common/spdlog.h"
+#include "driver/cache.h"
 #include "driver/compiler.h"
+#include "driver/snapshot.h"
 #include "driver/tool.h"
 #include "po/argument_parser.h"
 
@@ -25,8 +27,14 @@ int UniTool(int Argc, const char *Argv[], const ToolType ToolSelect) noexcept {
       PO::Description("Wasmedge runtime tool subcommand"sv));
   PO::SubCommand CompilerSubCommand(
       PO::Description("Wasmedge compiler subcommand"sv));
+  PO::SubCommand CacheSubCommand(
+      PO::Description("Wasmedge AOT cache subcommand"sv));
+  PO::SubCommand SnapshotSubCommand(
+      PO::Description("Wasmedge snapshot subcommand"sv));
   struct DriverToolOptions ToolOptions;
   struct DriverCompilerOptions CompilerOptions;
+  struct DriverCacheOptions CacheOptions;
+  struct DriverSnapshotOptions SnapshotOptions;
 
   // Construct Parser Subcommands and Options
   if (ToolSelect == ToolType::All) {
@@ -39,6 +47,14 @@ int UniTool(int Argc, const char *Argv[], const ToolType ToolSelect) noexcept {
     Parser.begin_subcommand(ToolSubCommand, "run"sv);
     ToolOptions.add_option(Parser);
     Parser.end_subcommand();
+
+    Parser.begin_subcommand(CacheSubCommand, "cache"sv);
+    CacheOptions.add_option(Parser);
+    Parser.end_subcommand();
+
+    Parser.begin_subcommand(SnapshotSubCommand, "snapshot"sv);
+    SnapshotOptions.add_option(Parser);
+    Parser.end_subcommand();
   } else if (ToolSelect == ToolType::Tool) {
     ToolOptions.add_option(Parser);
   } else if (ToolSelect == ToolType::Compiler) {
@@ -72,6 +88,10 @@ int UniTool(int Argc, const char *Argv[], const ToolType ToolSelect) noexcept {
   } else if (CompilerSubCommand.is_selected() ||
              ToolSelect == ToolType::Compiler) {
     return Compiler(CompilerOptions);
+  } else if (CacheSubCommand.is_selected()) {
+    return Cache(CacheOptions);
+  } else if (SnapshotSubCommand.is_selected()) {
+    return Snapshot(SnapshotOptions);
   } else {
     return Tool(ToolOptions);
   }
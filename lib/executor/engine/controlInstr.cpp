@@ -251,6 +251,12 @@ Expect<void> Executor::runTryTableOp(Runtime::StackManager &StackMgr,
                                      const AST::Instruction &Instr,
                                      AST::InstrView::iterator &PC) noexcept {
   const auto &TryDesc = Instr.getTryCatch();
+  if (unlikely(StackMgr.isHandlerExhausted())) {
+    spdlog::error(ErrCode::Value::CallStackExhausted);
+    spdlog::error(
+        ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
+    return Unexpect(ErrCode::Value::CallStackExhausted);
+  }
   StackMgr.pushHandler(PC, TryDesc.BlockParamNum, TryDesc.Catch);
   return {};
 }
@@ -3,15 +3,190 @@
 
 #include "executor/executor.h"
 
+#include "experimental/scope.hpp"
+#include "system/fault.h"
+
+
 #include <array>
 #include <cstdint>
 #include <cstring>
+#include <utility>
+
+// The direct-threaded dispatch engine relies on the labels-as-values extension.
+#if defined(__GNUC__) || defined(__clang__)
+#define WASMEDGE_EXECUTOR_THREADED_DISPATCH 1
+#else
+#define WASMEDGE_EXECUTOR_THREADED_DISPATCH 0
+#endif
 
 namespace WasmEdge {
 namespace Executor {
 
+namespace {
+
+#if WASMEDGE_EXECUTOR_THREADED_DISPATCH
+/// Instructions which have their own handlers in the direct-threaded dispatch
+/// engine. The others are forwarded to the switch-based dispatcher.
+#define FOR_EACH_THREADED_OPCODE(F)                                            \
+  F(Nop)                                                                       \
+  F(Block)                                                                     \
+  F(Loop)                                                                      \
+  F(If)                                                                        \
+  F(End)                                                                       \
+  F(Br)                                                                        \
+  F(Br_if)                                                                     \
+  F(Br_table)                                                                  \
+  F(Return)                                                                    \
+  F(Call)                                                                      \
+  F(Call_indirect)                                                             \
+  F(Drop)                                                                      \
+  F(Select)                                                                    \
+  F(Local__get)                                                                \
+  F(Local__set)                                                                \
+  F(Local__tee)                                                                \
+  F(Global__get)                                                               \
+  F(Global__set)                                                               \
+  F(I32__load)                                                                 \
+  F(I64__load)                                                                 \
+  F(F32__load)                                                                 \
+  F(F64__load)                                                                 \
+  F(I32__load8_s)                                                              \
+  F(I32__load8_u)                                                              \
+  F(I32__load16_s)                                                             \
+  F(I32__load16_u)                                                             \
+  F(I64__load8_s)                                                              \
+  F(I64__load8_u)                                                              \
+  F(I64__load16_s)                                                             \
+  F(I64__load16_u)                                                             \
+  F(I64__load32_s)                                                             \
+  F(I64__load32_u)                                                             \
+  F(I32__store)                                                                \
+  F(I64__store)                                                                \
+  F(F32__store)                                                                \
+  F(F64__store)                                                                \
+  F(I32__store8)                                                               \
+  F(I32__store16)                                                              \
+  F(I64__store8)                                                               \
+  F(I64__store16)                                                              \
+  F(I64__store32)                                                              \
+  F(I32__const)                                                                \
+  F(I64__const)                                                                \
+  F(F32__const)                                                                \
+  F(F64__const)                                                                \
+  F(I32__eqz)                                                                  \
+  F(I32__eq)                                                                   \
+  F(I32__ne)                                                                   \
+  F(I32__lt_s)                                                                 \
+  F(I32__lt_u)                                                                 \
+  F(I32__gt_s)                                                                 \
+  F(I32__gt_u)                                                                 \
+  F(I32__le_s)                                                                 \
+  F(I32__le_u)                                                                 \
+  F(I32__ge_s)                                                                 \
+  F(I32__ge_u)                                                                 \
+  F(I64__eqz)                                                                  \
+  F(I64__eq)                                                                   \
+  F(I64__ne)                                                                   \
+  F(I64__lt_s)                                                                 \
+  F(I64__lt_u)                                                                 \
+  F(I64__gt_s)                                                                 \
+  F(I64__gt_u)                                                                 \
+  F(I64__le_s)                                                                 \
+  F(I64__le_u)                                                                 \
+  F(I64__ge_s)                                                                 \
+  F(I64__ge_u)                                                                 \
+  F(I32__add)                                                                  \
+  F(I32__sub)                                                                  \
+  F(I32__mul)                                                                  \
+  F(I32__div_s)                                                                \
+  F(I32__div_u)                                                                \
+  F(I32__rem_s)                                                                \
+  F(I32__rem_u)                                                                \
+  F(I32__and)                                                                  \
+  F(I32__or)                                                                   \
+  F(I32__xor)                                                                  \
+  F(I32__shl)                                                                  \
+  F(I32__shr_s)                                                                \
+  F(I32__shr_u)                                                                \
+  F(I64__add)                                                                  \
+  F(I64__sub)                                                                  \
+  F(I64__mul)                                                                  \
+  F(I64__div_s)                                                                \
+  F(I64__div_u)                                                                \
+  F(I64__rem_s)                                                                \
+  F(I64__rem_u)                                                                \
+  F(I64__and)                                                                  \
+  F(I64__or)                                                                   \
+  F(I64__xor)                                                                  \
+  F(I64__shl)                                                                  \
+  F(I64__shr_s)                                                                \
+  F(I64__shr_u)                                                                \
+  F(F32__add)                                                                  \
+  F(F32__sub)                                                                  \
+  F(F32__mul)                                                                  \
+  F(F32__div)                                                                  \
+  F(F64__add)                                                                  \
+  F(F64__sub)                                                                  \
+  F(F64__mul)                                                                  \
+  F(F64__div)                                                                  \
+  F(I32__wrap_i64)                                                             \
+  F(I64__extend_i32_s)                                                         \
+  F(I64__extend_i32_u)                                                         \
+  F(Reg__local_copy)                                                           \
+  F(Reg__binop_ll)                                                             \
+  F(Reg__binop_ll_set)                                                         \
+  F(Reg__binop_lc)                                                             \
+  F(Reg__binop_lc_set)                                                         \
+  F(Reg__binop_sl)                                                             \
+  F(Reg__binop_set)                                                            \
+  F(Fused__local_get_local_get_i32_add)                                        \
+  F(Fused__i32_const_i32_add)                                                  \
+  F(Fused__local_get_i32_load)                                                 \
+  F(Fused__i32_eqz_br_if)
+
+/// Count of the instruction opcodes.
+constexpr uint32_t OpCodeNum = 0
+#define UseOpCode
+#define Line(NAME, STRING, PREFIX) +1
+#define Line_FB(NAME, STRING, PREFIX, EXTEND) +1
+#define Line_FC(NAME, STRING, PREFIX, EXTEND) +1
+#define Line_FD(NAME, STRING, PREFIX, EXTEND) +1
+#define Line_FE(NAME, STRING, PREFIX, EXTEND) +1
+#include "common/enum.inc"
+#undef Line
+#undef Line_FB
+#undef Line_FC
+#undef Line_FD
+#undef Line_FE
+#undef UseOpCode
+#define UseInternalOpCode
+#define Line(NAME, STRING) +1
+#include "common/enum.inc"
+#undef Line
+#undef UseInternalOpCode
+    ;
+
+/// Opcode to threaded handler index mapping. Index 0 is the generic handler.
+constexpr auto ThreadedHandlerIndex = []() constexpr {
+  std::array<uint8_t, OpCodeNum> Index{};
+  uint8_t Cnt = 0;
+#define HANDLER_INDEX(NAME) Index[static_cast<uint32_t>(OpCode::NAME)] = ++Cnt;
+  FOR_EACH_THREADED_OPCODE(HANDLER_INDEX)
+#undef HANDLER_INDEX
+  return Index;
+}();
+#endif
+
+} // namespace
+
 Expect<void> Executor::runExpression(Runtime::StackManager &StackMgr,
                                      AST::InstrView Instrs) {
+  // Every instruction in a constant expression pushes at most one value.
+  if (unlikely(StackMgr.isExhausted(static_cast<uint32_t>(Instrs.size()),
+                                    true))) {
+    spdlog::error(ErrCode::Value::CallStackExhausted);
+    return Unexpect(ErrCode::Value::CallStackExhausted);
+  }
   return execute(StackMgr, Instrs.begin(), Instrs.end());
 }
 
@@ -24,6 +199,13 @@ Executor::runFunction(Runtime::StackManager &StackMgr,
     Stat->startRecordWasm();
   }
 
+  // Check the stack capacity for the dummy frame and the arguments.
+  if (unlikely(
+          StackMgr.isExhausted(static_cast<uint32_t>(Params.size())))) {
+    spdlog::error(ErrCode::Value::CallStackExhausted);
+    return Unexpect(ErrCode::Value::CallStackExhausted);
+  }
+
   // Reset and push a dummy frame into stack.
   StackMgr.pushFrame(nullptr, AST::InstrView::iterator(), 0, 0);
 
@@ -42,6 +224,14 @@ Executor::runFunction(Runtime::StackManager &StackMgr,
     }
   }
 
+  // Load the function body first in the lazy loading mode, because the end of
+  // the instructions is the return position of the entered function.
+  if (unlikely(Func.isLazyFunction())) {
+    if (auto Res = loadLazyFunction(Func); !Res) {
+      return Unexpect(Res);
+    }
+  }
+
   // Enter and execute function.
   AST::InstrView::iterator StartIt = {};
   Expect<void> Res = {};
@@ -87,12 +277,31 @@ Executor::runFunction(Runtime::StackManager &StackMgr,
   return Unexpect(Res);
 }
 
+template <bool IsCounting, bool IsMeasuring, bool IsBlockMeasuring,
+          bool IsGuarded>
 Expect<void> Executor::execute(Runtime::StackManager &StackMgr,
                                const AST::InstrView::iterator Start,
                                const AST::InstrView::iterator End) {
   AST::InstrView::iterator PC = Start;
   AST::InstrView::iterator PCEnd = End;
 
+  // The cost of the current basic block which is not charged yet.
+  uint64_t PendingCost = 0;
+  cxx20::scope_exit PendingCostHolder([this, &PC, &PendingCost,
+                                      &StackMgr]() noexcept {
+    if constexpr (IsBlockMeasuring) {
+      // Only a trap in the middle of a basic block leaves the pending cost.
+      // Charge the instructions until the trapping one, which is the same as
+      // the cost measured per instruction.
+      if (PendingCost > 0) {
+        if (!(PC + 1)->isMeterLeader()) {
+          PendingCost -= StackMgr.getFunction()->getMeterCost(PC + 1);
+        }
+        Stat->addCost(PendingCost);
+      }
+    }
+  });
+
   auto Dispatch = [this, &PC, &StackMgr]() -> Expect<void> {
     const AST::Instruction &Instr = *PC;
 
@@ -121,7 +330,7 @@ Expect<void> Executor::execute(Runtime::StackManager &StackMgr,
     case OpCode::If:
       return runIfElseOp(StackMgr, Instr, PC);
     case OpCode::Else:
-      if (Stat && Conf.getStatisticsConfigure().isCostMeasuring()) {
+      if constexpr (IsMeasuring) {
         // Reach here means end of if-statement.
         if (unlikely(!Stat->subInstrCost(Instr.getOpCode()))) {
           spdlog::error(ErrCode::Value::CostLimitExceeded);
@@ -364,73 +573,73 @@ Expect<void> Executor::execute(Runtime::StackManager &StackMgr,
 
     // Memory Instructions
     case OpCode::I32__load:
-      return runLoadOp<uint32_t>(
+      return runLoadOp<uint32_t, 32, IsGuarded>(
           StackMgr, *getMemInstByIdx(StackMgr, Instr.getTargetIndex()), Instr);
     case OpCode::I64__load:
-      return runLoadOp<uint64_t>(
+      return runLoadOp<uint64_t, 64, IsGuarded>(
           StackMgr, *getMemInstByIdx(StackMgr, Instr.getTargetIndex()), Instr);
     case OpCode::F32__load:
-      return runLoadOp<float>(
+      return runLoadOp<float, 32, IsGuarded>(
           StackMgr, *getMemInstByIdx(StackMgr, Instr.getTargetIndex()), Instr);
     case OpCode::F64__load:
-      return runLoadOp<double>(
+      return runLoadOp<double, 64, IsGuarded>(
           StackMgr, *getMemInstByIdx(StackMgr, Instr.getTargetIndex()), Instr);
     case OpCode::I32__load8_s:
-      return runLoadOp<int32_t, 8>(
+      return runLoadOp<int32_t, 8, IsGuarded>(
           StackMgr, *getMemInstByIdx(StackMgr, Instr.getTargetIndex()), Instr);
     case OpCode::I32__load8_u:
-      return runLoadOp<uint32_t, 8>(
+      return runLoadOp<uint32_t, 8, IsGuarded>(
           StackMgr, *getMemInstByIdx(StackMgr, Instr.getTargetIndex()), Instr);
     case OpCode::I32__load16_s:
-      return runLoadOp<int32_t, 16>(
+      return runLoadOp<int32_t, 16, IsGuarded>(
           StackMgr, *getMemInstByIdx(StackMgr, Instr.getTargetIndex()), Instr);
     case OpCode::I32__load16_u:
-      return runLoadOp<uint32_t, 16>(
+      return runLoadOp<uint32_t, 16, IsGuarded>(
           StackMgr, *getMemInstByIdx(StackMgr, Instr.getTargetIndex()), Instr);
     case OpCode::I64__load8_s:
-      return runLoadOp<int64_t, 8>(
+      return runLoadOp<int64_t, 8, IsGuarded>(
           StackMgr, *getMemInstByIdx(StackMgr, Instr.getTargetIndex()), Instr);
     case OpCode::I64__load8_u:
-      return runLoadOp<uint64_t, 8>(
+      return runLoadOp<uint64_t, 8, IsGuarded>(
           StackMgr, *getMemInstByIdx(StackMgr, Instr.getTargetIndex()), Instr);
     case OpCode::I64__load16_s:
-      return runLoadOp<int64_t, 16>(
+      return runLoadOp<int64_t, 16, IsGuarded>(
           StackMgr, *getMemInstByIdx(StackMgr, Instr.getTargetIndex()), Instr);
     case OpCode::I64__load16_u:
-      return runLoadOp<uint64_t, 16>(
+      return runLoadOp<uint64_t, 16, IsGuarded>(
           StackMgr, *getMemInstByIdx(StackMgr, Instr.getTargetIndex()), Instr);
     case OpCode::I64__load32_s:
-      return runLoadOp<int64_t, 32>(
+      return runLoadOp<int64_t, 32, IsGuarded>(
           StackMgr, *getMemInstByIdx(StackMgr, Instr.getTargetIndex()), Instr);
     case OpCode::I64__load32_u:
-      return runLoadOp<uint64_t, 32>(
+      return runLoadOp<uint64_t, 32, IsGuarded>(
           StackMgr, *getMemInstByIdx(StackMgr, Instr.getTargetIndex()), Instr);
     case OpCode::I32__store:
-      return runStoreOp<uint32_t>(
+      return runStoreOp<uint32_t, 32, IsGuarded>(
           StackMgr, *getMemInstByIdx(StackMgr, Instr.getTargetIndex()), Instr);
     case OpCode::I64__store:
-      return runStoreOp<uint64_t>(
+      return runStoreOp<uint64_t, 64, IsGuarded>(
           StackMgr, *getMemInstByIdx(StackMgr, Instr.getTargetIndex()), Instr);
     case OpCode::F32__store:
-      return runStoreOp<float>(
+      return runStoreOp<float, 32, IsGuarded>(
           StackMgr, *getMemInstByIdx(StackMgr, Instr.getTargetIndex()), Instr);
     case OpCode::F64__store:
-      return runStoreOp<double>(
+      return runStoreOp<double, 64, IsGuarded>(
           StackMgr, *getMemInstByIdx(StackMgr, Instr.getTargetIndex()), Instr);
     case OpCode::I32__store8:
-      return runStoreOp<uint32_t, 8>(
+      return runStoreOp<uint32_t, 8, IsGuarded>(
           StackMgr, *getMemInstByIdx(StackMgr, Instr.getTargetIndex()), Instr);
     case OpCode::I32__store16:
-      return runStoreOp<uint32_t, 16>(
+      return runStoreOp<uint32_t, 16, IsGuarded>(
           StackMgr, *getMemInstByIdx(StackMgr, Instr.getTargetIndex()), Instr);
     case OpCode::I64__store8:
-      return runStoreOp<uint64_t, 8>(
+      return runStoreOp<uint64_t, 8, IsGuarded>(
           StackMgr, *getMemInstByIdx(StackMgr, Instr.getTargetIndex()), Instr);
     case OpCode::I64__store16:
-      return runStoreOp<uint64_t, 16>(
+      return runStoreOp<uint64_t, 16, IsGuarded>(
           StackMgr, *getMemInstByIdx(StackMgr, Instr.getTargetIndex()), Instr);
     case OpCode::I64__store32:
-      return runStoreOp<uint64_t, 32>(
+      return runStoreOp<uint64_t, 32, IsGuarded>(
           StackMgr, *getMemInstByIdx(StackMgr, Instr.getTargetIndex()), Instr);
     case OpCode::Memory__grow:
       return runMemoryGrowOp(
@@ -2029,26 +2238,335 @@ Expect<void> Executor::execute(Runtime::StackManager &StackMgr,
       return runAtomicCompareExchangeOp<uint64_t, uint32_t>(
           StackMgr, *getMemInstByIdx(StackMgr, Instr.getTargetIndex()), Instr);
 
+    // Register-based instructions.
+    case OpCode::Reg__local_copy:
+      return runRegLocalCopyOp(StackMgr, PC);
+    case OpCode::Reg__binop_ll:
+      return runRegBinaryOp<OpCode::Reg__binop_ll>(StackMgr, PC);
+    case OpCode::Reg__binop_ll_set:
+      return runRegBinaryOp<OpCode::Reg__binop_ll_set>(StackMgr, PC);
+    case OpCode::Reg__binop_lc:
+      return runRegBinaryOp<OpCode::Reg__binop_lc>(StackMgr, PC);
+    case OpCode::Reg__binop_lc_set:
+      return runRegBinaryOp<OpCode::Reg__binop_lc_set>(StackMgr, PC);
+    case OpCode::Reg__binop_sl:
+      return runRegBinaryOp<OpCode::Reg__binop_sl>(StackMgr, PC);
+    case OpCode::Reg__binop_set:
+      return runRegBinaryOp<OpCode::Reg__binop_set>(StackMgr, PC);
+
+    // Superinstructions.
+    case OpCode::Fused__local_get_local_get_i32_add:
+      return runFusedOp<OpCode::Fused__local_get_local_get_i32_add>(StackMgr,
+                                                                    PC);
+    case OpCode::Fused__i32_const_i32_add:
+      return runFusedOp<OpCode::Fused__i32_const_i32_add>(StackMgr, PC);
+    case OpCode::Fused__local_get_i32_load:
+      return runFusedOp<OpCode::Fused__local_get_i32_load, IsGuarded>(StackMgr,
+                                                                      PC);
+    case OpCode::Fused__i32_eqz_br_if:
+      return runFusedOp<OpCode::Fused__i32_eqz_br_if>(StackMgr, PC);
+
     default:
       return {};
     }
   };
 
-  while (PC != PCEnd) {
-    if (Stat) {
-      OpCode Code = PC->getOpCode();
-      if (Conf.getStatisticsConfigure().isInstructionCounting()) {
-        Stat->incInstrCount();
-      }
-      // Add cost. Note: if-else case should be processed additionally.
-      if (Conf.getStatisticsConfigure().isCostMeasuring()) {
-        if (unlikely(!Stat->addInstrCost(Code))) {
-          const AST::Instruction &Instr = *PC;
-          spdlog::error(
-              ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
-          return Unexpect(ErrCode::Value::CostLimitExceeded);
+  auto Metering = [this, &PC, &PendingCost, &StackMgr]() -> Expect<void> {
+    if constexpr (IsCounting) {
+      Stat->incInstrCount();
+    }
+    // Add cost. Note: if-else case should be processed additionally.
+    if constexpr (IsBlockMeasuring) {
+      // The cost of a basic block is added when entering it, and charged at
+      // the control instructions which end the basic blocks. The costs are in
+      // the side table of the function of the current frame.
+      const AST::Instruction &Instr = *PC;
+      if (Instr.isMeterLeader()) {
+        const uint32_t BlockCost = StackMgr.getFunction()->getMeterCost(PC);
+        if (Instr.isMeterSync()) {
+          uint64_t Cost = BlockCost;
+          if (unlikely(Cost == UINT32_MAX)) {
+            Cost = Stat->getCostTable()[uint16_t(Instr.getOpCode())];
+          }
+          Cost += std::exchange(PendingCost, 0);
+          if (unlikely(!Stat->addCost(Cost))) {
+            spdlog::error(
+                ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
+            return Unexpect(ErrCode::Value::CostLimitExceeded);
+          }
+        } else {
+          PendingCost += BlockCost;
         }
       }
+    } else if constexpr (IsMeasuring) {
+      if (unlikely(!Stat->addInstrCost(PC->getOpCode()))) {
+        const AST::Instruction &Instr = *PC;
+        spdlog::error(
+            ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
+        return Unexpect(ErrCode::Value::CostLimitExceeded);
+      }
+    }
+    return {};
+  };
+
+#if WASMEDGE_EXECUTOR_THREADED_DISPATCH
+  if (Conf.getRuntimeConfigure().isThreadedInterpreter()) {
+    // Direct-threaded dispatch: every handler ends with its own indirect jump
+    // to the handler of the next instruction. The handlers below must behave
+    // exactly the same as the corresponding cases in `Dispatch`.
+    static const void *const Handlers[] = {
+        &&Threaded_Generic,
+#define HANDLER_ADDR(NAME) &&Threaded_##NAME,
+        FOR_EACH_THREADED_OPCODE(HANDLER_ADDR)
+#undef HANDLER_ADDR
+    };
+
+#define THREADED_DISPATCH()                                                    \
+  do {                                                                         \
+    if (unlikely(PC == PCEnd)) {                                               \
+      return {};                                                               \
+    }                                                                          \
+    if constexpr (IsCounting || IsMeasuring) {                                 \
+      if (auto Res = Metering(); unlikely(!Res)) {                             \
+        return Unexpect(Res);                                                  \
+      }                                                                        \
+    }                                                                          \
+    goto *Handlers[ThreadedHandlerIndex[static_cast<uint32_t>(                 \
+        PC->getOpCode())]];                                                    \
+  } while (false)
+#define THREADED_NEXT()                                                        \
+  do {                                                                         \
+    PC++;                                                                      \
+    THREADED_DISPATCH();                                                       \
+  } while (false)
+#define THREADED_RUN(...)                                                      \
+  do {                                                                         \
+    if (auto Res = (__VA_ARGS__); unlikely(!Res)) {                            \
+      return Unexpect(Res);                                                    \
+    }                                                                          \
+    THREADED_NEXT();                                                           \
+  } while (false)
+// The handlers which raise the traps out of band return no errors in the
+// variants without statistics.
+#define THREADED_RUN_RAISING(...)                                              \
+  do {                                                                         \
+    if constexpr (IsCounting || IsMeasuring) {                                 \
+      THREADED_RUN(__VA_ARGS__);                                               \
+    } else {                                                                   \
+      static_cast<void>(__VA_ARGS__);                                          \
+      THREADED_NEXT();                                                         \
+    }                                                                          \
+  } while (false)
+#define THREADED_UNARY(NAME, FUNC, ...)                                        \
+  Threaded_##NAME : THREADED_RUN(FUNC<__VA_ARGS__>(StackMgr.getTop()));
+#define THREADED_BINARY(NAME, FUNC, T)                                         \
+  Threaded_##NAME : {                                                          \
+    ValVariant Rhs = StackMgr.pop();                                           \
+    THREADED_RUN(FUNC<T>(StackMgr.getTop(), Rhs));                             \
+  }
+#define THREADED_BINARY_TRAP(NAME, FUNC, T)                                    \
+  Threaded_##NAME : {                                                          \
+    ValVariant Rhs = StackMgr.pop();                                           \
+    THREADED_RUN_RAISING(FUNC<T>(*PC, StackMgr.getTop(), Rhs));                \
+  }
+#define THREADED_LOAD(NAME, ...)                                               \
+  Threaded_##NAME : THREADED_RUN_RAISING(runLoadOp<__VA_ARGS__, IsGuarded>(    \
+      StackMgr, *getMemInstByIdx(StackMgr, PC->getTargetIndex()), *PC));
+#define THREADED_STORE(NAME, ...)                                              \
+  Threaded_##NAME : THREADED_RUN_RAISING(runStoreOp<__VA_ARGS__, IsGuarded>(   \
+      StackMgr, *getMemInstByIdx(StackMgr, PC->getTargetIndex()), *PC));
+#define THREADED_REG_BINARY(NAME)                                              \
+  Threaded_##NAME : THREADED_RUN_RAISING(                                      \
+      runRegBinaryOp<OpCode::NAME>(StackMgr, PC));
+#define THREADED_FUSED(NAME)                                                   \
+  Threaded_##NAME : THREADED_RUN(                                              \
+      runFusedOp<OpCode::NAME, IsGuarded>(StackMgr, PC));
+
+    THREADED_DISPATCH();
+
+  Threaded_Generic:
+    THREADED_RUN(Dispatch());
+
+    // Control instructions.
+  Threaded_Nop:
+  Threaded_Block:
+  Threaded_Loop:
+    THREADED_NEXT();
+  Threaded_If:
+    THREADED_RUN(runIfElseOp(StackMgr, *PC, PC));
+  Threaded_End:
+    PC = StackMgr.maybePopFrameOrHandler(PC);
+    THREADED_NEXT();
+  Threaded_Br:
+    THREADED_RUN(runBrOp(StackMgr, *PC, PC));
+  Threaded_Br_if:
+    THREADED_RUN(runBrIfOp(StackMgr, *PC, PC));
+  Threaded_Br_table:
+    THREADED_RUN(runBrTableOp(StackMgr, *PC, PC));
+  Threaded_Return:
+    THREADED_RUN(runReturnOp(StackMgr, PC));
+  Threaded_Call:
+    THREADED_RUN(runCallOp(StackMgr, *PC, PC));
+  Threaded_Call_indirect:
+    THREADED_RUN(runCallIndirectOp(StackMgr, *PC, PC));
+
+    // Parametric instructions.
+  Threaded_Drop:
+    StackMgr.pop();
+    THREADED_NEXT();
+  Threaded_Select : {
+    ValVariant CondVal = StackMgr.pop();
+    ValVariant Val2 = StackMgr.pop();
+    ValVariant Val1 = StackMgr.pop();
+    if (CondVal.get<uint32_t>() == 0) {
+      StackMgr.push(Val2);
+    } else {
+      StackMgr.push(Val1);
+    }
+    THREADED_NEXT();
+  }
+
+    // Variable instructions.
+  Threaded_Local__get:
+    THREADED_RUN(runLocalGetOp(StackMgr, PC->getStackOffset()));
+  Threaded_Local__set:
+    THREADED_RUN(runLocalSetOp(StackMgr, PC->getStackOffset()));
+  Threaded_Local__tee:
+    THREADED_RUN(runLocalTeeOp(StackMgr, PC->getStackOffset()));
+  Threaded_Global__get:
+    THREADED_RUN(runGlobalGetOp(StackMgr, PC->getTargetIndex()));
+  Threaded_Global__set:
+    THREADED_RUN(runGlobalSetOp(StackMgr, PC->getTargetIndex()));
+
+    // Memory instructions.
+    THREADED_LOAD(I32__load, uint32_t, 32)
+    THREADED_LOAD(I64__load, uint64_t, 64)
+    THREADED_LOAD(F32__load, float, 32)
+    THREADED_LOAD(F64__load, double, 64)
+    THREADED_LOAD(I32__load8_s, int32_t, 8)
+    THREADED_LOAD(I32__load8_u, uint32_t, 8)
+    THREADED_LOAD(I32__load16_s, int32_t, 16)
+    THREADED_LOAD(I32__load16_u, uint32_t, 16)
+    THREADED_LOAD(I64__load8_s, int64_t, 8)
+    THREADED_LOAD(I64__load8_u, uint64_t, 8)
+    THREADED_LOAD(I64__load16_s, int64_t, 16)
+    THREADED_LOAD(I64__load16_u, uint64_t, 16)
+    THREADED_LOAD(I64__load32_s, int64_t, 32)
+    THREADED_LOAD(I64__load32_u, uint64_t, 32)
+    THREADED_STORE(I32__store, uint32_t, 32)
+    THREADED_STORE(I64__store, uint64_t, 64)
+    THREADED_STORE(F32__store, float, 32)
+    THREADED_STORE(F64__store, double, 64)
+    THREADED_STORE(I32__store8, uint32_t, 8)
+    THREADED_STORE(I32__store16, uint32_t, 16)
+    THREADED_STORE(I64__store8, uint64_t, 8)
+    THREADED_STORE(I64__store16, uint64_t, 16)
+    THREADED_STORE(I64__store32, uint64_t, 32)
+
+    // Const numeric instructions.
+  Threaded_I32__const:
+  Threaded_I64__const:
+  Threaded_F32__const:
+  Threaded_F64__const:
+    StackMgr.push(PC->getNum());
+    THREADED_NEXT();
+
+    // Numeric instructions.
+    THREADED_UNARY(I32__eqz, runEqzOp, uint32_t)
+    THREADED_BINARY(I32__eq, runEqOp, uint32_t)
+    THREADED_BINARY(I32__ne, runNeOp, uint32_t)
+    THREADED_BINARY(I32__lt_s, runLtOp, int32_t)
+    THREADED_BINARY(I32__lt_u, runLtOp, uint32_t)
+    THREADED_BINARY(I32__gt_s, runGtOp, int32_t)
+    THREADED_BINARY(I32__gt_u, runGtOp, uint32_t)
+    THREADED_BINARY(I32__le_s, runLeOp, int32_t)
+    THREADED_BINARY(I32__le_u, runLeOp, uint32_t)
+    THREADED_BINARY(I32__ge_s, runGeOp, int32_t)
+    THREADED_BINARY(I32__ge_u, runGeOp, uint32_t)
+    THREADED_UNARY(I64__eqz, runEqzOp, uint64_t)
+    THREADED_BINARY(I64__eq, runEqOp, uint64_t)
+    THREADED_BINARY(I64__ne, runNeOp, uint64_t)
+    THREADED_BINARY(I64__lt_s, runLtOp, int64_t)
+    THREADED_BINARY(I64__lt_u, runLtOp, uint64_t)
+    THREADED_BINARY(I64__gt_s, runGtOp, int64_t)
+    THREADED_BINARY(I64__gt_u, runGtOp, uint64_t)
+    THREADED_BINARY(I64__le_s, runLeOp, int64_t)
+    THREADED_BINARY(I64__le_u, runLeOp, uint64_t)
+    THREADED_BINARY(I64__ge_s, runGeOp, int64_t)
+    THREADED_BINARY(I64__ge_u, runGeOp, uint64_t)
+    THREADED_BINARY(I32__add, runAddOp, uint32_t)
+    THREADED_BINARY(I32__sub, runSubOp, uint32_t)
+    THREADED_BINARY(I32__mul, runMulOp, uint32_t)
+    THREADED_BINARY_TRAP(I32__div_s, runDivOp, int32_t)
+    THREADED_BINARY_TRAP(I32__div_u, runDivOp, uint32_t)
+    THREADED_BINARY_TRAP(I32__rem_s, runRemOp, int32_t)
+    THREADED_BINARY_TRAP(I32__rem_u, runRemOp, uint32_t)
+    THREADED_BINARY(I32__and, runAndOp, uint32_t)
+    THREADED_BINARY(I32__or, runOrOp, uint32_t)
+    THREADED_BINARY(I32__xor, runXorOp, uint32_t)
+    THREADED_BINARY(I32__shl, runShlOp, uint32_t)
+    THREADED_BINARY(I32__shr_s, runShrOp, int32_t)
+    THREADED_BINARY(I32__shr_u, runShrOp, uint32_t)
+    THREADED_BINARY(I64__add, runAddOp, uint64_t)
+    THREADED_BINARY(I64__sub, runSubOp, uint64_t)
+    THREADED_BINARY(I64__mul, runMulOp, uint64_t)
+    THREADED_BINARY_TRAP(I64__div_s, runDivOp, int64_t)
+    THREADED_BINARY_TRAP(I64__div_u, runDivOp, uint64_t)
+    THREADED_BINARY_TRAP(I64__rem_s, runRemOp, int64_t)
+    THREADED_BINARY_TRAP(I64__rem_u, runRemOp, uint64_t)
+    THREADED_BINARY(I64__and, runAndOp, uint64_t)
+    THREADED_BINARY(I64__or, runOrOp, uint64_t)
+    THREADED_BINARY(I64__xor, runXorOp, uint64_t)
+    THREADED_BINARY(I64__shl, runShlOp, uint64_t)
+    THREADED_BINARY(I64__shr_s, runShrOp, int64_t)
+    THREADED_BINARY(I64__shr_u, runShrOp, uint64_t)
+    THREADED_BINARY(F32__add, runAddOp, float)
+    THREADED_BINARY(F32__sub, runSubOp, float)
+    THREADED_BINARY(F32__mul, runMulOp, float)
+    THREADED_BINARY_TRAP(F32__div, runDivOp, float)
+    THREADED_BINARY(F64__add, runAddOp, double)
+    THREADED_BINARY(F64__sub, runSubOp, double)
+    THREADED_BINARY(F64__mul, runMulOp, double)
+    THREADED_BINARY_TRAP(F64__div, runDivOp, double)
+    THREADED_UNARY(I32__wrap_i64, runWrapOp, uint64_t, uint32_t)
+    THREADED_UNARY(I64__extend_i32_s, runExtendOp, int32_t, uint64_t)
+    THREADED_UNARY(I64__extend_i32_u, runExtendOp, uint32_t, uint64_t)
+
+    // Register-based instructions.
+  Threaded_Reg__local_copy:
+    THREADED_RUN(runRegLocalCopyOp(StackMgr, PC));
+    THREADED_REG_BINARY(Reg__binop_ll)
+    THREADED_REG_BINARY(Reg__binop_ll_set)
+    THREADED_REG_BINARY(Reg__binop_lc)
+    THREADED_REG_BINARY(Reg__binop_lc_set)
+    THREADED_REG_BINARY(Reg__binop_sl)
+    THREADED_REG_BINARY(Reg__binop_set)
+
+    // Superinstructions.
+    THREADED_FUSED(Fused__local_get_local_get_i32_add)
+    THREADED_FUSED(Fused__i32_const_i32_add)
+    THREADED_FUSED(Fused__local_get_i32_load)
+    THREADED_FUSED(Fused__i32_eqz_br_if)
+
+#undef THREADED_FUSED
+#undef THREADED_REG_BINARY
+#undef THREADED_STORE
+#undef THREADED_LOAD
+#undef THREADED_BINARY_TRAP
+#undef THREADED_BINARY
+#undef THREADED_UNARY
+#undef THREADED_RUN_RAISING
+#undef THREADED_RUN
+#undef THREADED_NEXT
+#undef THREADED_DISPATCH
+  }
+#endif
+
+  while (PC != PCEnd) {
+    if constexpr (IsCounting || IsMeasuring) {
+      if (auto Res = Metering(); !Res) {
+        return Unexpect(Res);
+      }
     }
     if (auto Res = Dispatch(); !Res) {
       return Unexpect(Res);
@@ -2058,5 +2576,64 @@ Expect<void> Executor::execute(Runtime::StackManager &StackMgr,
   return {};
 }
 
+Expect<void> Executor::execute(Runtime::StackManager &StackMgr,
+                               const AST::InstrView::iterator Start,
+                               const AST::InstrView::iterator End) {
+  // Choose the statistics variant of the execution loop once here, so the
+  // loop will not check the statistics configurations for every instruction.
+  const bool IsCounting =
+      Stat && Conf.getStatisticsConfigure().isInstructionCounting();
+  const bool IsMeasuring =
+      Stat && Conf.getStatisticsConfigure().isCostMeasuring();
+  // The basic block costs are only prepared for the function bodies when
+  // instantiation. The expressions for initialization are metered per
+  // instruction.
+  const bool IsBlockMeasuring =
+      IsMeasuring && Conf.getStatisticsConfigure().isBlockCostMeasuring() &&
+      Start != End && Start->isMeterLeader();
+  if (IsCounting || IsMeasuring) {
+    // The statistics variants return the traps from the handlers, so the
+    // counters stop exactly at the trapping instruction.
+    const bool PrevTrapByFault = std::exchange(IsTrapByFault, false);
+    cxx20::scope_exit RestoreTrapByFault(
+        [PrevTrapByFault]() noexcept { IsTrapByFault = PrevTrapByFault; });
+    if (IsCounting && IsBlockMeasuring) {
+      return execute<true, true, true, false>(StackMgr, Start, End);
+    } else if (IsBlockMeasuring) {
+      return execute<false, true, true, false>(StackMgr, Start, End);
+    } else if (IsCounting && IsMeasuring) {
+      return execute<true, true, false, false>(StackMgr, Start, End);
+    } else if (IsCounting) {
+      return execute<true, false, false, false>(StackMgr, Start, End);
+    } else {
+      return execute<false, true, false, false>(StackMgr, Start, End);
+    }
+  }
+
+  // The variants without statistics take the traps out of band. The trapping
+  // handlers jump to the fault handler here directly, so the loop needs not
+  // check their results. With the guard page bounds checking, the
+  // out-of-bounds loads and stores hit the guard region after the memory, and
+  // the signal handler jumps back here as well.
+  const bool IsGuarded = Conf.getRuntimeConfigure().isGuardPageBoundsCheck() &&
+                         Allocator::has_guard_region();
+  const bool PrevTrapByFault = std::exchange(IsTrapByFault, true);
+  cxx20::scope_exit RestoreTrapByFault(
+      [PrevTrapByFault]() noexcept { IsTrapByFault = PrevTrapByFault; });
+  Fault FaultHandler(IsGuarded);
+  if (uint32_t Code = PREPARE_FAULT(FaultHandler); Code != 0) {
+    ErrCode Err(static_cast<ErrCategory>(Code >> 24), Code);
+    // The faults of the guard region are not logged yet.
+    if (!std::exchange(IsTrapLogged, false)) {
+      spdlog::error(Err);
+    }
+    return Unexpect(Err);
+  }
+  if (IsGuarded) {
+    return execute<false, false, false, true>(StackMgr, Start, End);
+  }
+  return execute<false, false, false, false>(StackMgr, Start, End);
+}
+
 } // namespace Executor
 } // namespace WasmEdge
@@ -12,6 +12,8 @@ namespace Executor {
 thread_local Executor *Executor::This = nullptr;
 thread_local Runtime::StackManager *Executor::CurrentStack = nullptr;
 thread_local Executor::ExecutionContextStruct Executor::ExecutionContext;
+thread_local bool Executor::IsTrapByFault = false;
+thread_local bool Executor::IsTrapLogged = false;
 
 template <typename RetT, typename... ArgsT>
 struct Executor::ProxyHelper<Expect<RetT> (Executor::*)(Runtime::StackManager &,
@@ -101,6 +103,11 @@ Expect<void> Executor::call(Runtime::StackManager &StackMgr,
     StackMgr.push(Args[I]);
   }
 
+  if (unlikely(FuncInst->isLazyFunction())) {
+    if (auto Res = loadLazyFunction(*FuncInst); !Res) {
+      return Unexpect(Res);
+    }
+  }
   auto Instrs = FuncInst->getInstrs();
   AST::InstrView::iterator StartIt;
   if (auto Res = enterFunction(StackMgr, *FuncInst, Instrs.end())) {
@@ -212,6 +219,11 @@ Executor::callIndirect(Runtime::StackManager &StackMgr, const uint32_t TableIdx,
     StackMgr.push(Args[I]);
   }
 
+  if (unlikely(FuncInst->isLazyFunction())) {
+    if (auto Res = loadLazyFunction(*FuncInst); !Res) {
+      return Unexpect(Res);
+    }
+  }
   auto Instrs = FuncInst->getInstrs();
   AST::InstrView::iterator StartIt;
   if (auto Res = enterFunction(StackMgr, *FuncInst, Instrs.end())) {
@@ -466,6 +478,11 @@ Expect<void> Executor::callRef(Runtime::StackManager &StackMgr,
     StackMgr.push(Args[I]);
   }
 
+  if (unlikely(FuncInst->isLazyFunction())) {
+    if (auto Res = loadLazyFunction(*FuncInst); !Res) {
+      return Unexpect(Res);
+    }
+  }
   auto Instrs = FuncInst->getInstrs();
   AST::InstrView::iterator StartIt;
   if (auto Res = enterFunction(StackMgr, *FuncInst, Instrs.end())) {
@@ -6,6 +6,8 @@
 #include "common/errinfo.h"
 #include "common/spdlog.h"
 
+#include <algorithm>
+
 namespace WasmEdge {
 namespace Executor {
 
@@ -43,6 +45,21 @@ Executor::registerModule(Runtime::StoreManager &StoreMgr,
   }
 }
 
+/// Instantiate a WASM Module from the snapshot. See
+/// "include/executor/executor.h".
+Expect<std::unique_ptr<Runtime::Instance::ModuleInstance>>
+Executor::instantiateSnapshot(Runtime::StoreManager &StoreMgr,
+                              const AST::Module &Mod, const Snapshot &Snap) {
+  if (auto Res = instantiate(StoreMgr, Mod, std::nullopt, &Snap)) {
+    return Res;
+  } else {
+    if (Stat) {
+      Stat->dumpToLog(Conf);
+    }
+    return Unexpect(Res);
+  }
+}
+
 /// Register an instantiated module. See "include/executor/executor.h".
 Expect<void>
 Executor::registerModule(Runtime::StoreManager &StoreMgr,
@@ -71,6 +88,54 @@ Expect<void> Executor::registerPostHostFunction(
   return {};
 }
 
+/// Register a function which will be invoked when a wasm function becomes hot
+/// in the tiered execution.
+Expect<void> Executor::registerTierUpFunction(
+    std::function<void(const Runtime::Instance::FunctionInstance &)> Func) {
+  TierUpFunc = std::move(Func);
+  TierUpThreshold =
+      TierUpFunc
+          ? std::max(Conf.getRuntimeConfigure().getTierUpThreshold(), 1U)
+          : 0U;
+  return {};
+}
+
+Expect<void> Executor::loadTieredExecutable(
+    const AST::Module &Mod, const Runtime::Instance::ModuleInstance &ModInst,
+    std::shared_ptr<Executable> Exec) noexcept {
+  uint32_t ImportFuncNum = 0;
+  for (const auto &ImpDesc : Mod.getImportSection().getContent()) {
+    if (ImpDesc.getExternalType() == ExternalType::Function) {
+      ++ImportFuncNum;
+    }
+  }
+  const auto &SubTypes = Mod.getTypeSection().getContent();
+  const auto TypeIdxs = Mod.getFunctionSection().getContent();
+  const auto CodeNum = Mod.getCodeSection().getContent().size();
+
+  // Check the symbols.
+  auto IntrinsicsSymbol = Exec->getIntrinsics();
+  auto TypeSymbols = Exec->getTypes(SubTypes.size());
+  auto CodeSymbols = Exec->getCodes(ImportFuncNum, CodeNum);
+  if (unlikely(!IntrinsicsSymbol || TypeSymbols.size() != SubTypes.size() ||
+               CodeSymbols.size() != CodeNum)) {
+    spdlog::error("    Tiered JIT symbols not matching, keep running in "
+                  "interpreter mode.");
+    return Unexpect(ErrCode::Value::IllegalGrammar);
+  }
+
+  // Set the symbols into the function instances.
+  *IntrinsicsSymbol = &Executor::Intrinsics;
+  for (uint32_t I = 0; I < CodeNum; ++I) {
+    auto Func = ModInst.getFunc(ImportFuncNum + I);
+    if (Func && CodeSymbols[I] && TypeSymbols[TypeIdxs[I]]) {
+      (*Func)->setTieredCode(std::move(CodeSymbols[I]),
+                             TypeSymbols[TypeIdxs[I]]);
+    }
+  }
+  return {};
+}
+
 // Invoke function. See "include/executor/executor.h".
 Expect<std::vector<std::pair<ValVariant, ValType>>>
 Executor::invoke(const Runtime::Instance::FunctionInstance *FuncInst,
@@ -111,7 +176,8 @@ Executor::invoke(const Runtime::Instance::FunctionInstance *FuncInst,
     }
   }
 
-  Runtime::StackManager StackMgr;
+  Runtime::StackManager StackMgr(
+      Conf.getRuntimeConfigure().getMaxCallStackDepth());
 
   // Call runFunction.
   if (auto Res = runFunction(StackMgr, *FuncInst, Params); !Res) {
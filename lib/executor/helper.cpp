@@ -35,10 +35,23 @@ Executor::enterFunction(Runtime::StackManager &StackMgr,
   // branches.
   StackMgr.removeInactiveHandler(RetIt - 1);
 
+  // For the tiered execution, the wasm function switches to its compiled code
+  // once it is ready.
+  const Runtime::Instance::FunctionInstance::TieredCode *Tiered = nullptr;
+  if (unlikely(TierUpThreshold > 0) && Func.isWasmFunction()) {
+    Tiered = tierUp(Func);
+  }
+
   if (Func.isHostFunction()) {
     // Host function case: Push args and call function.
     auto &HostFunc = Func.getHostFunc();
 
+    // Check the stack capacity for the frame and the returns.
+    if (unlikely(StackMgr.isExhausted(RetsN, IsTailCall))) {
+      spdlog::error(ErrCode::Value::CallStackExhausted);
+      return Unexpect(ErrCode::Value::CallStackExhausted);
+    }
+
     // Generate CallingFrame from current frame.
     // The module instance will be nullptr if current frame is a dummy frame.
     // For this case, use the module instance of this host function.
@@ -108,10 +121,16 @@ Executor::enterFunction(Runtime::StackManager &StackMgr,
     // For host function case, the continuation will be the continuation from
     // the popped frame.
     return StackMgr.popFrame();
-  } else if (Func.isCompiledFunction()) {
+  } else if (Func.isCompiledFunction() || Tiered) {
     // Compiled function case: Execute the function and jump to the
     // continuation.
 
+    // Check the stack capacity for the frame and the returns.
+    if (unlikely(StackMgr.isExhausted(RetsN, IsTailCall))) {
+      spdlog::error(ErrCode::Value::CallStackExhausted);
+      return Unexpect(ErrCode::Value::CallStackExhausted);
+    }
+
     // Push frame.
     StackMgr.pushFrame(Func.getModule(), // Module instance
                        RetIt,            // Return PC
@@ -148,9 +167,10 @@ Executor::enterFunction(Runtime::StackManager &StackMgr,
       if (Code != 0) {
         Err = ErrCode(static_cast<ErrCategory>(Code >> 24), Code);
       } else {
-        auto &Wrapper = FuncType.getSymbol();
-        Wrapper(&ExecutionContext, Func.getSymbol().get(), Args.data(),
-                Rets.data());
+        auto &Wrapper = Tiered ? Tiered->Wrapper : FuncType.getSymbol();
+        Wrapper(&ExecutionContext,
+                Tiered ? Tiered->Code.get() : Func.getSymbol().get(),
+                Args.data(), Rets.data());
       }
     } catch (const ErrCode &E) {
       Err = E;
@@ -173,6 +193,22 @@ Executor::enterFunction(Runtime::StackManager &StackMgr,
   } else {
     // Native function case: Jump to the start of the function body.
 
+    // Load the function body on the first call in the lazy loading mode.
+    if (unlikely(Func.isLazyFunction())) {
+      if (auto Res = loadLazyFunction(Func); !Res) {
+        return Unexpect(Res);
+      }
+    }
+
+    // Check the stack capacity for the frame, the locals, and the values of
+    // the function body. The stack will not overflow before leaving this
+    // function or calling the next one.
+    if (unlikely(StackMgr.isExhausted(
+            Func.getLocalNum() + Func.getMaxStackHeight(), IsTailCall))) {
+      spdlog::error(ErrCode::Value::CallStackExhausted);
+      return Unexpect(ErrCode::Value::CallStackExhausted);
+    }
+
     // Push local variables into the stack.
     for (auto &Def : Func.getLocals()) {
       for (uint32_t I = 0; I < Def.first; I++) {
@@ -187,7 +223,8 @@ Executor::enterFunction(Runtime::StackManager &StackMgr,
                        RetIt - 1,                  // Return PC
                        ArgsN + Func.getLocalNum(), // Arguments num + local num
                        RetsN,                      // Returns num
-                       IsTailCall                  // For tail-call
+                       IsTailCall,                 // For tail-call
+                       &Func                       // Function instance
     );
 
     // For native function case, the continuation will be the start of the
@@ -196,6 +233,36 @@ Executor::enterFunction(Runtime::StackManager &StackMgr,
   }
 }
 
+const Runtime::Instance::FunctionInstance::TieredCode *
+Executor::tierUp(const Runtime::Instance::FunctionInstance &Func) noexcept {
+  if (const auto *Tiered = Func.getTieredCode()) {
+    return Tiered;
+  }
+  // Notify only once when the function reaches the threshold. The function
+  // keeps running in the interpreter until the compiled code is ready.
+  if (Func.increaseHotness() == TierUpThreshold) {
+    TierUpFunc(Func);
+  }
+  return nullptr;
+}
+
+Expect<void> Executor::loadLazyFunction(
+    const Runtime::Instance::FunctionInstance &Func) const {
+  // Prepare the loaded function body as the instantiation does.
+  return Func.loadLazyBody(
+      [this](AST::InstrVec &Instrs, std::vector<uint32_t> &Costs) {
+        if (Conf.getRuntimeConfigure().isRegisterInterpreter() &&
+            !(Stat &&
+              (Conf.getStatisticsConfigure().isInstructionCounting() ||
+               Conf.getStatisticsConfigure().isCostMeasuring()))) {
+          lowerInstrs(Instrs);
+        } else if (Stat && Conf.getStatisticsConfigure().isCostMeasuring() &&
+                   Conf.getStatisticsConfigure().isBlockCostMeasuring()) {
+          prepareBlockCost(Instrs, Costs);
+        }
+      });
+}
+
 Expect<void>
 Executor::branchToLabel(Runtime::StackManager &StackMgr,
                         const AST::Instruction::JumpDescriptor &JumpDesc,
@@ -206,6 +273,14 @@ Executor::branchToLabel(Runtime::StackManager &StackMgr,
     return Unexpect(ErrCode::Value::Interrupted);
   }
 
+  // Count the backward branches as the loop iterations for the tiered
+  // execution.
+  if (unlikely(TierUpThreshold > 0) && JumpDesc.PCOffset <= 0) {
+    if (const auto *Func = StackMgr.getFunction()) {
+      tierUp(*Func);
+    }
+  }
+
   StackMgr.eraseValueStack(JumpDesc.StackEraseBegin, JumpDesc.StackEraseEnd);
   // PC need to -1 here because the PC will increase in the next iteration.
   PC += (JumpDesc.PCOffset - 1);
@@ -247,6 +322,14 @@ Expect<void> Executor::throwException(Runtime::StackManager &StackMgr,
   return Unexpect(ErrCode::Value::UncaughtException);
 }
 
+Unexpected<ErrCode> Executor::raiseTrap(ErrCode Code) noexcept {
+  if (IsTrapByFault) {
+    IsTrapLogged = true;
+    Fault::emitFault(Code);
+  }
+  return Unexpect(Code);
+}
+
 const AST::SubType *Executor::getDefTypeByIdx(Runtime::StackManager &StackMgr,
                                               const uint32_t Idx) const {
   const auto *ModInst = StackMgr.getModule();
@@ -5,12 +5,99 @@
 
 #include "common/errinfo.h"
 #include "common/spdlog.h"
+#include "system/memimage.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <optional>
 
 namespace WasmEdge {
 namespace Executor {
 
+namespace {
+/// The memories initialized by less data are faster to copy than to map.
+static inline constexpr const uint64_t kImageThreshold = UINT64_C(65536);
+static inline constexpr const uint64_t kPageSize = UINT64_C(65536);
+
+/// Get the offset of the data segment which is the same for all instances.
+std::optional<uint32_t> getConstOffset(const AST::DataSegment &DataSeg) {
+  const auto Instrs = DataSeg.getExpr().getInstrs();
+  if (Instrs.size() == 2 && Instrs[0].getOpCode() == OpCode::I32__const &&
+      Instrs[1].getOpCode() == OpCode::End) {
+    return Instrs[0].getNum().get<uint32_t>();
+  }
+  return std::nullopt;
+}
+
+/// Build the initial images of the defined memories. Only the memories whose
+/// active data segments have constant offsets and fit in the initial size are
+/// built, so the mapped contents are the same as copying the data segments.
+void buildMemoryImages(
+    const AST::Module &Mod,
+    std::vector<std::shared_ptr<const MemoryImage>> &Images) noexcept {
+  if (!MemoryImage::supported()) {
+    return;
+  }
+  uint32_t ImportNum = 0;
+  for (const auto &ImpDesc : Mod.getImportSection().getContent()) {
+    if (ImpDesc.getExternalType() == ExternalType::Memory) {
+      ImportNum++;
+    }
+  }
+  const auto &MemTypes = Mod.getMemorySection().getContent();
+  struct MemoryInfo {
+    uint64_t End = 0;
+    uint64_t Bytes = 0;
+    bool Mappable = true;
+  };
+  std::vector<MemoryInfo> Infos(MemTypes.size());
+  for (const auto &DataSeg : Mod.getDataSection().getContent()) {
+    if (DataSeg.getMode() != AST::DataSegment::DataMode::Active ||
+        DataSeg.getIdx() < ImportNum) {
+      continue;
+    }
+    auto &Info = Infos[DataSeg.getIdx() - ImportNum];
+    const auto &Limit = MemTypes[DataSeg.getIdx() - ImportNum].getLimit();
+    const auto Offset = getConstOffset(DataSeg);
+    const uint64_t Size = DataSeg.getData().size();
+    if (!Offset || *Offset + Size > Limit.getMin() * kPageSize) {
+      Info.Mappable = false;
+      continue;
+    }
+    Info.End = std::max(Info.End, *Offset + Size);
+    Info.Bytes += Size;
+  }
+
+  Images.resize(ImportNum + MemTypes.size());
+  for (uint32_t I = 0; I < MemTypes.size(); ++I) {
+    const auto &Info = Infos[I];
+    if (!Info.Mappable || Info.Bytes < kImageThreshold ||
+        MemTypes[I].getLimit().isShared()) {
+      continue;
+    }
+    auto Image = std::make_shared<MemoryImage>(
+        (Info.End + kPageSize - 1) / kPageSize * kPageSize);
+    if (!Image->ok()) {
+      continue;
+    }
+    // Write the data segments in order, so the later ones overwrite the
+    // overlapped bytes as copying them.
+    bool Written = true;
+    for (const auto &DataSeg : Mod.getDataSection().getContent()) {
+      if (DataSeg.getMode() == AST::DataSegment::DataMode::Active &&
+          DataSeg.getIdx() == ImportNum + I &&
+          !Image->write(*getConstOffset(DataSeg), DataSeg.getData())) {
+        Written = false;
+        break;
+      }
+    }
+    if (Written) {
+      Images[ImportNum + I] = std::move(Image);
+    }
+  }
+}
+} // namespace
+
 // Instantiate data instance. See "include/executor/executor.h".
 Expect<void> Executor::instantiate(Runtime::StackManager &StackMgr,
                                    Runtime::Instance::ModuleInstance &ModInst,
@@ -49,17 +136,32 @@ Expect<void> Executor::instantiate(Runtime::StackManager &StackMgr,
     }
 
     // Create and add the data instance into the module instance.
-    ModInst.addData(Offset, DataSeg.getData());
+    ModInst.addData(Offset, DataSeg.getData(), DataSeg.getDataHolder());
   }
   return {};
 }
 
 // Initialize memory with Data section. See "include/executor/executor.h".
 Expect<void> Executor::initMemory(Runtime::StackManager &StackMgr,
-                                  const AST::DataSection &DataSec) {
+                                  const AST::Module &Mod) {
+  // Map the initial memory images, which are built by the first instantiation
+  // of the module. The pages are copied on write, so the untouched pages are
+  // shared between the instances.
+  auto &MemImages = Mod.getMemoryImages();
+  std::call_once(MemImages.Built,
+                 [&]() { buildMemoryImages(Mod, MemImages.Images); });
+  std::vector<bool> Mapped(MemImages.Images.size(), false);
+  for (uint32_t I = 0; I < MemImages.Images.size(); ++I) {
+    if (const auto &Image = MemImages.Images[I]) {
+      auto *MemInst = getMemInstByIdx(StackMgr, I);
+      assuming(MemInst);
+      Mapped[I] = MemInst->mapImage(*Image);
+    }
+  }
+
   // initialize memory.
   uint32_t Idx = 0;
-  for (const auto &DataSeg : DataSec.getContent()) {
+  for (const auto &DataSeg : Mod.getDataSection().getContent()) {
     // Initialize memory if data mode is active.
     if (DataSeg.getMode() == AST::DataSegment::DataMode::Active) {
       // Memory index should be 0. Checked in validation phase.
@@ -70,13 +172,16 @@ Expect<void> Executor::initMemory(Runtime::StackManager &StackMgr,
       assuming(DataInst);
       const uint32_t Off = DataInst->getOffset();
 
-      // Replace mem[Off : Off + n] with data[0 : n].
-      if (auto Res = MemInst->setBytes(
-              DataInst->getData(), Off, 0,
-              static_cast<uint32_t>(DataInst->getData().size()));
-          !Res) {
-        spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Seg_Data));
-        return Unexpect(Res);
+      // Replace mem[Off : Off + n] with data[0 : n], unless the data is in
+      // the mapped image already.
+      if (DataSeg.getIdx() >= Mapped.size() || !Mapped[DataSeg.getIdx()]) {
+        if (auto Res = MemInst->setBytes(
+                DataInst->getData(), Off, 0,
+                static_cast<uint32_t>(DataInst->getData().size()));
+            !Res) {
+          spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Seg_Data));
+          return Unexpect(Res);
+        }
       }
 
       // Drop the data instance.
@@ -5,6 +5,7 @@
 
 #include <cstdint>
 #include <utility>
+#include <vector>
 
 namespace WasmEdge {
 namespace Executor {
@@ -33,6 +34,48 @@ Expect<void> Executor::instantiate(Runtime::Instance::ModuleInstance &ModInst,
           (*ModInst.getType(TypeIdxs[I]))->getCompositeType().getFuncType(),
           std::move(Symbol));
     }
+  } else if (CodeSegs[0].getLazyBody()) {
+    // The function bodies are loaded and prepared on their first calls in the
+    // lazy loading mode.
+    for (uint32_t I = 0; I < CodeSegs.size(); ++I) {
+      ModInst.addFunc(
+          TypeIdxs[I],
+          (*ModInst.getType(TypeIdxs[I]))->getCompositeType().getFuncType(),
+          CodeSegs[I].getLocals(), CodeSegs[I].getLazyBody());
+    }
+  } else if (Conf.getRuntimeConfigure().isRegisterInterpreter() &&
+             !(Stat && (Conf.getStatisticsConfigure().isInstructionCounting() ||
+                        Conf.getStatisticsConfigure().isCostMeasuring()))) {
+    // Lower the function bodies into the register-based bytecode with the
+    // superinstructions. The lowering is skipped when the instructions should
+    // be metered one by one.
+    AST::InstrVec Instrs;
+    for (uint32_t I = 0; I < CodeSegs.size(); ++I) {
+      auto Expr = CodeSegs[I].getExpr().getInstrs();
+      Instrs.assign(Expr.begin(), Expr.end());
+      lowerInstrs(Instrs);
+      ModInst.addFunc(
+          TypeIdxs[I],
+          (*ModInst.getType(TypeIdxs[I]))->getCompositeType().getFuncType(),
+          CodeSegs[I].getLocals(), Instrs,
+          CodeSegs[I].getMaxStackHeight());
+    }
+  } else if (Stat && Conf.getStatisticsConfigure().isCostMeasuring() &&
+             Conf.getStatisticsConfigure().isBlockCostMeasuring()) {
+    // Prepare the basic block costs with the current cost table for metering
+    // per basic block.
+    AST::InstrVec Instrs;
+    std::vector<uint32_t> Costs;
+    for (uint32_t I = 0; I < CodeSegs.size(); ++I) {
+      auto Expr = CodeSegs[I].getExpr().getInstrs();
+      Instrs.assign(Expr.begin(), Expr.end());
+      prepareBlockCost(Instrs, Costs);
+      ModInst.addFunc(
+          TypeIdxs[I],
+          (*ModInst.getType(TypeIdxs[I]))->getCompositeType().getFuncType(),
+          CodeSegs[I].getLocals(), Instrs, CodeSegs[I].getMaxStackHeight(),
+          Costs);
+    }
   } else {
     // Iterate through the code segments to instantiate function instances.
     for (uint32_t I = 0; I < CodeSegs.size(); ++I) {
@@ -40,7 +83,8 @@ Expect<void> Executor::instantiate(Runtime::Instance::ModuleInstance &ModInst,
       ModInst.addFunc(
           TypeIdxs[I],
           (*ModInst.getType(TypeIdxs[I]))->getCompositeType().getFuncType(),
-          CodeSegs[I].getLocals(), CodeSegs[I].getExpr().getInstrs());
+          CodeSegs[I].getLocals(), CodeSegs[I].getExpr().getInstrs(),
+          CodeSegs[I].getMaxStackHeight());
     }
   }
   return {};
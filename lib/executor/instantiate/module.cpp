@@ -15,7 +15,8 @@ namespace Executor {
 // Instantiate module instance. See "include/executor/Executor.h".
 Expect<std::unique_ptr<Runtime::Instance::ModuleInstance>>
 Executor::instantiate(Runtime::StoreManager &StoreMgr, const AST::Module &Mod,
-                      std::optional<std::string_view> Name) {
+                      std::optional<std::string_view> Name,
+                      const Snapshot *Snap) {
   // Check the module is validated.
   if (unlikely(!Mod.getIsValidated())) {
     spdlog::error(ErrCode::Value::NotValidated);
@@ -24,7 +25,13 @@ Executor::instantiate(Runtime::StoreManager &StoreMgr, const AST::Module &Mod,
   }
 
   // Create the stack manager.
-  Runtime::StackManager StackMgr;
+  Runtime::StackManager StackMgr(
+      Conf.getRuntimeConfigure().getMaxCallStackDepth());
+  if (unlikely(StackMgr.isExhausted(0))) {
+    spdlog::error(ErrCode::Value::CallStackExhausted);
+    spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Module));
+    return Unexpect(ErrCode::Value::CallStackExhausted);
+  }
 
   // Check is module name duplicated when trying to registration.
   if (Name.has_value()) {
@@ -119,37 +126,47 @@ Executor::instantiate(Runtime::StoreManager &StoreMgr, const AST::Module &Mod,
     return Unexpect(Res);
   }
 
-  // Initialize table instances
-  if (auto Res = initTable(StackMgr, ElemSec); !Res) {
-    spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Sec_Element));
-    spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Module));
-    StoreMgr.recycleModule(std::move(ModInst));
-    return Unexpect(Res);
-  }
-
-  // Initialize memory instances
-  if (auto Res = initMemory(StackMgr, DataSec); !Res) {
-    spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Sec_Data));
-    spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Module));
-    StoreMgr.recycleModule(std::move(ModInst));
-    return Unexpect(Res);
-  }
-
-  // Instantiate StartSection (StartSec)
-  const AST::StartSection &StartSec = Mod.getStartSection();
-  if (StartSec.getContent()) {
-    // Get the module instance from ID.
-    ModInst->setStartIdx(*StartSec.getContent());
-
-    // Get function instance.
-    const auto *FuncInst = ModInst->getStartFunc();
+  if (Snap) {
+    // The tables and memories are restored from the snapshot, which is taken
+    // after the initialization and the start function.
+    if (auto Res = restoreSnapshot(*ModInst, *Snap); !Res) {
+      spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Module));
+      StoreMgr.recycleModule(std::move(ModInst));
+      return Unexpect(Res);
+    }
+  } else {
+    // Initialize table instances
+    if (auto Res = initTable(StackMgr, ElemSec); !Res) {
+      spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Sec_Element));
+      spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Module));
+      StoreMgr.recycleModule(std::move(ModInst));
+      return Unexpect(Res);
+    }
 
-    // Execute instruction.
-    if (auto Res = runFunction(StackMgr, *FuncInst, {}); unlikely(!Res)) {
+    // Initialize memory instances
+    if (auto Res = initMemory(StackMgr, Mod); !Res) {
+      spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Sec_Data));
       spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Module));
       StoreMgr.recycleModule(std::move(ModInst));
       return Unexpect(Res);
     }
+
+    // Instantiate StartSection (StartSec)
+    const AST::StartSection &StartSec = Mod.getStartSection();
+    if (StartSec.getContent()) {
+      // Get the module instance from ID.
+      ModInst->setStartIdx(*StartSec.getContent());
+
+      // Get function instance.
+      const auto *FuncInst = ModInst->getStartFunc();
+
+      // Execute instruction.
+      if (auto Res = runFunction(StackMgr, *FuncInst, {}); unlikely(!Res)) {
+        spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Module));
+        StoreMgr.recycleModule(std::move(ModInst));
+        return Unexpect(Res);
+      }
+    }
   }
 
   // Pop Frame.
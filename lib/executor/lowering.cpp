@@ -0,0 +1,231 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "executor/executor.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace WasmEdge {
+namespace Executor {
+
+namespace {
+
+/// Entry of the superinstruction fusion table.
+struct FusionEntry {
+  OpCode Fused;
+  uint32_t Length;
+  std::array<OpCode, 3> Sequence;
+};
+
+constexpr FusionEntry FusionTable[] = {
+#define Fuse2(FUSED, A, B)                                                     \
+  {OpCode::FUSED, 2, {OpCode::A, OpCode::B, OpCode::End}},
+#define Fuse3(FUSED, A, B, C)                                                  \
+  {OpCode::FUSED, 3, {OpCode::A, OpCode::B, OpCode::C}},
+#include "fusion.inc"
+#undef Fuse3
+#undef Fuse2
+};
+
+bool isConstOp(OpCode Code) noexcept {
+  return Code == OpCode::I32__const || Code == OpCode::I64__const ||
+         Code == OpCode::F32__const || Code == OpCode::F64__const;
+}
+
+// The control instructions which end the basic blocks for metering.
+bool isMeterSyncOp(OpCode Code) noexcept {
+  switch (Code) {
+  case OpCode::Unreachable:
+  case OpCode::Block:
+  case OpCode::Loop:
+  case OpCode::If:
+  case OpCode::Else:
+  case OpCode::End:
+  case OpCode::Try:
+  case OpCode::Catch:
+  case OpCode::Catch_all:
+  case OpCode::Delegate:
+  case OpCode::Throw:
+  case OpCode::Rethrow:
+  case OpCode::Throw_ref:
+  case OpCode::Try_table:
+  case OpCode::Br:
+  case OpCode::Br_if:
+  case OpCode::Br_table:
+  case OpCode::Br_on_null:
+  case OpCode::Br_on_non_null:
+  case OpCode::Br_on_cast:
+  case OpCode::Br_on_cast_fail:
+  case OpCode::Return:
+  case OpCode::Call:
+  case OpCode::Call_indirect:
+  case OpCode::Return_call:
+  case OpCode::Return_call_indirect:
+  case OpCode::Call_ref:
+  case OpCode::Return_call_ref:
+    return true;
+  default:
+    return false;
+  }
+}
+
+} // namespace
+
+// Lower the function body. See "include/executor/executor.h".
+void Executor::lowerInstrs(AST::InstrVec &Instrs) const noexcept {
+  // The lowering rewrites the first instruction of a matched sequence in
+  // place and keeps the following ones untouched, so the jump offsets computed
+  // by the validator are still valid. Only the local, constant, and
+  // non-trapping numeric instructions are matched, so no branch can land in
+  // the middle of a sequence and no error information is lost.
+  //
+  // The register operands are the stack offsets at the entry of the sequence,
+  // derived from the stack offsets of the local instructions which are
+  // computed by the validator with the stack heights at those instructions.
+  //
+  // The superinstructions in the fusion table are matched at the same time,
+  // and the longer one of the two matches at a position is applied.
+  const size_t Size = Instrs.size();
+  auto CodeAt = [&Instrs, Size](size_t Idx) {
+    return Idx < Size ? Instrs[Idx].getOpCode() : OpCode::End;
+  };
+
+  // Match the fusion table. Return the matched entry.
+  auto MatchFusion = [&CodeAt](size_t Idx) -> const FusionEntry * {
+    const FusionEntry *Matched = nullptr;
+    for (const auto &Entry : FusionTable) {
+      if (Matched && Matched->Length >= Entry.Length) {
+        continue;
+      }
+      bool IsMatched = true;
+      for (uint32_t J = 0; J < Entry.Length && IsMatched; ++J) {
+        IsMatched = CodeAt(Idx + J) == Entry.Sequence[J];
+      }
+      if (IsMatched) {
+        Matched = &Entry;
+      }
+    }
+    return Matched;
+  };
+
+  // Match the register-based forms. Return the matched length and the
+  // lowered instruction.
+  auto MatchRegister = [&Instrs, &CodeAt](size_t Idx,
+                                          AST::Instruction &Instr) -> uint32_t {
+    auto Lower = [&Instr](OpCode Form, OpCode Code, uint32_t Src1,
+                          uint32_t Src2, uint32_t Dst) {
+      Instr.setOpCode(Form);
+      Instr.getRegOpCode() = Code;
+      Instr.getRegSrc1() = Src1;
+      Instr.getRegSrc2() = Src2;
+      Instr.getRegDst() = Dst;
+    };
+    const OpCode Code = CodeAt(Idx);
+    if (Code == OpCode::Local__get) {
+      // Entry stack height H.
+      const uint32_t Src1 = Instrs[Idx].getStackOffset();
+      const OpCode Next = CodeAt(Idx + 1);
+      if ((Next == OpCode::Local__get || isConstOp(Next)) &&
+          isRegOperation(CodeAt(Idx + 2))) {
+        // The second local.get is at height H + 1.
+        const uint32_t Src2 = Next == OpCode::Local__get
+                                  ? Instrs[Idx + 1].getStackOffset() - 1
+                                  : 0;
+        const OpCode BinOp = CodeAt(Idx + 2);
+        if (CodeAt(Idx + 3) == OpCode::Local__set) {
+          // The local.set is at height H + 1.
+          Lower(Next == OpCode::Local__get ? OpCode::Reg__binop_ll_set
+                                           : OpCode::Reg__binop_lc_set,
+                BinOp, Src1, Src2, Instrs[Idx + 3].getStackOffset() - 1);
+          return 4;
+        }
+        Lower(Next == OpCode::Local__get ? OpCode::Reg__binop_ll
+                                         : OpCode::Reg__binop_lc,
+              BinOp, Src1, Src2, 0);
+        return 3;
+      }
+      if (Next == OpCode::Local__set) {
+        // The local.set is at height H + 1.
+        Lower(OpCode::Reg__local_copy, OpCode::End, Src1, 0,
+              Instrs[Idx + 1].getStackOffset() - 1);
+        return 2;
+      }
+      if (isRegOperation(Next)) {
+        // The left operand is already on the stack.
+        Lower(OpCode::Reg__binop_sl, Next, 0, Src1, 0);
+        return 2;
+      }
+    } else if (isRegOperation(Code) && CodeAt(Idx + 1) == OpCode::Local__set) {
+      // The local.set is at height H - 1.
+      Lower(OpCode::Reg__binop_set, Code, 0, 0,
+            Instrs[Idx + 1].getStackOffset() + 1);
+      return 2;
+    }
+    return 0;
+  };
+
+  size_t I = 0;
+  while (I < Size) {
+    AST::Instruction Lowered(OpCode::End, Instrs[I].getOffset());
+    const uint32_t RegLen = MatchRegister(I, Lowered);
+    const FusionEntry *Fusion = MatchFusion(I);
+    if (Fusion && Fusion->Length >= RegLen) {
+      // The fused handler reads the operands from the original instructions.
+      Instrs[I].setOpCode(Fusion->Fused);
+      I += Fusion->Length;
+    } else if (RegLen > 0) {
+      Instrs[I] = std::move(Lowered);
+      I += RegLen;
+    } else {
+      I++;
+    }
+  }
+}
+
+// Prepare the basic block costs. See "include/executor/executor.h".
+void Executor::prepareBlockCost(AST::InstrVec &Instrs,
+                                std::vector<uint32_t> &Costs) const noexcept {
+  // Every control instruction forms a basic block by itself, and the cost
+  // added when entering it will be charged with the pending cost. Therefore
+  // every branch target and continuation, which are always after the control
+  // instructions, is the leader of a basic block.
+  //
+  // Each instruction has the cost from itself to the end of its basic
+  // block, so that a trap in the middle of a basic block can give back the
+  // cost of the rest instructions. The basic block is split if the cost
+  // exceeds the 32-bit field, and the instruction which cost exceeds it is
+  // recorded as a control instruction with the saturated cost.
+  const auto CostTab = Stat->getCostTable();
+  const size_t Size = Instrs.size();
+  Costs.assign(Size, 0);
+  uint64_t Suffix = 0;
+  for (size_t I = Size; I-- > 0;) {
+    AST::Instruction &Instr = Instrs[I];
+    const uint64_t Cost = CostTab[uint16_t(Instr.getOpCode())];
+    if (isMeterSyncOp(Instr.getOpCode()) || Cost >= UINT32_MAX) {
+      if (I + 1 < Size) {
+        Instrs[I + 1].setMeterLeader();
+      }
+      Instr.setMeterLeader();
+      Instr.setMeterSync();
+      Costs[I] = static_cast<uint32_t>(std::min<uint64_t>(Cost, UINT32_MAX));
+      Suffix = 0;
+      continue;
+    }
+    if (Suffix + Cost > UINT32_MAX) {
+      Instrs[I + 1].setMeterLeader();
+      Suffix = 0;
+    }
+    Suffix += Cost;
+    Costs[I] = static_cast<uint32_t>(Suffix);
+  }
+  if (Size > 0) {
+    Instrs[0].setMeterLeader();
+  }
+}
+
+} // namespace Executor
+} // namespace WasmEdge
@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "executor/pool.h"
+
+#include "common/spdlog.h"
+
+#include <algorithm>
+
+namespace WasmEdge {
+namespace Executor {
+
+using namespace std::literals;
+
+// Create the instance pool. See "include/executor/pool.h".
+Expect<std::unique_ptr<InstancePool>>
+InstancePool::create(Executor &Exec, Runtime::StoreManager &StoreMgr,
+                     const AST::Module &Mod, uint32_t Size) {
+  std::unique_ptr<InstancePool> Pool(new InstancePool(Exec, StoreMgr, Mod));
+
+  // The state is captured from the first instance, which is initialized by
+  // the segments and the start function.
+  auto First = Exec.instantiateModule(StoreMgr, Mod);
+  if (!First) {
+    return Unexpect(First);
+  }
+  if (auto Res = Exec.captureSnapshot(**First)) {
+    Pool->Snap = std::move(*Res);
+  } else {
+    return Unexpect(Res);
+  }
+  Pool->Idle.push_back(First->get());
+  Pool->Instances.push_back(std::move(*First));
+
+  while (Pool->Instances.size() < Size) {
+    auto Res = Exec.instantiateSnapshot(StoreMgr, Mod, *Pool->Snap);
+    if (!Res) {
+      return Unexpect(Res);
+    }
+    Pool->Idle.push_back(Res->get());
+    Pool->Instances.push_back(std::move(*Res));
+  }
+  return Pool;
+}
+
+// Acquire an instance. See "include/executor/pool.h".
+Expect<Runtime::Instance::ModuleInstance *> InstancePool::acquire() {
+  {
+    std::unique_lock Lock(Mutex);
+    if (!Idle.empty()) {
+      auto *ModInst = Idle.back();
+      Idle.pop_back();
+      Acquired.insert(ModInst);
+      return ModInst;
+    }
+  }
+
+  // The instantiation is out of the lock, and the pool grows by one instance.
+  auto Res = Exec.instantiateSnapshot(StoreMgr, Mod, *Snap);
+  if (!Res) {
+    return Unexpect(Res);
+  }
+  std::unique_lock Lock(Mutex);
+  auto *ModInst = Res->get();
+  Instances.push_back(std::move(*Res));
+  Acquired.insert(ModInst);
+  return ModInst;
+}
+
+// Release an instance. See "include/executor/pool.h".
+Expect<void>
+InstancePool::release(Runtime::Instance::ModuleInstance *ModInst) {
+  {
+    std::unique_lock Lock(Mutex);
+    if (Acquired.erase(ModInst) == 0) {
+      spdlog::error(ErrCode::Value::WrongInstanceAddress);
+      spdlog::error("    The instance is not acquired from the pool."sv);
+      return Unexpect(ErrCode::Value::WrongInstanceAddress);
+    }
+  }
+
+  // The instance is not accessed by the others until put back.
+  auto Res = Exec.resetInstance(*ModInst, *Snap);
+  std::unique_lock Lock(Mutex);
+  if (!Res) {
+    // The instance may be partially reset, and could not be reused.
+    Instances.erase(std::find_if(
+        Instances.begin(), Instances.end(),
+        [ModInst](const auto &Inst) { return Inst.get() == ModInst; }));
+    return Unexpect(Res);
+  }
+  Idle.push_back(ModInst);
+  return {};
+}
+
+uint32_t InstancePool::getInstanceCount() const noexcept {
+  std::unique_lock Lock(Mutex);
+  return static_cast<uint32_t>(Instances.size());
+}
+
+uint32_t InstancePool::getIdleCount() const noexcept {
+  std::unique_lock Lock(Mutex);
+  return static_cast<uint32_t>(Idle.size());
+}
+
+} // namespace Executor
+} // namespace WasmEdge
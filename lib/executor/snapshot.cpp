@@ -0,0 +1,527 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "executor/snapshot.h"
+#include "executor/executor.h"
+
+#include "common/errinfo.h"
+#include "common/spdlog.h"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iterator>
+#include <type_traits>
+#include <unordered_map>
+
+namespace WasmEdge {
+namespace Executor {
+
+namespace {
+
+using namespace std::literals;
+
+/// Version of the snapshot format.
+inline constexpr uint32_t kSnapshotVersion = 1;
+
+/// Magic of the snapshot, "\0wms".
+inline constexpr std::array<Byte, 4> kSnapshotMagic = {0x00, 0x77, 0x6D,
+                                                       0x73};
+
+/// Header of the snapshot. The memory records, the global records, the tables,
+/// and the dropped flags of the element and data segments follow the header.
+/// The memory contents start from the next page.
+struct SnapshotHeader {
+  std::array<Byte, 4> Magic;
+  uint32_t Version;
+  uint32_t FuncNum;
+  uint32_t MemoryNum;
+  uint32_t GlobalNum;
+  uint32_t TableNum;
+  uint32_t ElemNum;
+  uint32_t DataNum;
+};
+
+/// Header of the table, which is followed by the references in the table.
+struct TableHeader {
+  uint32_t Size;
+  uint32_t Reserved;
+};
+
+/// The memory contents are mapped in pages from the snapshot.
+inline constexpr uint64_t kPageSize = UINT64_C(65536);
+
+uint64_t alignPage(uint64_t Offset) noexcept {
+  return (Offset + kPageSize - 1) / kPageSize * kPageSize;
+}
+
+template <typename T> void writeRecord(std::ofstream &File, const T &Val) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  File.write(reinterpret_cast<const char *>(&Val), sizeof(T));
+}
+
+template <typename T> void writeRecords(std::ofstream &File, Span<const T> V) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  File.write(reinterpret_cast<const char *>(V.data()),
+             static_cast<std::streamsize>(V.size_bytes()));
+}
+
+template <typename T> bool readRecords(std::ifstream &File, Span<T> V) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  return static_cast<bool>(
+      File.read(reinterpret_cast<char *>(V.data()),
+                static_cast<std::streamsize>(V.size_bytes())));
+}
+
+bool isZeroPage(const uint8_t *Page) noexcept {
+  return std::all_of(Page, Page + kPageSize,
+                     [](uint8_t B) { return B == 0; });
+}
+
+Unexpected<ErrCode> logSnapshotError(ErrCode::Value Code,
+                                     std::string_view Message,
+                                     const std::filesystem::path &Path) {
+  spdlog::error(Code);
+  spdlog::error("    {}:{}"sv, Message, Path.u8string());
+  return Unexpect(Code);
+}
+
+} // namespace
+
+// Load the snapshot. See "include/executor/snapshot.h".
+Expect<std::unique_ptr<Snapshot>>
+Snapshot::load(const std::filesystem::path &Path) {
+  std::ifstream File(Path, std::ios::binary);
+  if (!File) {
+    return logSnapshotError(ErrCode::Value::IllegalPath,
+                            "Open snapshot failed"sv, Path);
+  }
+  SnapshotHeader Header;
+  if (!readRecords(File, Span<SnapshotHeader>(&Header, 1))) {
+    return logSnapshotError(ErrCode::Value::UnexpectedEnd,
+                            "Read snapshot failed"sv, Path);
+  }
+  if (Header.Magic != kSnapshotMagic) {
+    return logSnapshotError(ErrCode::Value::MalformedMagic,
+                            "Not a snapshot"sv, Path);
+  }
+  if (Header.Version != kSnapshotVersion) {
+    return logSnapshotError(ErrCode::Value::MalformedVersion,
+                            "The snapshot is built by the other version"sv,
+                            Path);
+  }
+
+  auto Snap = std::make_unique<Snapshot>();
+  Snap->Path = Path;
+  Snap->FuncNum = Header.FuncNum;
+  Snap->Memories.resize(Header.MemoryNum);
+  Snap->Globals.resize(Header.GlobalNum);
+  Snap->Tables.resize(Header.TableNum);
+  Snap->ElemDropped.resize(Header.ElemNum);
+  Snap->DataDropped.resize(Header.DataNum);
+  bool Succeeded = readRecords(File, Span<MemoryRecord>(Snap->Memories)) &&
+                   readRecords(File, Span<GlobalRecord>(Snap->Globals));
+  for (auto &Table : Snap->Tables) {
+    TableHeader TabHeader;
+    if (!Succeeded ||
+        !readRecords(File, Span<TableHeader>(&TabHeader, 1))) {
+      Succeeded = false;
+      break;
+    }
+    Table.resize(TabHeader.Size);
+    Succeeded = readRecords(File, Span<RefRecord>(Table));
+  }
+  Succeeded = Succeeded &&
+              readRecords(File, Span<uint8_t>(Snap->ElemDropped)) &&
+              readRecords(File, Span<uint8_t>(Snap->DataDropped));
+  if (!Succeeded) {
+    return logSnapshotError(ErrCode::Value::UnexpectedEnd,
+                            "Read snapshot failed"sv, Path);
+  }
+
+  // Check the function references in the snapshot.
+  const auto IsValidRef = [&](const RefRecord &Ref) {
+    return Ref.FuncIdx == kNullFuncIdx || Ref.FuncIdx < Header.FuncNum;
+  };
+  bool IsValid = std::all_of(
+      Snap->Globals.begin(), Snap->Globals.end(),
+      [&](const GlobalRecord &Glob) { return IsValidRef(Glob.Ref); });
+  for (const auto &Table : Snap->Tables) {
+    IsValid = IsValid && std::all_of(Table.begin(), Table.end(), IsValidRef);
+  }
+  if (!IsValid) {
+    return logSnapshotError(ErrCode::Value::InvalidFuncIdx,
+                            "Invalid function reference in snapshot"sv, Path);
+  }
+
+  // The memory contents are opened from the snapshot for mapping. The
+  // contents are read when the image could not be mapped.
+  Snap->MemoryImages.reserve(Snap->Memories.size());
+  for (const auto &Mem : Snap->Memories) {
+    if (Mem.Offset % kPageSize != 0) {
+      return logSnapshotError(ErrCode::Value::MalformedSection,
+                              "Unaligned memory in snapshot"sv, Path);
+    }
+    Snap->MemoryImages.push_back(
+        MemoryImage::supported()
+            ? std::make_unique<MemoryImage>(Path, Mem.Offset,
+                                            Mem.Pages * kPageSize)
+            : nullptr);
+  }
+  return Snap;
+}
+
+// Record the states of module instance. See "include/executor/executor.h".
+Expect<void>
+Executor::recordSnapshot(const Runtime::Instance::ModuleInstance &ModInst,
+                         Snapshot &Snap, bool InMemory) {
+  // The references are recorded as the function indices in the module.
+  std::unordered_map<const Runtime::Instance::FunctionInstance *, uint32_t>
+      FuncIdx;
+  for (uint32_t I = 0; I < ModInst.FuncInsts.size(); ++I) {
+    FuncIdx.emplace(ModInst.FuncInsts[I], I);
+  }
+  const auto ToRecord =
+      [&](const RefVariant &Ref) -> Expect<Snapshot::RefRecord> {
+    Snapshot::RefRecord Record{Ref.getType(), Snapshot::kNullFuncIdx, 0};
+    if (Ref.isNull()) {
+      return Record;
+    }
+    if (Ref.getType().isFuncRefType()) {
+      const auto *Func = Ref.getPtr<Runtime::Instance::FunctionInstance>();
+      if (auto It = FuncIdx.find(Func); It != FuncIdx.end()) {
+        Record.FuncIdx = It->second;
+        return Record;
+      }
+    }
+    // The host references, the GC objects, and the functions out of the
+    // module could not be restored in the other instances.
+    spdlog::error(ErrCode::Value::RuntimeError);
+    spdlog::error("    The snapshot could not record the non-null reference "
+                  "out of the module functions."sv);
+    return Unexpect(ErrCode::Value::RuntimeError);
+  };
+  const auto ToRecords = [&](Span<const RefVariant> Refs,
+                             std::vector<Snapshot::RefRecord> &Records)
+      -> Expect<void> {
+    Records.reserve(Refs.size());
+    for (const auto &Ref : Refs) {
+      if (auto Res = ToRecord(Ref)) {
+        Records.push_back(*Res);
+      } else {
+        return Unexpect(Res);
+      }
+    }
+    return {};
+  };
+
+  Snap.FuncNum = static_cast<uint32_t>(ModInst.FuncInsts.size());
+
+  Snap.Globals.reserve(ModInst.OwnedGlobInsts.size());
+  for (const auto &GlobInst : ModInst.OwnedGlobInsts) {
+    const auto &VType = GlobInst->getGlobalType().getValType();
+    Snapshot::GlobalRecord Record{VType, 0, 0,
+                                  {VType, Snapshot::kNullFuncIdx, 0}};
+    if (VType.isRefType()) {
+      if (auto Res = ToRecord(GlobInst->getValue().get<RefVariant>())) {
+        Record.Ref = *Res;
+      } else {
+        spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Sec_Global));
+        return Unexpect(Res);
+      }
+    } else {
+      Record.Value = GlobInst->getValue().get<uint128_t>();
+    }
+    Snap.Globals.push_back(Record);
+  }
+
+  Snap.Tables.reserve(ModInst.OwnedTabInsts.size());
+  for (const auto &TabInst : ModInst.OwnedTabInsts) {
+    const auto Refs = *TabInst->getRefs(0, TabInst->getSize());
+    if (auto Res = ToRecords(Refs, Snap.Tables.emplace_back()); !Res) {
+      spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Sec_Table));
+      return Unexpect(Res);
+    }
+  }
+
+  // The dropped segments are cleared in the instances.
+  Snap.ElemDropped.reserve(ModInst.ElemInsts.size());
+  for (const auto *ElemInst : ModInst.ElemInsts) {
+    Snap.ElemDropped.push_back(ElemInst->getRefs().empty());
+  }
+  Snap.DataDropped.reserve(ModInst.DataInsts.size());
+  for (const auto *DataInst : ModInst.DataInsts) {
+    Snap.DataDropped.push_back(DataInst->getData().empty());
+  }
+
+  Snap.Memories.reserve(ModInst.OwnedMemInsts.size());
+  for (const auto &MemInst : ModInst.OwnedMemInsts) {
+    Snap.Memories.push_back({MemInst->getPageSize(), 0, 0});
+  }
+  if (!InMemory) {
+    return {};
+  }
+
+  // Keep the live segments to restore them after being dropped.
+  Snap.Elems.reserve(ModInst.ElemInsts.size());
+  for (const auto *ElemInst : ModInst.ElemInsts) {
+    if (auto Res = ToRecords(ElemInst->getRefs(), Snap.Elems.emplace_back());
+        !Res) {
+      spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Seg_Element));
+      return Unexpect(Res);
+    }
+  }
+  Snap.Datas.reserve(ModInst.DataInsts.size());
+  for (const auto *DataInst : ModInst.DataInsts) {
+    const auto Data = DataInst->getData();
+    Snap.Datas.push_back(
+        std::make_shared<const std::vector<Byte>>(Data.begin(), Data.end()));
+  }
+
+  // The memory contents are kept in the anonymous images, which are mapped
+  // over the memories on reset. Only the pages written after the mapping are
+  // dropped then. The contents are copied when the images are not supported.
+  Snap.MemoryImages.reserve(ModInst.OwnedMemInsts.size());
+  Snap.MemoryContents.resize(ModInst.OwnedMemInsts.size());
+  for (uint32_t I = 0; I < ModInst.OwnedMemInsts.size(); ++I) {
+    const auto &MemInst = *ModInst.OwnedMemInsts[I];
+    const uint8_t *Data = MemInst.getDataPtr();
+    const uint64_t Size = MemInst.getPageSize() * kPageSize;
+    std::unique_ptr<MemoryImage> Image;
+    if (MemoryImage::supported() && !MemInst.isShared()) {
+      Image = std::make_unique<MemoryImage>(Size);
+      for (uint64_t Off = 0; Image->ok() && Off < Size; Off += kPageSize) {
+        if (!isZeroPage(Data + Off) &&
+            !Image->write(Off, Span<const Byte>(Data + Off, kPageSize))) {
+          Image.reset();
+          break;
+        }
+      }
+      if (Image && !Image->ok()) {
+        Image.reset();
+      }
+    }
+    if (!Image) {
+      Snap.MemoryContents[I].assign(Data, Data + Size);
+    }
+    Snap.MemoryImages.push_back(std::move(Image));
+  }
+  return {};
+}
+
+// Save the snapshot of module instance. See "include/executor/executor.h".
+Expect<void>
+Executor::saveSnapshot(const Runtime::Instance::ModuleInstance &ModInst,
+                       const std::filesystem::path &Path) {
+  Snapshot Snap;
+  if (auto Res = recordSnapshot(ModInst, Snap, false); !Res) {
+    return Unexpect(Res);
+  }
+
+  SnapshotHeader Header{};
+  Header.Magic = kSnapshotMagic;
+  Header.Version = kSnapshotVersion;
+  Header.FuncNum = Snap.FuncNum;
+  Header.MemoryNum = static_cast<uint32_t>(Snap.Memories.size());
+  Header.GlobalNum = static_cast<uint32_t>(Snap.Globals.size());
+  Header.TableNum = static_cast<uint32_t>(Snap.Tables.size());
+  Header.ElemNum = static_cast<uint32_t>(Snap.ElemDropped.size());
+  Header.DataNum = static_cast<uint32_t>(Snap.DataDropped.size());
+
+  // The memory contents follow the records in pages.
+  uint64_t Offset = sizeof(SnapshotHeader) +
+                    sizeof(Snapshot::MemoryRecord) * Header.MemoryNum +
+                    sizeof(Snapshot::GlobalRecord) * Header.GlobalNum;
+  for (const auto &Table : Snap.Tables) {
+    Offset += sizeof(TableHeader) + sizeof(Snapshot::RefRecord) * Table.size();
+  }
+  Offset = alignPage(Offset + Header.ElemNum + Header.DataNum);
+  for (auto &Mem : Snap.Memories) {
+    Mem.Offset = Offset;
+    Offset += Mem.Pages * kPageSize;
+  }
+
+  std::ofstream File(Path, std::ios::binary | std::ios::trunc);
+  writeRecord(File, Header);
+  writeRecords(File, Span<const Snapshot::MemoryRecord>(Snap.Memories));
+  writeRecords(File, Span<const Snapshot::GlobalRecord>(Snap.Globals));
+  for (const auto &Table : Snap.Tables) {
+    writeRecord(File, TableHeader{static_cast<uint32_t>(Table.size()), 0});
+    writeRecords(File, Span<const Snapshot::RefRecord>(Table));
+  }
+  writeRecords(File, Span<const uint8_t>(Snap.ElemDropped));
+  writeRecords(File, Span<const uint8_t>(Snap.DataDropped));
+  // The zero pages are skipped and left as the holes of the file.
+  for (uint32_t I = 0; I < Snap.Memories.size(); ++I) {
+    const uint8_t *Data = ModInst.OwnedMemInsts[I]->getDataPtr();
+    for (uint32_t P = 0; P < Snap.Memories[I].Pages; ++P) {
+      const uint8_t *Page = Data + P * kPageSize;
+      if (!isZeroPage(Page)) {
+        File.seekp(static_cast<std::streamoff>(Snap.Memories[I].Offset +
+                                               P * kPageSize));
+        File.write(reinterpret_cast<const char *>(Page),
+                   static_cast<std::streamsize>(kPageSize));
+      }
+    }
+  }
+  File.close();
+  std::error_code Error;
+  if (!File || (std::filesystem::resize_file(Path, Offset, Error), Error)) {
+    return logSnapshotError(ErrCode::Value::IllegalPath,
+                            "Write snapshot failed"sv, Path);
+  }
+  return {};
+}
+
+// Capture the snapshot of module instance. See "include/executor/executor.h".
+Expect<std::unique_ptr<Snapshot>>
+Executor::captureSnapshot(const Runtime::Instance::ModuleInstance &ModInst) {
+  auto Snap = std::make_unique<Snapshot>();
+  if (auto Res = recordSnapshot(ModInst, *Snap, true); !Res) {
+    return Unexpect(Res);
+  }
+  return Snap;
+}
+
+// Reset the module instance. See "include/executor/executor.h".
+Expect<void>
+Executor::resetInstance(Runtime::Instance::ModuleInstance &ModInst,
+                        const Snapshot &Snap) {
+  if (unlikely(Snap.Elems.size() != Snap.ElemDropped.size() ||
+               Snap.Datas.size() != Snap.DataDropped.size())) {
+    // The dropped segments could not be restored from the loaded snapshots.
+    spdlog::error(ErrCode::Value::RuntimeError);
+    spdlog::error("    The snapshot is not captured in memory."sv);
+    return Unexpect(ErrCode::Value::RuntimeError);
+  }
+  if (auto Res = restoreSnapshot(ModInst, Snap); !Res) {
+    return Unexpect(Res);
+  }
+  // The GC objects allocated after the snapshot are unreachable from the
+  // restored globals and tables.
+  ModInst.OwnedArrayInsts.clear();
+  ModInst.OwnedStructInsts.clear();
+  return {};
+}
+
+// Restore the module instance from snapshot. See
+// "include/executor/executor.h".
+Expect<void>
+Executor::restoreSnapshot(Runtime::Instance::ModuleInstance &ModInst,
+                          const Snapshot &Snap) {
+  // The snapshot should be taken from the instance of the same module.
+  bool IsMatched = Snap.FuncNum == ModInst.FuncInsts.size() &&
+                   Snap.Memories.size() == ModInst.OwnedMemInsts.size() &&
+                   Snap.Globals.size() == ModInst.OwnedGlobInsts.size() &&
+                   Snap.Tables.size() == ModInst.OwnedTabInsts.size() &&
+                   Snap.ElemDropped.size() == ModInst.ElemInsts.size() &&
+                   Snap.DataDropped.size() == ModInst.DataInsts.size();
+  for (uint32_t I = 0; IsMatched && I < Snap.Globals.size(); ++I) {
+    IsMatched = Snap.Globals[I].Type ==
+                ModInst.OwnedGlobInsts[I]->getGlobalType().getValType();
+  }
+  if (!IsMatched) {
+    return logSnapshotError(ErrCode::Value::RuntimeError,
+                            "The snapshot is taken from the other module"sv,
+                            Snap.Path);
+  }
+
+  const auto ToRef = [&](const Snapshot::RefRecord &Record) {
+    if (Record.FuncIdx == Snapshot::kNullFuncIdx) {
+      return RefVariant(Record.Type);
+    }
+    return RefVariant(Record.Type, ModInst.FuncInsts[Record.FuncIdx]);
+  };
+
+  for (uint32_t I = 0; I < Snap.Globals.size(); ++I) {
+    const auto &Record = Snap.Globals[I];
+    if (Record.Type.isRefType()) {
+      ModInst.OwnedGlobInsts[I]->setValue(ToRef(Record.Ref));
+    } else {
+      ModInst.OwnedGlobInsts[I]->setValue(Record.Value);
+    }
+  }
+
+  for (uint32_t I = 0; I < Snap.Tables.size(); ++I) {
+    auto &TabInst = *ModInst.OwnedTabInsts[I];
+    const auto &Table = Snap.Tables[I];
+    const auto Size = static_cast<uint32_t>(Table.size());
+    // The tables grown after the snapshot are shrunk on reset.
+    if (Size < TabInst.getSize()
+            ? !TabInst.shrinkTable(TabInst.getSize() - Size)
+            : !TabInst.growTable(Size - TabInst.getSize())) {
+      spdlog::error(ErrCode::Value::TableOutOfBounds);
+      spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Sec_Table));
+      return Unexpect(ErrCode::Value::TableOutOfBounds);
+    }
+    std::vector<RefVariant> Refs;
+    Refs.reserve(Size);
+    std::transform(Table.begin(), Table.end(), std::back_inserter(Refs), ToRef);
+    if (auto Res = TabInst.setRefs(Refs, 0, 0, Size); !Res) {
+      spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Sec_Table));
+      return Unexpect(Res);
+    }
+  }
+
+  for (uint32_t I = 0; I < Snap.Memories.size(); ++I) {
+    auto &MemInst = *ModInst.OwnedMemInsts[I];
+    const uint32_t Pages = Snap.Memories[I].Pages;
+    if (Pages < MemInst.getPageSize()
+            ? !MemInst.shrinkPage(MemInst.getPageSize() - Pages)
+            : !MemInst.growPage(Pages - MemInst.getPageSize())) {
+      spdlog::error(ErrCode::Value::MemoryOutOfBounds);
+      spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Sec_Memory));
+      return Unexpect(ErrCode::Value::MemoryOutOfBounds);
+    }
+    // The shared memories are not mapped privately. The contents of them
+    // are read from the images instead.
+    const Span<Byte> Data(MemInst.getDataPtr(), Pages * kPageSize);
+    if (const auto &Image = Snap.MemoryImages[I]; Image && Image->ok()) {
+      if ((!MemInst.isShared() && MemInst.mapImage(*Image)) ||
+          Image->read(0, Data)) {
+        continue;
+      }
+    } else if (!Snap.MemoryContents.empty()) {
+      const auto &Content = Snap.MemoryContents[I];
+      std::copy(Content.begin(), Content.end(), Data.begin());
+      continue;
+    } else {
+      std::ifstream File(Snap.Path, std::ios::binary);
+      File.seekg(static_cast<std::streamoff>(Snap.Memories[I].Offset));
+      if (File.read(reinterpret_cast<char *>(Data.data()),
+                    static_cast<std::streamsize>(Data.size()))) {
+        continue;
+      }
+    }
+    return logSnapshotError(ErrCode::Value::UnexpectedEnd,
+                            "Read snapshot failed"sv, Snap.Path);
+  }
+
+  // The segments dropped after the snapshot are restored on reset.
+  for (uint32_t I = 0; I < Snap.ElemDropped.size(); ++I) {
+    auto &ElemInst = *ModInst.ElemInsts[I];
+    if (Snap.ElemDropped[I]) {
+      ElemInst.clear();
+    } else if (I < Snap.Elems.size() &&
+               ElemInst.getRefs().size() != Snap.Elems[I].size()) {
+      std::vector<RefVariant> Refs;
+      Refs.reserve(Snap.Elems[I].size());
+      std::transform(Snap.Elems[I].begin(), Snap.Elems[I].end(),
+                     std::back_inserter(Refs), ToRef);
+      ElemInst.restore(Refs);
+    }
+  }
+  for (uint32_t I = 0; I < Snap.DataDropped.size(); ++I) {
+    auto &DataInst = *ModInst.DataInsts[I];
+    if (Snap.DataDropped[I]) {
+      DataInst.clear();
+    } else if (I < Snap.Datas.size() &&
+               DataInst.getData().size() != Snap.Datas[I]->size()) {
+      DataInst.restore(*Snap.Datas[I], Snap.Datas[I]);
+    }
+  }
+  return {};
+}
+
+} // namespace Executor
+} // namespace WasmEdge
@@ -13,6 +13,9 @@
 #include <lld/Common/Driver.h>
 #include <random>
 #include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
 
 #if LLVM_VERSION_MAJOR >= 14
 #include <lld/Common/CommonLinkerContext.h>
@@ -176,12 +179,13 @@ std::filesystem::path createTemp(const std::filesystem::path Model) noexcept {
   }
 }
 
-// Write output object and link
-Expect<void> outputNativeLibrary(const std::filesystem::path &OutputPath,
-                                 const LLVM::MemoryBuffer &OSVec) noexcept {
+// Write output objects and link
+Expect<void>
+outputNativeLibrary(const std::filesystem::path &OutputPath,
+                    Span<const LLVM::MemoryBuffer> Objects) noexcept {
   spdlog::info("output start");
-  std::filesystem::path ObjectName;
-  {
+  std::vector<std::string> ObjectNames;
+  for (const auto &OSVec : Objects) {
     // tempfile
     std::filesystem::path OPath(OutputPath);
 #if WASMEDGE_OS_WINDOWS
@@ -189,7 +193,7 @@ Expect<void> outputNativeLibrary(const std::filesystem::path &OutputPath,
 #else
     OPath.replace_extension("%%%%%%%%%%.o"sv);
 #endif
-    ObjectName = createTemp(OPath);
+    auto ObjectName = createTemp(OPath);
     if (ObjectName.empty()) {
       // TODO:return error
       spdlog::error("so file creation failed:{}", OPath.u8string());
@@ -198,57 +202,68 @@ Expect<void> outputNativeLibrary(const std::filesystem::path &OutputPath,
     std::ofstream OS(ObjectName, std::ios_base::binary);
     OS.write(OSVec.data(), static_cast<std::streamsize>(OSVec.size()));
     OS.close();
+    ObjectNames.push_back(ObjectName.u8string());
   }
 
   // link
-  bool LinkResult = false;
+  const auto OutputName = OutputPath.u8string();
 #if WASMEDGE_OS_MACOS
   const auto OSVersion = getOSVersion();
   const auto SDKVersion = getSDKVersion();
-#if LLVM_VERSION_MAJOR >= 14
-  // LLVM 14 replaces the older mach_o lld implementation with the new one.
-  // So we need to change the namespace after LLVM 14.x released.
-  // Reference: https://reviews.llvm.org/D114842
-  LinkResult = lld::macho::link(
-#else
-  LinkResult = lld::mach_o::link(
 #endif
-      std::initializer_list<const char *> {
-        "lld", "-arch",
+  std::vector<const char *> Args = {
+#if WASMEDGE_OS_MACOS
+    "lld", "-arch",
 #if defined(__x86_64__)
-            "x86_64",
+        "x86_64",
 #elif defined(__aarch64__)
-            "arm64",
+        "arm64",
 #else
 #error Unsupported architecture on the MacOS!
 #endif
 #if LLVM_VERSION_MAJOR >= 14
-            // LLVM 14 replaces the older mach_o lld implementation with the new
-            // one. And it require -arch and -platform_version to always be
-            // specified. Reference: https://reviews.llvm.org/D97799
-            "-platform_version", "macos", OSVersion.c_str(), SDKVersion.c_str(),
+        // LLVM 14 replaces the older mach_o lld implementation with the new
+        // one. And it require -arch and -platform_version to always be
+        // specified. Reference: https://reviews.llvm.org/D97799
+        "-platform_version", "macos", OSVersion.c_str(), SDKVersion.c_str(),
 #else
-            "-sdk_version", SDKVersion.c_str(),
+        "-sdk_version", SDKVersion.c_str(),
+#endif
+        "-dylib", "-demangle", "-macosx_version_min", OSVersion.c_str(),
+        "-syslibroot", "/Library/Developer/CommandLineTools/SDKs/MacOSX.sdk",
+#elif WASMEDGE_OS_LINUX
+    "ld.lld", "--eh-frame-hdr", "--shared", "--gc-sections", "--discard-all",
+#elif WASMEDGE_OS_WINDOWS
+    "lld-link", "-dll", "-base:0", "-nologo",
+#endif
+  };
+  for (const auto &ObjectName : ObjectNames) {
+    Args.push_back(ObjectName.c_str());
+  }
+#if WASMEDGE_OS_WINDOWS
+  const auto OutArg = "-out:"s + OutputName;
+  Args.push_back(OutArg.c_str());
+#else
+  Args.push_back("-o");
+  Args.push_back(OutputName.c_str());
+#endif
+
+  bool LinkResult = false;
+#if WASMEDGE_OS_MACOS
+#if LLVM_VERSION_MAJOR >= 14
+  // LLVM 14 replaces the older mach_o lld implementation with the new one.
+  // So we need to change the namespace after LLVM 14.x released.
+  // Reference: https://reviews.llvm.org/D114842
+  LinkResult = lld::macho::link(
+#else
+  LinkResult = lld::mach_o::link(
 #endif
-            "-dylib", "-demangle", "-macosx_version_min", OSVersion.c_str(),
-            "-syslibroot",
-            "/Library/Developer/CommandLineTools/SDKs/MacOSX.sdk",
-            ObjectName.u8string().c_str(), "-o", OutputPath.u8string().c_str()
-      },
 #elif WASMEDGE_OS_LINUX
   LinkResult = lld::elf::link(
-      std::initializer_list<const char *>{"ld.lld", "--eh-frame-hdr",
-                                          "--shared", "--gc-sections",
-                                          "--discard-all", ObjectName.c_str(),
-                                          "-o", OutputPath.u8string().c_str()},
 #elif WASMEDGE_OS_WINDOWS
   LinkResult = lld::coff::link(
-      std::initializer_list<const char *>{
-          "lld-link", "-dll", "-base:0", "-nologo",
-          ObjectName.u8string().c_str(),
-          ("-out:" + OutputPath.u8string()).c_str()},
 #endif
-
+      Args,
 #if LLVM_VERSION_MAJOR >= 14
       llvm::outs(), llvm::errs(), false, false
 #elif LLVM_VERSION_MAJOR >= 10
@@ -264,7 +279,9 @@ Expect<void> outputNativeLibrary(const std::filesystem::path &OutputPath,
 
   if (LinkResult) {
     std::error_code Error;
-    std::filesystem::remove(ObjectName, Error);
+    for (const auto &ObjectName : ObjectNames) {
+      std::filesystem::remove(std::filesystem::u8path(ObjectName), Error);
+    }
 #if WASMEDGE_OS_WINDOWS
     std::filesystem::path LibPath(OutputPath);
     LibPath.replace_extension(".lib"sv);
@@ -302,7 +319,7 @@ Expect<void> outputNativeLibrary(const std::filesystem::path &OutputPath,
 Expect<void> outputWasmLibrary(LLVM::Context LLContext,
                                const std::filesystem::path &OutputPath,
                                Span<const Byte> Data,
-                               const LLVM::MemoryBuffer &OSVec) noexcept {
+                               Span<const LLVM::MemoryBuffer> Objects) noexcept {
   std::filesystem::path SharedObjectName;
   {
     // tempfile
@@ -315,11 +332,11 @@ Expect<void> outputWasmLibrary(LLVM::Context LLContext,
       return Unexpect(ErrCode::Value::IllegalPath);
     }
     std::ofstream OS(SharedObjectName, std::ios_base::binary);
-    OS.write(OSVec.data(), static_cast<std::streamsize>(OSVec.size()));
     OS.close();
   }
 
-  if (auto Res = outputNativeLibrary(SharedObjectName, OSVec); unlikely(!Res)) {
+  if (auto Res = outputNativeLibrary(SharedObjectName, Objects);
+      unlikely(!Res)) {
     return Unexpect(Res);
   }
 
@@ -500,20 +517,13 @@ Expect<void> outputWasmLibrary(LLVM::Context LLContext,
   return {};
 }
 
-} // namespace
-
-namespace WasmEdge::LLVM {
-
-Expect<void> CodeGen::codegen(Span<const Byte> WasmData, Data D,
-                              std::filesystem::path OutputPath) noexcept {
-  auto LLContext = D.extract().LLContext();
-  auto &LLModule = D.extract().LLModule;
-  auto &TM = D.extract().TM;
-  std::filesystem::path LLPath(OutputPath);
-  LLPath.replace_extension("ll"sv);
-
+// Prepare the module for the code generation. The module-wide definitions are
+// only created in the primary partition.
+void prepareModule(const Configure &Conf, Span<const Byte> WasmData,
+                   LLVM::Context LLContext, LLVM::Module &LLModule,
+                   bool IsPrimary) noexcept {
 #if WASMEDGE_OS_WINDOWS
-  {
+  if (IsPrimary) {
     // create dummy dllmain function
     auto FTy = LLVM::Type::getFunctionType(LLContext.getInt32Ty(), {});
     auto F =
@@ -548,17 +558,19 @@ Expect<void> CodeGen::codegen(Span<const Byte> WasmData, Data D,
 
   if (Conf.getCompilerConfigure().getOutputFormat() !=
       CompilerConfigure::OutputFormat::Wasm) {
-    // create wasm.code and wasm.size
-    auto Int32Ty = LLContext.getInt32Ty();
-    auto Content = LLVM::Value::getConstString(
-        LLContext,
-        {reinterpret_cast<const char *>(WasmData.data()), WasmData.size()},
-        true);
-    LLModule.addGlobal(Content.getType(), true, LLVMExternalLinkage, Content,
-                       "wasm.code");
-    LLModule.addGlobal(Int32Ty, true, LLVMExternalLinkage,
-                       LLVM::Value::getConstInt(Int32Ty, WasmData.size()),
-                       "wasm.size");
+    if (IsPrimary) {
+      // create wasm.code and wasm.size
+      auto Int32Ty = LLContext.getInt32Ty();
+      auto Content = LLVM::Value::getConstString(
+          LLContext,
+          {reinterpret_cast<const char *>(WasmData.data()), WasmData.size()},
+          true);
+      LLModule.addGlobal(Content.getType(), true, LLVMExternalLinkage, Content,
+                         "wasm.code");
+      LLModule.addGlobal(Int32Ty, true, LLVMExternalLinkage,
+                         LLVM::Value::getConstInt(Int32Ty, WasmData.size()),
+                         "wasm.size");
+    }
     for (auto Fn = LLModule.getFirstFunction(); Fn; Fn = Fn.getNextFunction()) {
       if (Fn.getLinkage() == LLVMInternalLinkage) {
         Fn.setLinkage(LLVMExternalLinkage);
@@ -577,52 +589,97 @@ Expect<void> CodeGen::codegen(Span<const Byte> WasmData, Data D,
     }
   }
 
-  // set dllexport
+  // set dllexport, except the local symbols externalized by the splitting.
   for (auto GV = LLModule.getFirstGlobal(); GV; GV = GV.getNextGlobal()) {
-    if (GV.getLinkage() == LLVMExternalLinkage) {
+    if (GV.getLinkage() == LLVMExternalLinkage &&
+        GV.getVisibility() != LLVMHiddenVisibility) {
       GV.setVisibility(LLVMProtectedVisibility);
       GV.setDSOLocal(true);
       GV.setDLLStorageClass(LLVMDLLExportStorageClass);
     }
   }
+}
 
-  if (Conf.getCompilerConfigure().isDumpIR()) {
-    if (auto ErrorMessage = LLModule.printModuleToFile("wasm.ll");
-        unlikely(ErrorMessage)) {
-      spdlog::error("wasm.ll open error:{}", ErrorMessage.string_view());
-      return WasmEdge::Unexpect(WasmEdge::ErrCode::Value::IllegalPath);
+} // namespace
+
+namespace WasmEdge::LLVM {
+
+Expect<void> CodeGen::codegen(Span<const Byte> WasmData, Data D,
+                              std::filesystem::path OutputPath) noexcept {
+  // The module may be split into the partitions by the compiler, which are
+  // code-generated in parallel and linked together.
+  std::vector<Data::DataContext *> Modules;
+  if (auto &Partitions = D.extract().Partitions; !Partitions.empty()) {
+    for (auto &Partition : Partitions) {
+      Modules.push_back(&Partition.extract());
     }
+  } else {
+    Modules.push_back(&D.extract());
   }
 
-  spdlog::info("codegen start");
-  // codegen
-  {
-    if (Conf.getCompilerConfigure().isDumpIR()) {
-      if (auto ErrorMessage = LLModule.printModuleToFile("wasm-opt.ll")) {
-        // TODO:return error
-        spdlog::error("printModuleToFile failed");
-        return Unexpect(ErrCode::Value::IllegalPath);
+  for (size_t I = 0; I < Modules.size(); ++I) {
+    prepareModule(Conf, WasmData, Modules[I]->LLContext(),
+                  Modules[I]->LLModule, I == 0);
+  }
+
+  if (Conf.getCompilerConfigure().isDumpIR()) {
+    for (size_t I = 0; I < Modules.size(); ++I) {
+      const auto Suffix =
+          Modules.size() > 1 ? fmt::format(".{}.ll"sv, I) : ".ll"s;
+      for (const auto &Name : {"wasm"s + Suffix, "wasm-opt"s + Suffix}) {
+        if (auto ErrorMessage =
+                Modules[I]->LLModule.printModuleToFile(Name.c_str());
+            unlikely(ErrorMessage)) {
+          spdlog::error("{} open error:{}", Name, ErrorMessage.string_view());
+          return WasmEdge::Unexpect(WasmEdge::ErrCode::Value::IllegalPath);
+        }
       }
     }
+  }
 
-    auto [OSVec, ErrorMessage] =
-        TM.emitToMemoryBuffer(LLModule, LLVMObjectFile);
+  spdlog::info("codegen start");
+  // codegen
+  std::vector<LLVM::MemoryBuffer> Objects(Modules.size());
+  std::vector<Expect<void>> Results(Modules.size());
+  auto Emit = [&](size_t I) noexcept {
+    auto [OSVec, ErrorMessage] = Modules[I]->TM.emitToMemoryBuffer(
+        Modules[I]->LLModule, LLVMObjectFile);
     if (ErrorMessage) {
       // TODO:return error
       spdlog::error("addPassesToEmitFile failed");
-      return Unexpect(ErrCode::Value::IllegalPath);
+      Results[I] = Unexpect(ErrCode::Value::IllegalPath);
+      return;
+    }
+    Objects[I] = std::move(OSVec);
+  };
+  if (Modules.size() == 1) {
+    Emit(0);
+  } else {
+    std::vector<std::thread> Threads;
+    Threads.reserve(Modules.size());
+    for (size_t I = 0; I < Modules.size(); ++I) {
+      Threads.emplace_back(Emit, I);
+    }
+    for (auto &Thread : Threads) {
+      Thread.join();
     }
+  }
+  for (auto &Res : Results) {
+    if (!Res) {
+      return Unexpect(Res);
+    }
+  }
 
-    if (Conf.getCompilerConfigure().getOutputFormat() ==
-        CompilerConfigure::OutputFormat::Wasm) {
-      if (auto Res = outputWasmLibrary(LLContext, OutputPath, WasmData, OSVec);
-          unlikely(!Res)) {
-        return Unexpect(Res);
-      }
-    } else {
-      if (auto Res = outputNativeLibrary(OutputPath, OSVec); unlikely(!Res)) {
-        return Unexpect(Res);
-      }
+  if (Conf.getCompilerConfigure().getOutputFormat() ==
+      CompilerConfigure::OutputFormat::Wasm) {
+    if (auto Res = outputWasmLibrary(Modules.front()->LLContext(), OutputPath,
+                                     WasmData, Objects);
+        unlikely(!Res)) {
+      return Unexpect(Res);
+    }
+  } else {
+    if (auto Res = outputNativeLibrary(OutputPath, Objects); unlikely(!Res)) {
+      return Unexpect(Res);
     }
   }
 
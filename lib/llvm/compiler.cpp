@@ -21,6 +21,8 @@
 #include <string>
 #include <string_view>
 #include <system_error>
+#include <thread>
+#include <vector>
 
 namespace LLVM = WasmEdge::LLVM;
 using namespace std::literals;
@@ -5027,6 +5029,94 @@ std::vector<LLVM::Value> unpackStruct(LLVM::Builder &Builder,
   return Ret;
 }
 
+// Create the target machine, and run the optimization passes on the module.
+Expect<void> optimize(const Configure &Conf, LLVM::Module &LLModule,
+                      LLVM::TargetMachine &TM) noexcept {
+  auto Triple = LLModule.getTarget();
+  auto [TheTarget, ErrorMessage] = LLVM::Target::getFromTriple(Triple);
+  if (ErrorMessage) {
+    spdlog::error("getFromTriple failed:{}", ErrorMessage.string_view());
+    return Unexpect(ErrCode::Value::IllegalPath);
+  } else {
+    std::string CPUName;
+#if defined(__riscv) && __riscv_xlen == 64
+    CPUName = "generic-rv64"s;
+#else
+    if (!Conf.getCompilerConfigure().isGenericBinary()) {
+      CPUName = LLVM::getHostCPUName().string_view();
+    } else {
+      CPUName = "generic"s;
+    }
+#endif
+
+    TM = LLVM::TargetMachine::create(
+        TheTarget, Triple, CPUName.c_str(),
+        LLVM::getHostCPUFeatures().unwrap(),
+        toLLVMCodeGenLevel(
+            Conf.getCompilerConfigure().getOptimizationLevel()),
+        LLVMRelocPIC, LLVMCodeModelDefault);
+  }
+
+#if LLVM_VERSION_MAJOR >= 13
+  auto PBO = LLVM::PassBuilderOptions::create();
+  if (auto Error = PBO.runPasses(
+          LLModule,
+          toLLVMLevel(Conf.getCompilerConfigure().getOptimizationLevel()),
+          TM)) {
+    spdlog::error("{}"sv, Error.message().string_view());
+  }
+#else
+  auto FP = LLVM::PassManager::createForModule(LLModule);
+  auto MP = LLVM::PassManager::create();
+
+  TM.addAnalysisPasses(MP);
+  TM.addAnalysisPasses(FP);
+  {
+    auto PMB = LLVM::PassManagerBuilder::create();
+    auto [OptLevel, SizeLevel] =
+        toLLVMLevel(Conf.getCompilerConfigure().getOptimizationLevel());
+    PMB.setOptLevel(OptLevel);
+    PMB.setSizeLevel(SizeLevel);
+    PMB.populateFunctionPassManager(FP);
+    PMB.populateModulePassManager(MP);
+  }
+  switch (Conf.getCompilerConfigure().getOptimizationLevel()) {
+  case CompilerConfigure::OptimizationLevel::O0:
+  case CompilerConfigure::OptimizationLevel::O1:
+    FP.addTailCallEliminationPass();
+    break;
+  default:
+    break;
+  }
+
+  FP.initializeFunctionPassManager();
+  for (auto Fn = LLModule.getFirstFunction(); Fn; Fn = Fn.getNextFunction()) {
+    FP.runFunctionPassManager(Fn);
+  }
+  FP.finalizeFunctionPassManager();
+  MP.runPassManager(LLModule);
+#endif
+  return {};
+}
+
+// Set initializer for the intrinsics table, which is treated as a constant
+// during the optimization.
+void setIntrinsicsTable(LLVM::Context LLContext,
+                        LLVM::Module &LLModule) noexcept {
+  if (auto IntrinsicsTable = LLModule.getNamedGlobal("intrinsics")) {
+    IntrinsicsTable.setInitializer(
+        LLVM::Value::getConstNull(IntrinsicsTable.getType()));
+    IntrinsicsTable.setGlobalConstant(false);
+  } else {
+    auto IntrinsicsTableTy = LLVM::Type::getArrayType(
+        LLContext.getInt8Ty().getPointerTo(),
+        static_cast<uint32_t>(Executable::Intrinsics::kIntrinsicMax));
+    LLModule.addGlobal(
+        IntrinsicsTableTy.getPointerTo(), false, LLVMExternalLinkage,
+        LLVM::Value::getConstNull(IntrinsicsTableTy), "intrinsics");
+  }
+}
+
 } // namespace
 
 namespace WasmEdge {
@@ -5081,87 +5171,59 @@ Expect<Data> Compiler::compile(const AST::Module &Module) noexcept {
   spdlog::info("verify start");
   LLModule.verify(LLVMPrintMessageAction);
 
-  spdlog::info("optimize start");
-  auto &TM = D.extract().TM;
-  {
-    auto Triple = LLModule.getTarget();
-    auto [TheTarget, ErrorMessage] = LLVM::Target::getFromTriple(Triple);
-    if (ErrorMessage) {
-      spdlog::error("getFromTriple failed:{}", ErrorMessage.string_view());
-      return Unexpect(ErrCode::Value::IllegalPath);
-    } else {
-      std::string CPUName;
-#if defined(__riscv) && __riscv_xlen == 64
-      CPUName = "generic-rv64"s;
-#else
-      if (!Conf.getCompilerConfigure().isGenericBinary()) {
-        CPUName = LLVM::getHostCPUName().string_view();
-      } else {
-        CPUName = "generic"s;
-      }
-#endif
-
-      TM = LLVM::TargetMachine::create(
-          TheTarget, Triple, CPUName.c_str(),
-          LLVM::getHostCPUFeatures().unwrap(),
-          toLLVMCodeGenLevel(
-              Conf.getCompilerConfigure().getOptimizationLevel()),
-          LLVMRelocPIC, LLVMCodeModelDefault);
-    }
-
-#if LLVM_VERSION_MAJOR >= 13
-    auto PBO = LLVM::PassBuilderOptions::create();
-    if (auto Error = PBO.runPasses(
-            LLModule,
-            toLLVMLevel(Conf.getCompilerConfigure().getOptimizationLevel()),
-            TM)) {
-      spdlog::error("{}"sv, Error.message().string_view());
-    }
-#else
-    auto FP = LLVM::PassManager::createForModule(LLModule);
-    auto MP = LLVM::PassManager::create();
-
-    TM.addAnalysisPasses(MP);
-    TM.addAnalysisPasses(FP);
-    {
-      auto PMB = LLVM::PassManagerBuilder::create();
-      auto [OptLevel, SizeLevel] =
-          toLLVMLevel(Conf.getCompilerConfigure().getOptimizationLevel());
-      PMB.setOptLevel(OptLevel);
-      PMB.setSizeLevel(SizeLevel);
-      PMB.populateFunctionPassManager(FP);
-      PMB.populateModulePassManager(MP);
+  uint32_t Jobs = Conf.getCompilerConfigure().getJobs();
+  if (Jobs == 0) {
+    Jobs = std::max(std::thread::hardware_concurrency(), 1U);
+  }
+  if (Jobs == 1) {
+    spdlog::info("optimize start");
+    if (auto Res = optimize(Conf, LLModule, D.extract().TM); !Res) {
+      return Unexpect(Res);
     }
-    switch (Conf.getCompilerConfigure().getOptimizationLevel()) {
-    case CompilerConfigure::OptimizationLevel::O0:
-    case CompilerConfigure::OptimizationLevel::O1:
-      FP.addTailCallEliminationPass();
-      break;
-    default:
-      break;
+    setIntrinsicsTable(LLContext, LLModule);
+    spdlog::info("optimize done");
+    return Expect<Data>{std::move(D)};
+  }
+
+  // Split the functions into partitions, and optimize each partition in its
+  // own context on its own thread. The partitions are code-generated in
+  // parallel and linked together by the code generator.
+  spdlog::info("split start");
+  auto Bitcodes = LLModule.split(Jobs);
+  LLModule = LLVM::Module();
+  auto &Partitions = D.extract().Partitions;
+  Partitions.resize(Bitcodes.size());
+  std::vector<Expect<void>> Results(Bitcodes.size());
+
+  spdlog::info("optimize start with {} partitions"sv, Bitcodes.size());
+  {
+    std::vector<std::thread> Threads;
+    Threads.reserve(Bitcodes.size());
+    for (size_t I = 0; I < Bitcodes.size(); ++I) {
+      Threads.emplace_back([&, I]() {
+        auto &Partition = Partitions[I].extract();
+        Partition.LLModule =
+            LLVM::Module::parseBitcode(Partition.LLContext(), Bitcodes[I]);
+        if (!Partition.LLModule) {
+          spdlog::error("parse partition {} failed"sv, I);
+          Results[I] = Unexpect(ErrCode::Value::IllegalPath);
+          return;
+        }
+        Results[I] = optimize(Conf, Partition.LLModule, Partition.TM);
+        if (Results[I] && I == 0) {
+          // Only one partition defines the intrinsics table.
+          setIntrinsicsTable(Partition.LLContext(), Partition.LLModule);
+        }
+      });
     }
-
-    FP.initializeFunctionPassManager();
-    for (auto Fn = LLModule.getFirstFunction(); Fn; Fn = Fn.getNextFunction()) {
-      FP.runFunctionPassManager(Fn);
+    for (auto &Thread : Threads) {
+      Thread.join();
     }
-    FP.finalizeFunctionPassManager();
-    MP.runPassManager(LLModule);
-#endif
   }
-
-  // Set initializer for constant value
-  if (auto IntrinsicsTable = LLModule.getNamedGlobal("intrinsics")) {
-    IntrinsicsTable.setInitializer(
-        LLVM::Value::getConstNull(IntrinsicsTable.getType()));
-    IntrinsicsTable.setGlobalConstant(false);
-  } else {
-    auto IntrinsicsTableTy = LLVM::Type::getArrayType(
-        LLContext.getInt8Ty().getPointerTo(),
-        static_cast<uint32_t>(Executable::Intrinsics::kIntrinsicMax));
-    LLModule.addGlobal(
-        IntrinsicsTableTy.getPointerTo(), false, LLVMExternalLinkage,
-        LLVM::Value::getConstNull(IntrinsicsTableTy), "intrinsics");
+  for (auto &Res : Results) {
+    if (!Res) {
+      return Unexpect(Res);
+    }
   }
 
   spdlog::info("optimize done");
@@ -5481,5 +5543,22 @@ void Compiler::compile(const AST::FunctionSection &FuncSec,
   }
 }
 
+std::string Compiler::getTarget(const Configure &Conf) noexcept {
+  std::string Target(LLVM::getDefaultTargetTriple().string_view());
+  Target += ',';
+#if defined(__riscv) && __riscv_xlen == 64
+  Target += "generic-rv64"sv;
+#else
+  if (!Conf.getCompilerConfigure().isGenericBinary()) {
+    Target += LLVM::getHostCPUName().string_view();
+  } else {
+    Target += "generic"sv;
+  }
+#endif
+  Target += ',';
+  Target += LLVM::getHostCPUFeatures().string_view();
+  return Target;
+}
+
 } // namespace LLVM
 } // namespace WasmEdge
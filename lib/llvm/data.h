@@ -5,10 +5,15 @@
 #include "llvm.h"
 #include "llvm/data.h"
 
+#include <vector>
+
 struct WasmEdge::LLVM::Data::DataContext {
   LLVM::OrcThreadSafeContext TSContext;
   LLVM::Module LLModule;
   LLVM::TargetMachine TM;
+  /// The partitions of the module in their own contexts, which are optimized
+  /// and code-generated in parallel. The module above is unused if not empty.
+  std::vector<LLVM::Data> Partitions;
   DataContext() noexcept : TSContext(), LLModule(LLContext(), "wasm") {}
   LLVM::Context LLContext() noexcept { return TSContext.getContext(); }
 };
@@ -72,20 +72,36 @@ Expect<std::shared_ptr<Executable>> JIT::load(Data D) noexcept {
     J = std::move(*Res);
   }
 
-  auto &LLModule = D.extract().LLModule;
-
-  if (Conf.getCompilerConfigure().isDumpIR()) {
-    if (auto ErrorMessage = LLModule.printModuleToFile("wasm-jit.ll")) {
-      spdlog::error("printModuleToFile failed");
+  // The partitions of the module are added into the same JITDylib, where the
+  // symbols across them are resolved.
+  std::vector<Data::DataContext *> Modules;
+  if (auto &Partitions = D.extract().Partitions; !Partitions.empty()) {
+    for (auto &Partition : Partitions) {
+      Modules.push_back(&Partition.extract());
     }
+  } else {
+    Modules.push_back(&D.extract());
   }
 
   auto MainJD = J.getMainJITDylib();
-  if (auto Err = J.addLLVMIRModule(
-          MainJD,
-          OrcThreadSafeModule(LLModule.release(), D.extract().TSContext))) {
-    spdlog::error("{}"sv, Err.message().string_view());
-    return Unexpect(ErrCode::Value::HostFuncError);
+  for (size_t I = 0; I < Modules.size(); ++I) {
+    auto &LLModule = Modules[I]->LLModule;
+
+    if (Conf.getCompilerConfigure().isDumpIR()) {
+      const auto Name = Modules.size() > 1
+                            ? fmt::format("wasm-jit.{}.ll"sv, I)
+                            : std::string("wasm-jit.ll"sv);
+      if (auto ErrorMessage = LLModule.printModuleToFile(Name.c_str())) {
+        spdlog::error("printModuleToFile failed");
+      }
+    }
+
+    if (auto Err = J.addLLVMIRModule(
+            MainJD,
+            OrcThreadSafeModule(LLModule.release(), Modules[I]->TSContext))) {
+      spdlog::error("{}"sv, Err.message().string_view());
+      return Unexpect(ErrCode::Value::HostFuncError);
+    }
   }
 
   return std::make_shared<JITLibrary>(std::move(J));
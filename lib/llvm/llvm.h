@@ -5,6 +5,7 @@
 #include "common/errcode.h"
 #include "common/span.h"
 #include <llvm-c/Analysis.h>
+#include <llvm-c/BitReader.h>
 #include <llvm-c/Core.h>
 #include <llvm-c/Error.h>
 #include <llvm-c/Object.h>
@@ -237,6 +238,7 @@ private:
 };
 
 class Attribute;
+class MemoryBuffer;
 class Message;
 class Metadata;
 class PassManager;
@@ -319,6 +321,12 @@ public:
   inline Value getNamedFunction(const char *Name) noexcept;
   inline Message printModuleToFile(const char *File) noexcept;
   inline Message verify(LLVMVerifierFailureAction Action) noexcept;
+  /// Split the module into at most N partitions, and serialize each of them
+  /// into a bitcode buffer. The local symbols are externalized to be referred
+  /// across the partitions.
+  inline std::vector<MemoryBuffer> split(unsigned int N) noexcept;
+  static inline Module parseBitcode(const Context &C,
+                                    const MemoryBuffer &Buffer) noexcept;
 
   constexpr operator bool() const noexcept { return Ref != nullptr; }
   constexpr auto &unwrap() const noexcept { return Ref; }
@@ -783,6 +791,9 @@ public:
   void setVisibility(LLVMVisibility Viz) noexcept {
     LLVMSetVisibility(Ref, Viz);
   }
+  LLVMVisibility getVisibility() noexcept {
+    return LLVMGetVisibility(Ref);
+  }
   inline void setDSOLocal(bool Local) noexcept;
   void setDLLStorageClass(LLVMDLLStorageClass Class) noexcept {
     LLVMSetDLLStorageClass(Ref, Class);
@@ -960,6 +971,15 @@ Message Module::verify(LLVMVerifierFailureAction Action) noexcept {
   return M;
 }
 
+Module Module::parseBitcode(const Context &C,
+                            const MemoryBuffer &Buffer) noexcept {
+  Module M;
+  if (LLVMParseBitcodeInContext2(C.unwrap(), Buffer.unwrap(), &M.unwrap())) {
+    return {};
+  }
+  return M;
+}
+
 Type Context::getVoidTy() noexcept { return LLVMVoidTypeInContext(Ref); }
 Type Context::getInt1Ty() noexcept { return LLVMInt1TypeInContext(Ref); }
 Type Context::getInt8Ty() noexcept { return LLVMInt8TypeInContext(Ref); }
@@ -2185,9 +2205,14 @@ private:
 
 } // namespace WasmEdge::LLVM
 
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/IR/GlobalValue.h>
+#include <llvm/IR/Module.h>
 #include <llvm/Object/ObjectFile.h>
+#include <llvm/Support/raw_ostream.h>
 #include <llvm/Transforms/Utils/BasicBlockUtils.h>
+#include <llvm/Transforms/Utils/SplitModule.h>
 #if LLVM_VERSION_MAJOR < 12 || WASMEDGE_OS_WINDOWS
 #include <llvm/ExecutionEngine/Orc/Core.h>
 #endif
@@ -2231,6 +2256,19 @@ void Value::setDSOLocal(bool Local) noexcept {
       ->setDSOLocal(Local);
 }
 
+std::vector<MemoryBuffer> Module::split(unsigned int N) noexcept {
+  std::vector<MemoryBuffer> Result;
+  llvm::SplitModule(
+      *llvm::unwrap(Ref), N, [&](std::unique_ptr<llvm::Module> Partition) {
+        llvm::SmallString<0> Bitcode;
+        llvm::raw_svector_ostream OS(Bitcode);
+        llvm::WriteBitcodeToFile(*Partition, OS);
+        Result.emplace_back(LLVMCreateMemoryBufferWithMemoryRangeCopy(
+            Bitcode.data(), Bitcode.size(), "partition"));
+      });
+  return Result;
+}
+
 void Value::eliminateUnreachableBlocks() noexcept {
   llvm::EliminateUnreachableBlocks(
       *llvm::cast<llvm::Function>(reinterpret_cast<llvm::Value *>(Ref)));
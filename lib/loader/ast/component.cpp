@@ -56,7 +56,9 @@ Loader::loadUnit() {
     auto Mod = std::make_unique<AST::Module>();
     Mod->getMagic() = WasmMagic;
     Mod->getVersion() = Ver;
-    if (!Conf.getRuntimeConfigure().isForceInterpreter()) {
+    // The AOT section in the universal WASM is not looked up from the
+    // streaming source, which should not be read through before loading.
+    if (!Conf.getRuntimeConfigure().isForceInterpreter() && !FMgr.isStream()) {
       if (auto Res = loadModuleAOT(Mod->getAOTSection()); !Res) {
         return Unexpect(Res);
       }
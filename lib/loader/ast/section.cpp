@@ -5,9 +5,14 @@
 
 #include "aot/version.h"
 #include "common/defines.h"
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <memory>
+#include <thread>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 namespace WasmEdge {
 namespace Loader {
@@ -29,9 +34,13 @@ Expect<void> Loader::loadSection(AST::CustomSection &Sec) {
       return logLoadError(ErrCode::Value::UnexpectedEnd, FMgr.getLastOffset(),
                           ASTNodeAttr::Sec_Custom);
     }
-    if (auto Res = FMgr.readBytes(Sec.getContentSize() - ReadSize)) {
-      Sec.getContent().insert(Sec.getContent().end(), (*Res).begin(),
-                              (*Res).end());
+    if (auto Res = FMgr.readBytesView(Sec.getContentSize() - ReadSize)) {
+      if (auto Holder = FMgr.getDataHolder()) {
+        // Reference the content in the mapped file without copying.
+        Sec.setContent(*Res, std::move(Holder));
+      } else {
+        Sec.getContent().assign((*Res).begin(), (*Res).end());
+      }
     } else {
       return logLoadError(Res.error(), FMgr.getLastOffset(),
                           ASTNodeAttr::Sec_Custom);
@@ -177,12 +186,132 @@ Expect<void> Loader::loadSection(AST::ElementSection &Sec) {
   });
 }
 
-// Load vector of code section. See "include/loader/loader.h".
+// Check the function bodies are loaded lazily. See "include/loader/loader.h".
+bool Loader::isLazyLoading() const noexcept {
+  // The compilers need the whole function bodies, and the function bodies are
+  // skipped in the AOT mode.
+  const auto &RuntimeConf = Conf.getRuntimeConfigure();
+  return RuntimeConf.isLazyLoading() && !RuntimeConf.isEnableJIT() &&
+         !RuntimeConf.isEnableTieredJIT() && !RuntimeConf.isEnableAOTCache() &&
+         (RuntimeConf.isForceInterpreter() || WASMType == InputType::WASM);
+}
+
+// Load code section, and share the binary with the lazily loaded function
+// bodies in the lazy loading mode. See "include/loader/loader.h".
 Expect<void> Loader::loadSection(AST::CodeSection &Sec) {
-  return loadSectionContent(Sec, [this, &Sec]() {
-    return loadSectionContentVec(Sec, [this](AST::CodeSegment &CodeSeg) {
-      return loadSegment(CodeSeg);
-    });
+  if (WASMType == InputType::Image) {
+    // The function bodies in the module image are pre-decoded.
+    return loadImageCode(Sec);
+  }
+  if (isLazyLoading()) {
+    LazyCodeData = std::make_shared<LazyCode>(Conf, HasDataSection);
+    auto Res = loadCodeSection(Sec);
+    if (Res) {
+      const auto Code = FMgr.getReadData();
+      LazyCodeData->Code.assign(Code.begin(), Code.end());
+    }
+    LazyCodeData.reset();
+    return Res;
+  }
+  return loadCodeSection(Sec);
+}
+
+// Load vector of code section. See "include/loader/loader.h".
+Expect<void> Loader::loadCodeSection(AST::CodeSection &Sec) {
+  return loadSectionContent(Sec, [this, &Sec]() -> Expect<void> {
+    uint32_t Jobs = Conf.getRuntimeConfigure().getLoadingJobs();
+    if (Jobs == 0) {
+      Jobs = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    // The function bodies are skipped in the AOT mode, and only recorded in
+    // the lazy loading mode.
+    if (Jobs <= 1 || LazyCodeData ||
+        (!Conf.getRuntimeConfigure().isForceInterpreter() &&
+         WASMType != InputType::WASM)) {
+      return loadSectionContentVec(Sec, [this](AST::CodeSegment &CodeSeg) {
+        return loadSegment(CodeSeg);
+      });
+    }
+
+    // Read the vector size.
+    auto &CodeVec = Sec.getContent();
+    uint32_t VecCnt = 0;
+    if (auto Res = loadVecCnt()) {
+      VecCnt = *Res;
+      CodeVec.resize(VecCnt);
+    } else {
+      return logLoadError(Res.error(), FMgr.getLastOffset(),
+                          ASTNodeAttr::Sec_Code);
+    }
+
+    // Record the start offsets of the code segments by their sizes first. The
+    // recording stops at the segment which size cannot be read, and the
+    // remaining segments are loaded sequentially to report the same error.
+    std::vector<uint64_t> Offsets;
+    Offsets.reserve(VecCnt);
+    for (uint32_t I = 0; I < VecCnt; ++I) {
+      const uint64_t Offset = FMgr.getOffset();
+      if (auto Res = FMgr.readU32()) {
+        Offsets.push_back(Offset);
+        FMgr.seek(FMgr.getOffset() + *Res);
+      } else {
+        FMgr.seek(Offset);
+        break;
+      }
+    }
+    const auto SegNum = static_cast<uint32_t>(Offsets.size());
+
+    // Decode the recorded code segments in parallel. Every worker has its own
+    // file manager as the view of the shared buffer, so the error offsets are
+    // the same as the sequential loading. The segments after the first failed
+    // one are skipped, and the results are reduced in order.
+    std::vector<Expect<void>> Results(SegNum);
+    std::atomic<uint32_t> NextId = 0;
+    std::atomic<uint32_t> FailedId = SegNum;
+    auto Worker = [&]() {
+      Loader SegLoader(Conf, IntrinsicsTable);
+      SegLoader.WASMType = WASMType;
+      SegLoader.HasDataSection = HasDataSection;
+      for (uint32_t Id = NextId.fetch_add(1, std::memory_order_relaxed);
+           Id < FailedId.load(std::memory_order_relaxed);
+           Id = NextId.fetch_add(1, std::memory_order_relaxed)) {
+        SegLoader.FMgr.setView(FMgr, Offsets[Id]);
+        Results[Id] = SegLoader.loadSegment(CodeVec[Id]);
+        if (!Results[Id]) {
+          uint32_t Failed = FailedId.load(std::memory_order_relaxed);
+          while (Id < Failed && !FailedId.compare_exchange_weak(
+                                    Failed, Id, std::memory_order_relaxed)) {
+          }
+        }
+      }
+    };
+    Jobs = std::min(Jobs, SegNum);
+    std::vector<std::thread> Threads;
+    Threads.reserve(Jobs > 0 ? Jobs - 1 : 0);
+    for (uint32_t I = 1; I < Jobs; ++I) {
+      Threads.emplace_back(Worker);
+    }
+    if (Jobs > 0) {
+      Worker();
+    }
+    for (auto &Thread : Threads) {
+      Thread.join();
+    }
+    for (uint32_t Id = 0; Id < SegNum; ++Id) {
+      if (!Results[Id]) {
+        spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Sec_Code));
+        return Unexpect(Results[Id]);
+      }
+    }
+
+    // Sequentially load the remaining code segments.
+    for (uint32_t Id = SegNum; Id < VecCnt; ++Id) {
+      if (auto Res = loadSegment(CodeVec[Id]); !Res) {
+        spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Sec_Code));
+        return Unexpect(Res);
+      }
+    }
+    return {};
   });
 }
 
@@ -4,6 +4,7 @@
 #include "loader/loader.h"
 
 #include <cstdint>
+#include <memory>
 #include <utility>
 
 namespace WasmEdge {
@@ -243,6 +244,31 @@ Expect<void> Loader::loadSegment(AST::ElementSegment &ElemSeg) {
   return {};
 }
 
+// The function body which is decoded on demand.
+class Loader::LazyBody : public AST::LazyFunctionBody {
+public:
+  LazyBody(std::shared_ptr<const LazyCode> Code, uint64_t Offset,
+           uint64_t SizeBound) noexcept
+      : Code(std::move(Code)), Offset(Offset), SizeBound(SizeBound) {}
+
+  Expect<void> load(AST::Expression &Expr, uint32_t &) const override {
+    Loader BodyLoader(Code->Conf);
+    BodyLoader.HasDataSection = Code->HasDataSection;
+    BodyLoader.FMgr.setCode(Span<const Byte>(Code->Code));
+    BodyLoader.FMgr.seek(Offset);
+    if (auto Res = BodyLoader.loadExpression(Expr, SizeBound); !Res) {
+      spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Seg_Code));
+      return Unexpect(Res);
+    }
+    return {};
+  }
+
+private:
+  const std::shared_ptr<const LazyCode> Code;
+  const uint64_t Offset;
+  const uint64_t SizeBound;
+};
+
 // Load binary of CodeSegment node. See "include/loader/loader.h".
 Expect<void> Loader::loadSegment(AST::CodeSegment &CodeSeg) {
   // Read the code segment size.
@@ -295,6 +321,12 @@ Expect<void> Loader::loadSegment(AST::CodeSegment &CodeSeg) {
     // For the AOT mode and not force interpreter in configure, skip the
     // function body.
     FMgr.seek(ExprSizeBound);
+  } else if (LazyCodeData) {
+    // For the lazy loading mode, record the function body and skip it.
+    CodeSeg.setLazyBody(
+        std::make_shared<LazyBody>(LazyCodeData, FMgr.getOffset(),
+                                   ExprSizeBound));
+    FMgr.seek(ExprSizeBound);
   } else {
     // Read function body with expected expression size.
     if (auto Res = loadExpression(CodeSeg.getExpr(), ExprSizeBound);
@@ -371,8 +403,13 @@ Expect<void> Loader::loadSegment(AST::DataSegment &DataSeg) {
       return logLoadError(Res.error(), FMgr.getLastOffset(),
                           ASTNodeAttr::Seg_Data);
     }
-    if (auto Res = FMgr.readBytes(VecCnt)) {
-      DataSeg.getData() = std::move(*Res);
+    if (auto Res = FMgr.readBytesView(VecCnt)) {
+      if (auto Holder = FMgr.getDataHolder()) {
+        // Reference the data in the mapped file without copying.
+        DataSeg.setData(*Res, std::move(Holder));
+      } else {
+        DataSeg.getData().assign((*Res).begin(), (*Res).end());
+      }
     } else {
       return logLoadError(Res.error(), FMgr.getLastOffset(),
                           ASTNodeAttr::Seg_Data);
@@ -21,7 +21,7 @@ Expect<void> FileMgr::setPath(const std::filesystem::path &FilePath) {
       Status = ErrCode::Value::IllegalPath;
       return Unexpect(Status);
     }
-    FileMap.emplace(FilePath);
+    FileMap = std::make_shared<MMap>(FilePath);
     if (auto *Pointer = FileMap->address(); likely(Pointer)) {
       Data = reinterpret_cast<const Byte *>(Pointer);
       Status = ErrCode::Value::Success;
@@ -56,6 +56,29 @@ Expect<void> FileMgr::setCode(std::vector<Byte> CodeData) {
   return {};
 }
 
+// Set streaming source. See "include/loader/filemgr.h".
+Expect<void> FileMgr::setStream(StreamReader Reader) {
+  reset();
+  DataHolder.emplace();
+  Data = DataHolder->data();
+  Stream = std::move(Reader);
+  IsStream = true;
+  Status = ErrCode::Value::Success;
+  return {};
+}
+
+// Set code data view. See "include/loader/filemgr.h".
+Expect<void> FileMgr::setView(const FileMgr &Parent, uint64_t Offset) {
+  reset();
+  Data = Parent.Data;
+  Size = Parent.Size;
+  Status = Parent.Status == ErrCode::Value::IllegalPath
+               ? ErrCode::Value::IllegalPath
+               : ErrCode::Value::Success;
+  seek(Offset);
+  return {};
+}
+
 // Read one byte. See "include/loader/filemgr.h".
 Expect<Byte> FileMgr::readByte() {
   if (unlikely(Status != ErrCode::Value::Success)) {
@@ -82,6 +105,22 @@ Expect<std::vector<Byte>> FileMgr::readBytes(size_t SizeToRead) {
   return Buf;
 }
 
+// Read number of bytes as a view. See "include/loader/filemgr.h".
+Expect<Span<const Byte>> FileMgr::readBytesView(size_t SizeToRead) {
+  if (unlikely(Status != ErrCode::Value::Success)) {
+    return Unexpect(Status);
+  }
+  // Set the flag to the start offset.
+  LastPos = Pos;
+  // Check if exceed the data boundary.
+  if (auto Res = testRead(SizeToRead); unlikely(!Res)) {
+    return Unexpect(Res);
+  }
+  Span<const Byte> View(Data + Pos, SizeToRead);
+  Pos += SizeToRead;
+  return View;
+}
+
 // Decode and read an unsigned int. See "include/loader/filemgr.h".
 Expect<uint32_t> FileMgr::readU32() {
   if (unlikely(Status != ErrCode::Value::Success)) {
@@ -382,11 +421,15 @@ Expect<Byte> FileMgr::peekByte() {
 
 // Get the file header type. See "include/loader/filemgr.h".
 FileMgr::FileHeader FileMgr::getHeaderType() {
+  if (Stream && Size < 4 && !fill(4)) {
+    return FileMgr::FileHeader::Unknown;
+  }
   if (Size >= 4) {
     Byte WASMMagic[] = {0x00, 0x61, 0x73, 0x6D};
     Byte ELFMagic[] = {0x7F, 0x45, 0x4C, 0x46};
     Byte MAC32agic[] = {0xCE, 0xFA, 0xED, 0xFE};
     Byte MAC64agic[] = {0xCF, 0xFA, 0xED, 0xFE};
+    Byte ImageMagic[] = {0x00, 0x77, 0x6D, 0x69};
     if (std::equal(WASMMagic, WASMMagic + 4, Data)) {
       return FileMgr::FileHeader::Wasm;
     } else if (std::equal(ELFMagic, ELFMagic + 4, Data)) {
@@ -395,6 +438,8 @@ FileMgr::FileHeader FileMgr::getHeaderType() {
       return FileMgr::FileHeader::MachO_32;
     } else if (std::equal(MAC64agic, MAC64agic + 4, Data)) {
       return FileMgr::FileHeader::MachO_64;
+    } else if (std::equal(ImageMagic, ImageMagic + 4, Data)) {
+      return FileMgr::FileHeader::Image;
     }
   }
   if (Size >= 2) {
@@ -448,6 +493,12 @@ Expect<void> FileMgr::readBytes(Span<Byte> Buffer) {
 
 // Helper function for checking boundary. See "include/loader/filemgr.h".
 Expect<void> FileMgr::testRead(uint64_t Read) {
+  // Read more data from the streaming source.
+  if (unlikely(getRemainSize() < Read && Stream)) {
+    if (auto Res = fill(Pos + Read); unlikely(!Res)) {
+      return Unexpect(Res);
+    }
+  }
   // Check if exceed the data boundary
   if (unlikely(getRemainSize() < Read)) {
     Pos = Size;
@@ -458,4 +509,29 @@ Expect<void> FileMgr::testRead(uint64_t Read) {
   return {};
 }
 
+// Helper function for reading streaming source. See "include/loader/filemgr.h".
+Expect<void> FileMgr::fill(uint64_t NewSize) {
+  // Read the stream by chunks to not allocate the wrong size.
+  constexpr const uint64_t ChunkSize = UINT64_C(65536);
+  while (Stream && Size < NewSize) {
+    DataHolder->resize(Size + ChunkSize);
+    auto Res = Stream(Span<Byte>(DataHolder->data() + Size, ChunkSize));
+    if (Res) {
+      Size += std::min(static_cast<uint64_t>(*Res), ChunkSize);
+    }
+    DataHolder->resize(Size);
+    Data = DataHolder->data();
+    if (unlikely(!Res)) {
+      Stream = nullptr;
+      Status = Res.error().getEnum();
+      return Unexpect(Res);
+    }
+    if (*Res == 0) {
+      // End of the stream.
+      Stream = nullptr;
+    }
+  }
+  return {};
+}
+
 } // namespace WasmEdge
@@ -0,0 +1,534 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "loader/loader.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace WasmEdge {
+namespace Loader {
+
+namespace {
+
+/// Version of the module image format.
+inline constexpr uint32_t kImageVersion = 1;
+
+/// Magic of the module image, "\0wmi".
+inline constexpr std::array<Byte, 4> kImageMagic = {0x00, 0x77, 0x6D, 0x69};
+
+/// Alignment of the records in the module image. The instruction records are
+/// referenced in place from the mapped file.
+inline constexpr uint64_t kImageAlign = 8;
+static_assert(alignof(AST::Instruction) <= kImageAlign);
+
+/// Header of the module image. The wasm sections follow the header, and the
+/// content of the code section is replaced by the function body records.
+struct ImageHeader {
+  std::array<Byte, 4> Magic;
+  uint32_t Version;
+  uint32_t InstrSize;
+  uint32_t Reserved;
+  uint64_t Proposals;
+};
+static_assert(sizeof(ImageHeader) % kImageAlign == 0);
+
+/// Header of the function body record. The local entries, the instruction
+/// records, and the out-of-line payloads follow the header, and every part is
+/// aligned.
+struct ImageCodeHeader {
+  uint32_t SegSize;
+  uint32_t MaxStackHeight;
+  uint32_t LocalNum;
+  uint32_t InstrNum;
+  uint32_t PayloadNum;
+  uint32_t PayloadSize;
+};
+static_assert(sizeof(ImageCodeHeader) % kImageAlign == 0);
+
+/// Header of the out-of-line payload of the instruction. The instruction node
+/// is rebuilt from this header, and the count of the payload entries follows.
+struct ImagePayloadHeader {
+  uint32_t Index;
+  uint32_t Offset;
+  uint32_t Count;
+  OpCode Code;
+  uint8_t IsMeterLeader;
+  uint8_t IsMeterSync;
+};
+static_assert(sizeof(ImagePayloadHeader) % kImageAlign == 0);
+
+static_assert(std::is_trivially_copyable_v<ValType>);
+static_assert(std::is_trivially_copyable_v<BlockType>);
+static_assert(std::is_trivially_copyable_v<AST::Instruction::JumpDescriptor>);
+static_assert(std::is_trivially_copyable_v<AST::Instruction::BrCastDescriptor>);
+static_assert(std::is_trivially_copyable_v<AST::Instruction::CatchDescriptor>);
+
+/// Size of a local entry, which is the count followed by the value type.
+inline constexpr uint64_t kLocalSize = sizeof(uint32_t) + sizeof(ValType);
+
+uint64_t getProposals(const Configure &Conf) noexcept {
+  static_assert(static_cast<uint8_t>(Proposal::Max) <= 64);
+  uint64_t Proposals = 0;
+  for (uint8_t I = 0; I < static_cast<uint8_t>(Proposal::Max); ++I) {
+    if (Conf.hasProposal(static_cast<Proposal>(I))) {
+      Proposals |= UINT64_C(1) << I;
+    }
+  }
+  return Proposals;
+}
+
+uint64_t getPadding(uint64_t Offset) noexcept {
+  return (kImageAlign - Offset % kImageAlign) % kImageAlign;
+}
+
+template <typename T> void writeImage(std::vector<Byte> &OutVec, const T &Val) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  const auto *Ptr = reinterpret_cast<const Byte *>(&Val);
+  OutVec.insert(OutVec.end(), Ptr, Ptr + sizeof(T));
+}
+
+void alignImage(std::vector<Byte> &OutVec) {
+  OutVec.resize(OutVec.size() + getPadding(OutVec.size()), 0x00U);
+}
+
+/// Encode the u32 in 5 bytes at the position, which is patched after the
+/// content is serialized.
+void patchU32(std::vector<Byte> &OutVec, size_t Pos, uint32_t Num) noexcept {
+  for (uint32_t I = 0; I < 4; ++I) {
+    OutVec[Pos + I] = static_cast<Byte>((Num & 0x7FU) | 0x80U);
+    Num >>= 7;
+  }
+  OutVec[Pos + 4] = static_cast<Byte>(Num);
+}
+
+/// Serialize the out-of-line payload of the instruction.
+Expect<void> serializePayload(const AST::Instruction &Instr, uint32_t Index,
+                              std::vector<Byte> &OutVec) {
+  ImagePayloadHeader Header{};
+  Header.Index = Index;
+  Header.Offset = Instr.getOffset();
+  Header.Code = Instr.getOpCode();
+  Header.IsMeterLeader = Instr.isMeterLeader();
+  Header.IsMeterSync = Instr.isMeterSync();
+  switch (Instr.getOpCode()) {
+  case OpCode::Br_table: {
+    const auto Labels = Instr.getLabelList();
+    Header.Count = static_cast<uint32_t>(Labels.size());
+    writeImage(OutVec, Header);
+    for (const auto &Label : Labels) {
+      writeImage(OutVec, Label);
+    }
+    break;
+  }
+  case OpCode::Select_t: {
+    const auto Types = Instr.getValTypeList();
+    Header.Count = static_cast<uint32_t>(Types.size());
+    writeImage(OutVec, Header);
+    for (const auto &Type : Types) {
+      writeImage(OutVec, Type);
+    }
+    break;
+  }
+  case OpCode::Br_on_cast:
+  case OpCode::Br_on_cast_fail:
+    Header.Count = 1;
+    writeImage(OutVec, Header);
+    writeImage(OutVec, Instr.getBrCast());
+    break;
+  // LEGACY-EH: remove the `Try` case after deprecating legacy EH.
+  case OpCode::Try:
+  case OpCode::Try_table: {
+    const auto &Try = Instr.getTryCatch();
+    Header.Count = static_cast<uint32_t>(Try.Catch.size());
+    writeImage(OutVec, Header);
+    writeImage(OutVec, Try.ResType);
+    writeImage(OutVec, Try.BlockParamNum);
+    writeImage(OutVec, Try.JumpEnd);
+    for (const auto &Catch : Try.Catch) {
+      writeImage(OutVec, Catch);
+    }
+    break;
+  }
+  default:
+    spdlog::error(ErrCode::Value::IllegalOpCode);
+    spdlog::error(
+        ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
+    return Unexpect(ErrCode::Value::IllegalOpCode);
+  }
+  alignImage(OutVec);
+  return {};
+}
+
+/// Serialize the code section with the function body records.
+Expect<void> serializeImageCode(const AST::CodeSection &Sec,
+                                std::vector<Byte> &OutVec) {
+  // Code section: 0x0A + size:u32 + count:u32 + padding + records. The size
+  // and the count are encoded in 5 bytes to be patched.
+  OutVec.push_back(0x0AU);
+  const size_t SizePos = OutVec.size();
+  OutVec.resize(SizePos + 10);
+  const auto Segs = Sec.getContent();
+  patchU32(OutVec, SizePos + 5, static_cast<uint32_t>(Segs.size()));
+  alignImage(OutVec);
+
+  std::vector<Byte> Payloads;
+  for (const auto &Seg : Segs) {
+    // The lazily loaded function bodies are loaded and validated here.
+    AST::Expression LazyExpr;
+    uint32_t MaxStackHeight = Seg.getMaxStackHeight();
+    AST::InstrView Instrs = Seg.getExpr().getInstrs();
+    if (const auto &Body = Seg.getLazyBody()) {
+      if (auto Res = Body->load(LazyExpr, MaxStackHeight); !Res) {
+        spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Seg_Code));
+        return Unexpect(Res);
+      }
+      Instrs = std::as_const(LazyExpr).getInstrs();
+    }
+
+    ImageCodeHeader Header{};
+    Payloads.clear();
+    for (uint32_t I = 0; I < Instrs.size(); ++I) {
+      if (Instrs[I].isAllocPayload()) {
+        if (auto Res = serializePayload(Instrs[I], I, Payloads); !Res) {
+          spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Seg_Code));
+          return Unexpect(Res);
+        }
+        ++Header.PayloadNum;
+      }
+    }
+    Header.SegSize = Seg.getSegSize();
+    Header.MaxStackHeight = MaxStackHeight;
+    Header.LocalNum = static_cast<uint32_t>(Seg.getLocals().size());
+    Header.InstrNum = static_cast<uint32_t>(Instrs.size());
+    Header.PayloadSize = static_cast<uint32_t>(Payloads.size());
+    writeImage(OutVec, Header);
+    for (const auto &Local : Seg.getLocals()) {
+      writeImage(OutVec, Local.first);
+      writeImage(OutVec, Local.second);
+    }
+    alignImage(OutVec);
+    // The nodes with the out-of-line payloads are rebuilt when loading, so
+    // their pointers are meaningless in the image.
+    const auto *Ptr = reinterpret_cast<const Byte *>(Instrs.data());
+    OutVec.insert(OutVec.end(), Ptr, Ptr + Instrs.size_bytes());
+    OutVec.insert(OutVec.end(), Payloads.begin(), Payloads.end());
+  }
+
+  const size_t Size = OutVec.size() - (SizePos + 5);
+  if (unlikely(Size > UINT32_MAX)) {
+    spdlog::error(ErrCode::Value::LengthOutOfBounds);
+    spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Sec_Code));
+    return Unexpect(ErrCode::Value::LengthOutOfBounds);
+  }
+  patchU32(OutVec, SizePos, static_cast<uint32_t>(Size));
+  return {};
+}
+
+} // namespace
+
+// Serialize module into the module image. See "include/loader/loader.h".
+Expect<std::vector<Byte>> Loader::serializeImage(const AST::Module &Mod) {
+  if (!Mod.getIsValidated()) {
+    spdlog::error(ErrCode::Value::NotValidated);
+    return Unexpect(ErrCode::Value::NotValidated);
+  }
+  if (!Mod.getTagSection().getContent().empty()) {
+    spdlog::error(ErrCode::Value::MalformedSection);
+    spdlog::error("    The tag section is not supported in the module image.");
+    spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Sec_Tag));
+    return Unexpect(ErrCode::Value::MalformedSection);
+  }
+
+  std::vector<Byte> OutVec;
+  ImageHeader Header{};
+  Header.Magic = kImageMagic;
+  Header.Version = kImageVersion;
+  Header.InstrSize = sizeof(AST::Instruction);
+  Header.Proposals = getProposals(Conf);
+  writeImage(OutVec, Header);
+
+  // Serialize the sections in the source order as the serializer.
+  using SecVariant =
+      std::variant<const AST::CustomSection *, const AST::TypeSection *,
+                   const AST::ImportSection *, const AST::FunctionSection *,
+                   const AST::TableSection *, const AST::MemorySection *,
+                   const AST::GlobalSection *, const AST::ExportSection *,
+                   const AST::StartSection *, const AST::ElementSection *,
+                   const AST::CodeSection *, const AST::DataSection *,
+                   const AST::DataCountSection *>;
+  std::vector<SecVariant> Sections;
+  Sections.reserve(Mod.getCustomSections().size() + 12);
+  for (auto &CustomSec : Mod.getCustomSections()) {
+    // The AOT section of the universal WASM is not used by the image.
+    if (CustomSec.getName() != "wasmedge") {
+      Sections.push_back(&CustomSec);
+    }
+  }
+  Sections.push_back(&Mod.getTypeSection());
+  Sections.push_back(&Mod.getImportSection());
+  Sections.push_back(&Mod.getFunctionSection());
+  Sections.push_back(&Mod.getTableSection());
+  Sections.push_back(&Mod.getMemorySection());
+  Sections.push_back(&Mod.getGlobalSection());
+  Sections.push_back(&Mod.getExportSection());
+  Sections.push_back(&Mod.getStartSection());
+  Sections.push_back(&Mod.getElementSection());
+  Sections.push_back(&Mod.getCodeSection());
+  Sections.push_back(&Mod.getDataSection());
+  Sections.push_back(&Mod.getDataCountSection());
+  std::stable_sort(Sections.begin(), Sections.end(), [&](auto &A, auto &B) {
+    auto Getter = [](auto &Sec) { return Sec->getStartOffset(); };
+    return std::visit(Getter, A) < std::visit(Getter, B);
+  });
+
+  for (auto &Sec : Sections) {
+    auto SerVisit = [&OutVec, this](auto &A) -> Expect<void> {
+      using T = std::decay_t<decltype(*A)>;
+      if constexpr (std::is_same_v<T, AST::CodeSection>) {
+        if (A->getContent().empty()) {
+          return {};
+        }
+        return serializeImageCode(*A, OutVec);
+      } else {
+        return Ser.serializeSection(*A, OutVec);
+      }
+    };
+    if (auto Res = std::visit(SerVisit, Sec); !Res) {
+      spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Module));
+      return Unexpect(Res);
+    }
+  }
+  return OutVec;
+}
+
+// Load module from the module image. See "include/loader/loader.h".
+Expect<std::unique_ptr<AST::Module>> Loader::loadImage() {
+  ImageHeader Header;
+  if (auto Res = FMgr.readBytesView(sizeof(Header))) {
+    std::memcpy(&Header, Res->data(), sizeof(Header));
+  } else {
+    return logLoadError(Res.error(), FMgr.getLastOffset(), ASTNodeAttr::Module);
+  }
+  if (Header.Version != kImageVersion ||
+      Header.InstrSize != sizeof(AST::Instruction)) {
+    spdlog::error(ErrCode::Value::MalformedVersion);
+    spdlog::error("    The module image is built by the other version.");
+    return Unexpect(ErrCode::Value::MalformedVersion);
+  }
+  if (Header.Proposals != getProposals(Conf)) {
+    spdlog::error(ErrCode::Value::MalformedVersion);
+    spdlog::error(
+        "    The module image is validated with the other proposals.");
+    return Unexpect(ErrCode::Value::MalformedVersion);
+  }
+
+  auto Mod = std::make_unique<AST::Module>();
+  Mod->getMagic() = {0x00, 0x61, 0x73, 0x6D};
+  Mod->getVersion() = ModuleVersion;
+  if (auto Res = loadModule(*Mod); !Res) {
+    return Unexpect(Res);
+  }
+  return Mod;
+}
+
+// Load the code section of the module image. See "include/loader/loader.h".
+Expect<void> Loader::loadImageCode(AST::CodeSection &Sec) {
+  return loadSectionContent(Sec, [this, &Sec]() -> Expect<void> {
+    auto &CodeVec = Sec.getContent();
+    if (auto Res = loadVecCnt()) {
+      CodeVec.resize(*Res);
+    } else {
+      return logLoadError(Res.error(), FMgr.getLastOffset(),
+                          ASTNodeAttr::Sec_Code);
+    }
+    // Skip the padding before the aligned records.
+    if (auto Res = FMgr.readBytesView(getPadding(FMgr.getOffset())); !Res) {
+      return logLoadError(Res.error(), FMgr.getLastOffset(),
+                          ASTNodeAttr::Sec_Code);
+    }
+    for (auto &CodeSeg : CodeVec) {
+      if (auto Res = loadImageSegment(CodeSeg); !Res) {
+        spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Sec_Code));
+        return Unexpect(Res);
+      }
+    }
+    return {};
+  });
+}
+
+// Load the function body record. See "include/loader/loader.h".
+Expect<void> Loader::loadImageSegment(AST::CodeSegment &CodeSeg) {
+  const uint64_t StartOffset = FMgr.getOffset();
+  auto ReadAligned = [this](uint64_t Size) -> Expect<Span<const Byte>> {
+    if (unlikely(Size > FMgr.getRemainSize())) {
+      return Unexpect(ErrCode::Value::UnexpectedEnd);
+    }
+    auto Res = FMgr.readBytesView(static_cast<size_t>(Size));
+    if (Res) {
+      if (auto Pad = FMgr.readBytesView(getPadding(FMgr.getOffset())); !Pad) {
+        return Unexpect(Pad);
+      }
+    }
+    return Res;
+  };
+
+  // Read the header and the locals.
+  ImageCodeHeader Header;
+  if (auto Res = ReadAligned(sizeof(Header))) {
+    std::memcpy(&Header, Res->data(), sizeof(Header));
+  } else {
+    return logLoadError(Res.error(), FMgr.getLastOffset(),
+                        ASTNodeAttr::Seg_Code);
+  }
+  CodeSeg.setSegSize(Header.SegSize);
+  CodeSeg.setMaxStackHeight(Header.MaxStackHeight);
+  if (auto Res = ReadAligned(Header.LocalNum * kLocalSize)) {
+    auto &Locals = CodeSeg.getLocals();
+    Locals.resize(Header.LocalNum);
+    for (uint32_t I = 0; I < Header.LocalNum; ++I) {
+      const Byte *Ptr = Res->data() + I * kLocalSize;
+      std::memcpy(&Locals[I].first, Ptr, sizeof(uint32_t));
+      std::memcpy(&Locals[I].second, Ptr + sizeof(uint32_t), sizeof(ValType));
+    }
+  } else {
+    return logLoadError(Res.error(), FMgr.getLastOffset(),
+                        ASTNodeAttr::Seg_Code);
+  }
+
+  // Read the instruction records and the payloads.
+  Span<const Byte> Records;
+  Span<const Byte> Payloads;
+  if (auto Res = ReadAligned(uint64_t(Header.InstrNum) *
+                             sizeof(AST::Instruction))) {
+    Records = *Res;
+  } else {
+    return logLoadError(Res.error(), FMgr.getLastOffset(),
+                        ASTNodeAttr::Seg_Code);
+  }
+  if (auto Res = ReadAligned(Header.PayloadSize)) {
+    Payloads = *Res;
+  } else {
+    return logLoadError(Res.error(), FMgr.getLastOffset(),
+                        ASTNodeAttr::Seg_Code);
+  }
+  if (unlikely(Header.InstrNum == 0)) {
+    return logLoadError(ErrCode::Value::MalformedSection, StartOffset,
+                        ASTNodeAttr::Seg_Code);
+  }
+
+  // Reference the instruction records in place if they are in the mapped file
+  // and have no out-of-line payloads.
+  auto Holder = FMgr.getDataHolder();
+  if (Header.PayloadNum == 0 && Holder &&
+      reinterpret_cast<uintptr_t>(Records.data()) % kImageAlign == 0) {
+    CodeSeg.getExpr().setInstrs(
+        AST::InstrView(
+            reinterpret_cast<const AST::Instruction *>(Records.data()),
+            Header.InstrNum),
+        std::move(Holder));
+    return {};
+  }
+
+  // Otherwise, rebuild the instructions with the payloads.
+  size_t PayloadPos = 0;
+  auto ReadPayload = [&](void *Dst, uint64_t Size) noexcept {
+    if (Payloads.size() - PayloadPos < Size) {
+      return false;
+    }
+    std::memcpy(Dst, Payloads.data() + PayloadPos, static_cast<size_t>(Size));
+    PayloadPos += static_cast<size_t>(Size);
+    return true;
+  };
+  auto ReadInstr = [&](AST::Instruction &Instr) noexcept {
+    ImagePayloadHeader PHeader;
+    if (!ReadPayload(&PHeader, sizeof(PHeader))) {
+      return false;
+    }
+    const uint64_t Count = PHeader.Count;
+    Instr = AST::Instruction(PHeader.Code, PHeader.Offset);
+    Instr.setMeterLeader(PHeader.IsMeterLeader);
+    Instr.setMeterSync(PHeader.IsMeterSync);
+    bool Succeeded = false;
+    switch (PHeader.Code) {
+    case OpCode::Br_table: {
+      const uint64_t Size = Count * sizeof(AST::Instruction::JumpDescriptor);
+      if (Count > 0 && Size <= Payloads.size() - PayloadPos) {
+        Instr.setLabelListSize(PHeader.Count);
+        Succeeded = ReadPayload(Instr.getLabelList().data(), Size);
+      }
+      break;
+    }
+    case OpCode::Select_t: {
+      const uint64_t Size = Count * sizeof(ValType);
+      if (Count > 0 && Size <= Payloads.size() - PayloadPos) {
+        Instr.setValTypeListSize(PHeader.Count);
+        Succeeded = ReadPayload(Instr.getValTypeList().data(), Size);
+      }
+      break;
+    }
+    case OpCode::Br_on_cast:
+    case OpCode::Br_on_cast_fail:
+      Instr.setBrCast(0);
+      Succeeded = ReadPayload(&Instr.getBrCast(),
+                              sizeof(AST::Instruction::BrCastDescriptor));
+      break;
+    // LEGACY-EH: remove the `Try` case after deprecating legacy EH.
+    case OpCode::Try:
+    case OpCode::Try_table: {
+      Instr.setTryCatch();
+      auto &Try = Instr.getTryCatch();
+      const uint64_t Size = Count * sizeof(AST::Instruction::CatchDescriptor);
+      if (ReadPayload(&Try.ResType, sizeof(Try.ResType)) &&
+          ReadPayload(&Try.BlockParamNum, sizeof(Try.BlockParamNum)) &&
+          ReadPayload(&Try.JumpEnd, sizeof(Try.JumpEnd)) &&
+          Size <= Payloads.size() - PayloadPos) {
+        Try.Catch.resize(PHeader.Count);
+        Succeeded = ReadPayload(Try.Catch.data(), Size);
+      }
+      break;
+    }
+    default:
+      break;
+    }
+    PayloadPos = std::min<size_t>(PayloadPos + getPadding(PayloadPos),
+                                  Payloads.size());
+    return Succeeded;
+  };
+
+  // The rebuilt instructions are kept alive by the holder as the referenced
+  // ones, which are validated when the image was created.
+  auto Instrs = std::make_shared<AST::InstrVec>();
+  Instrs->reserve(Header.InstrNum);
+  const auto *Ptr = Records.data();
+  uint32_t PayloadNum = 0;
+  for (uint32_t I = 0; I < Header.InstrNum; ++I) {
+    auto &Instr = Instrs->emplace_back(OpCode::End);
+    if (PayloadNum < Header.PayloadNum &&
+        Payloads.size() - PayloadPos >= sizeof(uint32_t) &&
+        std::memcmp(Payloads.data() + PayloadPos, &I, sizeof(uint32_t)) == 0) {
+      if (!ReadInstr(Instr)) {
+        return logLoadError(ErrCode::Value::MalformedSection,
+                            FMgr.getLastOffset(), ASTNodeAttr::Seg_Code);
+      }
+      ++PayloadNum;
+    } else {
+      std::memcpy(static_cast<void *>(&Instr), Ptr + I * sizeof(Instr),
+                  sizeof(Instr));
+    }
+  }
+  if (unlikely(PayloadNum != Header.PayloadNum ||
+               PayloadPos != Payloads.size())) {
+    return logLoadError(ErrCode::Value::MalformedSection, FMgr.getLastOffset(),
+                        ASTNodeAttr::Seg_Code);
+  }
+  CodeSeg.getExpr().setInstrs(*Instrs, Instrs);
+  return {};
+}
+
+} // namespace Loader
+} // namespace WasmEdge
@@ -128,6 +128,16 @@ Loader::parseWasmUnit(const std::filesystem::path &FilePath) {
     }
     return Mod;
   }
+  case FileMgr::FileHeader::Image: {
+    // Pre-decoded module image. The function bodies reference the mapped file.
+    WASMType = InputType::Image;
+    auto Mod = loadImage();
+    if (!Mod) {
+      spdlog::error(ErrInfo::InfoFile(FilePath));
+      return Unexpect(Mod);
+    }
+    return std::move(*Mod);
+  }
   default:
     // Universal WASM, WASM, or other cases. Load and parse the module directly.
     WASMType = InputType::WASM;
@@ -176,6 +186,16 @@ Loader::parseWasmUnit(Span<const uint8_t> Code) {
         "from memory. Please use the universal WASM binary or pure WASM, or "
         "load the AOT compiled WASM shared library from file.");
     return Unexpect(ErrCode::Value::MalformedMagic);
+  case FileMgr::FileHeader::Image: {
+    // Pre-decoded module image. The function bodies are copied from the
+    // buffer, which is owned by the caller.
+    WASMType = InputType::Image;
+    auto Mod = loadImage();
+    if (!Mod) {
+      return Unexpect(Mod);
+    }
+    return std::move(*Mod);
+  }
   default:
     break;
   }
@@ -184,6 +204,45 @@ Loader::parseWasmUnit(Span<const uint8_t> Code) {
   return loadUnit();
 }
 
+Expect<std::variant<std::unique_ptr<AST::Component::Component>,
+                    std::unique_ptr<AST::Module>>>
+Loader::parseWasmUnit(FileMgr::StreamReader Reader) {
+  std::lock_guard Lock(Mutex);
+  if (auto Res = FMgr.setStream(std::move(Reader)); !Res) {
+    return Unexpect(Res);
+  }
+  switch (FMgr.getHeaderType()) {
+  // Filter out the Windows .dll, MacOS .dylib, or Linux .so AOT compiled
+  // shared-library-WASM.
+  case FileMgr::FileHeader::ELF:
+  case FileMgr::FileHeader::DLL:
+  case FileMgr::FileHeader::MachO_32:
+  case FileMgr::FileHeader::MachO_64:
+    spdlog::error("Might an invalid wasm file");
+    spdlog::error(ErrCode::Value::MalformedMagic);
+    spdlog::error(
+        "    The AOT compiled WASM shared library is not supported for loading "
+        "from stream. Please use the universal WASM binary or pure WASM, or "
+        "load the AOT compiled WASM shared library from file.");
+    FMgr.reset();
+    return Unexpect(ErrCode::Value::MalformedMagic);
+  case FileMgr::FileHeader::Image:
+    spdlog::error(ErrCode::Value::MalformedMagic);
+    spdlog::error("    The module image is not supported for loading from "
+                  "stream. Please load the module image from file or memory.");
+    FMgr.reset();
+    return Unexpect(ErrCode::Value::MalformedMagic);
+  default:
+    break;
+  }
+  // For malformed header checking, handle in the module loading.
+  WASMType = InputType::WASM;
+  auto Unit = loadUnit();
+  // Release the reader and the received data.
+  FMgr.reset();
+  return Unit;
+}
+
 // Parse module from file path. See "include/loader/loader.h".
 Expect<std::unique_ptr<AST::Module>>
 Loader::parseModule(const std::filesystem::path &FilePath) {
@@ -210,6 +269,19 @@ Loader::parseModule(Span<const uint8_t> Code) {
   }
 }
 
+// Parse module from streaming source. See "include/loader/loader.h".
+Expect<std::unique_ptr<AST::Module>>
+Loader::parseModule(FileMgr::StreamReader Reader) {
+  if (auto R = parseWasmUnit(std::move(Reader))) {
+    if (std::holds_alternative<std::unique_ptr<AST::Module>>(*R)) {
+      return std::move(std::get<std::unique_ptr<AST::Module>>(*R));
+    }
+    return Unexpect(ErrCode::Value::MalformedVersion);
+  } else {
+    return Unexpect(R);
+  }
+}
+
 // Serialize module into byte code. See "include/loader/loader.h".
 Expect<std::vector<Byte>> Loader::serializeModule(const AST::Module &Mod) {
   return Ser.serializeModule(Mod);
@@ -7,6 +7,10 @@
 #include "common/defines.h"
 #include "common/errcode.h"
 
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
 #if WASMEDGE_OS_WINDOWS
 #include "system/winapi.h"
 #elif defined(HAVE_MMAP) && defined(__x86_64__) || defined(__aarch64__) ||     \
@@ -29,38 +33,124 @@ static inline constexpr const uint64_t kPageSize = UINT64_C(65536);
 // -Wunused-const-variable error when applying -Werror.
 static inline constexpr const uint64_t k4G = UINT64_C(0x100000000);
 static inline constexpr const uint64_t k12G = UINT64_C(0x300000000);
-#endif
-
-} // namespace
 
-WASMEDGE_EXPORT uint8_t *Allocator::allocate(uint32_t PageCount) noexcept {
+/// Reserve a 12GiB inaccessible region, and return the memory start at the
+/// 4GiB offset of it.
+uint8_t *reserve() noexcept {
 #if WASMEDGE_OS_WINDOWS
   auto Reserved = reinterpret_cast<uint8_t *>(winapi::VirtualAlloc(
       nullptr, k12G, winapi::MEM_RESERVE_, winapi::PAGE_NOACCESS_));
   if (Reserved == nullptr) {
     return nullptr;
   }
+#else
+  auto Reserved = reinterpret_cast<uint8_t *>(
+      mmap(nullptr, k12G, PROT_NONE,
+           MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0));
+  if (Reserved == MAP_FAILED) {
+    return nullptr;
+  }
+#endif
+  return Reserved + k4G;
+}
+
+void unreserve(uint8_t *Pointer) noexcept {
+#if WASMEDGE_OS_WINDOWS
+  winapi::VirtualFree(Pointer - k4G, 0, winapi::MEM_RELEASE_);
+#else
+  munmap(Pointer - k4G, k12G);
+#endif
+}
+
+/// Drop the pages of the memory and make them inaccessible again, so the
+/// reservation is the same as a newly reserved one.
+bool reset(uint8_t *Pointer, uint32_t PageCount) noexcept {
   if (PageCount == 0) {
-    return Reserved + k4G;
+    return true;
   }
-  auto Pointer = resize(Reserved + k4G, 0, PageCount);
+  const uint64_t Size = PageCount * kPageSize;
+#if WASMEDGE_OS_WINDOWS
+  return winapi::VirtualFree(Pointer, Size, winapi::MEM_DECOMMIT_) != 0;
+#else
+  return madvise(Pointer, Size, MADV_DONTNEED) == 0 &&
+         mprotect(Pointer, Size, PROT_NONE) == 0;
+#endif
+}
+
+/// Pool of the released reservations. The memory instances are created and
+/// destroyed frequently, and reusing the reservations avoids the mapping
+/// changes and the TLB shootdowns of unmapping the whole 12GiB regions.
+struct ReservationPool {
+  std::mutex Mutex;
+  std::vector<uint8_t *> Idle;
+  uint32_t Capacity = 0;
+  uint64_t Live = 0;
+  uint64_t HighWater = 0;
+  uint64_t Reused = 0;
+};
+
+ReservationPool &getPool() noexcept {
+  // Never destroyed, because the memory instances may be released during the
+  // static destruction.
+  static ReservationPool &Pool = *new ReservationPool;
+  return Pool;
+}
+
+uint8_t *acquire() noexcept {
+  auto &Pool = getPool();
+  {
+    std::unique_lock Lock(Pool.Mutex);
+    Pool.Live++;
+    Pool.HighWater = std::max(Pool.HighWater, Pool.Live);
+    if (!Pool.Idle.empty()) {
+      auto Pointer = Pool.Idle.back();
+      Pool.Idle.pop_back();
+      Pool.Reused++;
+      return Pointer;
+    }
+  }
+  auto Pointer = reserve();
   if (Pointer == nullptr) {
-    return nullptr;
+    std::unique_lock Lock(Pool.Mutex);
+    Pool.Live--;
   }
   return Pointer;
-#elif defined(HAVE_MMAP) && defined(__x86_64__) || defined(__aarch64__) ||     \
-    (defined(__riscv) && __riscv_xlen == 64)
-  auto Reserved = reinterpret_cast<uint8_t *>(
-      mmap(nullptr, k12G, PROT_NONE,
-           MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0));
-  if (Reserved == MAP_FAILED) {
+}
+
+void recycle(uint8_t *Pointer, uint32_t PageCount) noexcept {
+  auto &Pool = getPool();
+  bool Keep;
+  {
+    std::unique_lock Lock(Pool.Mutex);
+    Pool.Live--;
+    Keep = Pool.Idle.size() < Pool.Capacity;
+  }
+  if (Keep && reset(Pointer, PageCount)) {
+    std::unique_lock Lock(Pool.Mutex);
+    if (Pool.Idle.size() < Pool.Capacity) {
+      Pool.Idle.push_back(Pointer);
+      return;
+    }
+  }
+  unreserve(Pointer);
+}
+#endif
+
+} // namespace
+
+WASMEDGE_EXPORT uint8_t *Allocator::allocate(uint32_t PageCount) noexcept {
+#if WASMEDGE_OS_WINDOWS || defined(HAVE_MMAP) && defined(__x86_64__) ||        \
+    defined(__aarch64__) || (defined(__riscv) && __riscv_xlen == 64)
+  auto Reserved = acquire();
+  if (Reserved == nullptr) {
     return nullptr;
   }
   if (PageCount == 0) {
-    return Reserved + k4G;
+    return Reserved;
   }
-  auto Pointer = resize(Reserved + k4G, 0, PageCount);
+  auto Pointer = resize(Reserved, 0, PageCount);
   if (Pointer == nullptr) {
+    recycle(Reserved, 0);
     return nullptr;
   }
   return Pointer;
@@ -77,7 +167,27 @@ WASMEDGE_EXPORT uint8_t *Allocator::allocate(uint32_t PageCount) noexcept {
 WASMEDGE_EXPORT uint8_t *Allocator::resize(uint8_t *Pointer,
                                            uint32_t OldPageCount,
                                            uint32_t NewPageCount) noexcept {
-  assuming(NewPageCount > OldPageCount);
+  assuming(NewPageCount != OldPageCount);
+  if (NewPageCount < OldPageCount) {
+    // Drop the pages out of the new size. They are zero-filled when growing
+    // again.
+#if WASMEDGE_OS_WINDOWS
+    if (winapi::VirtualFree(Pointer + NewPageCount * kPageSize,
+                            (OldPageCount - NewPageCount) * kPageSize,
+                            winapi::MEM_DECOMMIT_) == 0) {
+      return nullptr;
+    }
+#elif defined(HAVE_MMAP) && defined(__x86_64__) || defined(__aarch64__) ||     \
+    (defined(__riscv) && __riscv_xlen == 64)
+    if (mmap(Pointer + NewPageCount * kPageSize,
+             (OldPageCount - NewPageCount) * kPageSize, PROT_NONE,
+             MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED, -1,
+             0) == MAP_FAILED) {
+      return nullptr;
+    }
+#endif
+    return Pointer;
+  }
 #if WASMEDGE_OS_WINDOWS
   if (winapi::VirtualAlloc(Pointer + OldPageCount * kPageSize,
                            (NewPageCount - OldPageCount) * kPageSize,
@@ -106,20 +216,84 @@ WASMEDGE_EXPORT uint8_t *Allocator::resize(uint8_t *Pointer,
 #endif
 }
 
-WASMEDGE_EXPORT void Allocator::release(uint8_t *Pointer, uint32_t) noexcept {
-#if WASMEDGE_OS_WINDOWS
-  winapi::VirtualFree(Pointer - k4G, 0, winapi::MEM_RELEASE_);
-#elif defined(HAVE_MMAP) && defined(__x86_64__) || defined(__aarch64__) ||     \
-    (defined(__riscv) && __riscv_xlen == 64)
+WASMEDGE_EXPORT void
+Allocator::release(uint8_t *Pointer,
+                   uint32_t PageCount [[maybe_unused]]) noexcept {
+#if WASMEDGE_OS_WINDOWS || defined(HAVE_MMAP) && defined(__x86_64__) ||        \
+    defined(__aarch64__) || (defined(__riscv) && __riscv_xlen == 64)
   if (Pointer == nullptr) {
     return;
   }
-  munmap(Pointer - k4G, k12G);
+  recycle(Pointer, PageCount);
 #else
   return std::free(Pointer);
 #endif
 }
 
+void Allocator::set_pool_capacity(uint32_t Capacity) noexcept {
+#if WASMEDGE_OS_WINDOWS || defined(HAVE_MMAP) && defined(__x86_64__) ||        \
+    defined(__aarch64__) || (defined(__riscv) && __riscv_xlen == 64)
+  auto &Pool = getPool();
+  std::vector<uint8_t *> Evicted;
+  uint32_t Missing = 0;
+  {
+    std::unique_lock Lock(Pool.Mutex);
+    Pool.Capacity = Capacity;
+    if (Pool.Idle.size() > Capacity) {
+      Evicted.assign(Pool.Idle.begin() + Capacity, Pool.Idle.end());
+      Pool.Idle.resize(Capacity);
+    } else {
+      Missing = Capacity - static_cast<uint32_t>(Pool.Idle.size());
+    }
+  }
+  for (auto Pointer : Evicted) {
+    unreserve(Pointer);
+  }
+  // Reserve the slots in advance, so the first instances are also served by
+  // the pool.
+  for (uint32_t I = 0; I < Missing; ++I) {
+    auto Pointer = reserve();
+    if (Pointer == nullptr) {
+      break;
+    }
+    std::unique_lock Lock(Pool.Mutex);
+    if (Pool.Idle.size() >= Pool.Capacity) {
+      Lock.unlock();
+      unreserve(Pointer);
+      break;
+    }
+    Pool.Idle.push_back(Pointer);
+  }
+#else
+  (void)Capacity;
+#endif
+}
+
+Allocator::PoolStatistics Allocator::get_pool_statistics() noexcept {
+  PoolStatistics Stat;
+#if WASMEDGE_OS_WINDOWS || defined(HAVE_MMAP) && defined(__x86_64__) ||        \
+    defined(__aarch64__) || (defined(__riscv) && __riscv_xlen == 64)
+  auto &Pool = getPool();
+  std::unique_lock Lock(Pool.Mutex);
+  Stat.Capacity = Pool.Capacity;
+  Stat.Idle = static_cast<uint32_t>(Pool.Idle.size());
+  Stat.Live = Pool.Live;
+  Stat.HighWater = Pool.HighWater;
+  Stat.Reused = Pool.Reused;
+#endif
+  return Stat;
+}
+
+bool Allocator::has_guard_region() noexcept {
+#if WASMEDGE_OS_WINDOWS || defined(HAVE_MMAP) && defined(__x86_64__) ||        \
+    defined(__aarch64__) || (defined(__riscv) && __riscv_xlen == 64)
+  // The memory is at the 4GiB offset of the 12GiB reserved region.
+  return true;
+#else
+  return false;
+#endif
+}
+
 uint8_t *Allocator::allocate_chunk(uint64_t Size) noexcept {
 #if WASMEDGE_OS_WINDOWS
   if (auto Pointer = winapi::VirtualAlloc(nullptr, Size, winapi::MEM_COMMIT_,
@@ -190,4 +364,17 @@ bool Allocator::set_chunk_readable_writable(uint8_t *Pointer,
 #endif
 }
 
+bool Allocator::set_chunk_inaccessible(uint8_t *Pointer,
+                                       uint64_t Size) noexcept {
+#if WASMEDGE_OS_WINDOWS
+  winapi::DWORD_ OldPerm;
+  return winapi::VirtualProtect(Pointer, Size, winapi::PAGE_NOACCESS_,
+                                &OldPerm) != 0;
+#elif defined(HAVE_MMAP)
+  return mprotect(Pointer, Size, PROT_NONE) == 0;
+#else
+  return true;
+#endif
+}
+
 } // namespace WasmEdge
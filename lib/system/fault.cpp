@@ -103,13 +103,17 @@ void decreaseHandler() noexcept {
 
 } // namespace
 
-Fault::Fault() {
+Fault::Fault(bool HandleSignal) : HandleSignal(HandleSignal) {
   Prev = std::exchange(localHandler, this);
-  increaseHandler();
+  if (HandleSignal) {
+    increaseHandler();
+  }
 }
 
 Fault::~Fault() noexcept {
-  decreaseHandler();
+  if (HandleSignal) {
+    decreaseHandler();
+  }
   localHandler = std::exchange(Prev, nullptr);
 }
 
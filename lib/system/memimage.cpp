@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "system/memimage.h"
+
+#include "common/config.h"
+#include "common/defines.h"
+#include "system/allocator.h"
+
+#if WASMEDGE_OS_LINUX && defined(HAVE_MMAP)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace WasmEdge {
+
+#if WASMEDGE_OS_LINUX && defined(HAVE_MMAP)
+MemoryImage::MemoryImage(uint64_t S) noexcept {
+  File = memfd_create("wasmedge-memory-image", MFD_CLOEXEC);
+  if (File < 0) {
+    return;
+  }
+  if (ftruncate(File, static_cast<off_t>(S)) != 0) {
+    close(File);
+    File = -1;
+    return;
+  }
+  Size = S;
+}
+
+MemoryImage::MemoryImage(const std::filesystem::path &Path, uint64_t O,
+                         uint64_t S) noexcept {
+  File = open(Path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (File < 0) {
+    return;
+  }
+  // The pages out of the file could not be accessed through the mapping.
+  struct stat Stat;
+  if (fstat(File, &Stat) != 0 || static_cast<uint64_t>(Stat.st_size) < O ||
+      static_cast<uint64_t>(Stat.st_size) - O < S) {
+    close(File);
+    File = -1;
+    return;
+  }
+  FileOffset = O;
+  Size = S;
+}
+
+MemoryImage::~MemoryImage() noexcept {
+  if (File >= 0) {
+    close(File);
+  }
+}
+
+bool MemoryImage::ok() const noexcept { return File >= 0; }
+
+bool MemoryImage::write(uint64_t Offset, Span<const Byte> Data) noexcept {
+  if (Offset > Size || Data.size() > Size - Offset) {
+    return false;
+  }
+  while (!Data.empty()) {
+    const auto Written =
+        pwrite(File, Data.data(), Data.size(), static_cast<off_t>(Offset));
+    if (Written <= 0) {
+      return false;
+    }
+    Offset += static_cast<uint64_t>(Written);
+    Data = Data.subspan(static_cast<size_t>(Written));
+  }
+  return true;
+}
+
+bool MemoryImage::read(uint64_t Offset, Span<Byte> Data) const noexcept {
+  if (Offset > Size || Data.size() > Size - Offset) {
+    return false;
+  }
+  while (!Data.empty()) {
+    const auto Read = pread(File, Data.data(), Data.size(),
+                            static_cast<off_t>(FileOffset + Offset));
+    if (Read <= 0) {
+      return false;
+    }
+    Offset += static_cast<uint64_t>(Read);
+    Data = Data.subspan(static_cast<size_t>(Read));
+  }
+  return true;
+}
+
+bool MemoryImage::map(uint8_t *Pointer) const noexcept {
+  if (Size == 0) {
+    return true;
+  }
+  return mmap(Pointer, Size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED,
+              File, static_cast<off_t>(FileOffset)) != MAP_FAILED;
+}
+
+bool MemoryImage::supported() noexcept {
+  // The image can only be mapped into the memories reserved by mmap.
+  return Allocator::has_guard_region();
+}
+#else
+MemoryImage::MemoryImage(uint64_t) noexcept {}
+MemoryImage::MemoryImage(const std::filesystem::path &, uint64_t,
+                         uint64_t) noexcept {}
+MemoryImage::~MemoryImage() noexcept {}
+bool MemoryImage::ok() const noexcept { return File >= 0; }
+bool MemoryImage::write(uint64_t, Span<const Byte>) noexcept { return false; }
+bool MemoryImage::read(uint64_t, Span<Byte>) const noexcept { return false; }
+bool MemoryImage::map(uint8_t *) const noexcept { return false; }
+bool MemoryImage::supported() noexcept { return false; }
+#endif
+
+} // namespace WasmEdge
@@ -28,6 +28,7 @@ auto logOutOfRange(ErrCode Code, ErrInfo::IndexCategory Cate, uint32_t Idx,
 
 void FormChecker::reset(bool CleanGlobal) {
   ValStack.clear();
+  MaxStackHeight = 0;
   CtrlStack.clear();
   Locals.clear();
   Returns.clear();
@@ -2274,7 +2275,11 @@ Expect<void> FormChecker::checkInstr(const AST::Instruction &Instr) {
   }
 }
 
-void FormChecker::pushType(VType V) { ValStack.emplace_back(V); }
+void FormChecker::pushType(VType V) {
+  ValStack.emplace_back(V);
+  MaxStackHeight =
+      std::max(MaxStackHeight, static_cast<uint32_t>(ValStack.size()));
+}
 
 void FormChecker::pushTypes(Span<const VType> Input) {
   for (auto Val : Input) {
@@ -5,15 +5,88 @@
 
 #include "common/errinfo.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <memory>
 #include <numeric>
 #include <string>
+#include <thread>
 #include <unordered_set>
 #include <vector>
 
 namespace WasmEdge {
 namespace Validator {
 
+namespace {
+// The module contexts to validate the lazily loaded function bodies, which own
+// the copies of the types to outlive the AST module.
+struct LazyContext {
+  LazyContext(const FormChecker &ModuleChecker) : Checker(ModuleChecker) {
+    // Clear the states of the last validated function.
+    Checker.reset();
+    auto &TypeVec = Checker.getTypes();
+    Types.reserve(TypeVec.size());
+    for (const auto *Type : TypeVec) {
+      Types.push_back(*Type);
+    }
+    for (size_t I = 0; I < TypeVec.size(); ++I) {
+      TypeVec[I] = &Types[I];
+    }
+  }
+  std::vector<AST::SubType> Types;
+  FormChecker Checker;
+};
+
+// The lazily loaded function body which is validated after decoded.
+class LazyValidatedBody : public AST::LazyFunctionBody {
+public:
+  LazyValidatedBody(std::shared_ptr<const LazyContext> Context,
+                    std::shared_ptr<const AST::LazyFunctionBody> Body,
+                    const uint32_t TypeIdx,
+                    Span<const std::pair<uint32_t, ValType>> Locals)
+      : Context(std::move(Context)), Body(std::move(Body)), TypeIdx(TypeIdx),
+        Locals(Locals.begin(), Locals.end()) {}
+
+  const std::shared_ptr<const AST::LazyFunctionBody> &getBody() const noexcept {
+    return Body;
+  }
+
+  Expect<void> load(AST::Expression &Expr,
+                    uint32_t &MaxStackHeight) const override {
+    if (auto Res = Body->load(Expr, MaxStackHeight); !Res) {
+      return Unexpect(Res);
+    }
+    FormChecker Checker = Context->Checker;
+    const auto &FuncType =
+        Checker.getTypes()[TypeIdx]->getCompositeType().getFuncType();
+    for (auto &Type : FuncType.getParamTypes()) {
+      Checker.addLocal(Type, true);
+    }
+    for (auto &Val : Locals) {
+      for (uint32_t Cnt = 0; Cnt < Val.first; ++Cnt) {
+        Checker.addLocal(Val.second, false);
+      }
+    }
+    if (auto Res =
+            Checker.validate(Expr.getInstrs(), FuncType.getReturnTypes());
+        !Res) {
+      spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Expression));
+      spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Seg_Code));
+      return Unexpect(Res);
+    }
+    MaxStackHeight = Checker.getMaxStackHeight();
+    return {};
+  }
+
+private:
+  const std::shared_ptr<const LazyContext> Context;
+  const std::shared_ptr<const AST::LazyFunctionBody> Body;
+  const uint32_t TypeIdx;
+  const std::vector<std::pair<uint32_t, ValType>> Locals;
+};
+} // namespace
+
 Expect<void> Validator::validate(const AST::Component::Component &Comp) {
   using namespace AST::Component;
 
@@ -356,35 +429,50 @@ Expect<void> Validator::validate(const AST::ElementSegment &ElemSeg) {
 
 // Validate Code segment. See "include/validator/validator.h".
 Expect<void> Validator::validate(const AST::CodeSegment &CodeSeg,
-                                 const uint32_t TypeIdx) {
+                                 const uint32_t TypeIdx,
+                                 FormChecker &CodeChecker) {
+  // The function bodies loaded from the module image are validated with the
+  // same proposals when creating the image, and may be read-only.
+  if (CodeSeg.getExpr().getInstrsHolder()) {
+    return {};
+  }
   // Due to the validation of the function section, the type of index bust be a
   // function type.
   const auto &FuncType =
-      Checker.getTypes()[TypeIdx]->getCompositeType().getFuncType();
+      CodeChecker.getTypes()[TypeIdx]->getCompositeType().getFuncType();
   // Reset stack in FormChecker.
-  Checker.reset();
+  CodeChecker.reset();
   // Add parameters into this frame.
   for (auto &Type : FuncType.getParamTypes()) {
     // Local passed as function parameters should be initialized.
-    Checker.addLocal(Type, true);
+    CodeChecker.addLocal(Type, true);
   }
   // Add locals into this frame.
   for (auto Val : CodeSeg.getLocals()) {
     for (uint32_t Cnt = 0; Cnt < Val.first; ++Cnt) {
       // The local value type should be valid.
-      if (auto Res = Checker.validate(Val.second); !Res) {
+      if (auto Res = CodeChecker.validate(Val.second); !Res) {
         return Unexpect(Res);
       }
-      Checker.addLocal(Val.second, false);
+      CodeChecker.addLocal(Val.second, false);
     }
   }
+  // The function body expression is validated on demand in the lazy loading
+  // mode.
+  if (CodeSeg.getLazyBody()) {
+    return {};
+  }
   // Validate function body expression.
-  if (auto Res = Checker.validate(CodeSeg.getExpr().getInstrs(),
-                                  FuncType.getReturnTypes());
+  if (auto Res = CodeChecker.validate(CodeSeg.getExpr().getInstrs(),
+                                      FuncType.getReturnTypes());
       !Res) {
     spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Expression));
     return Unexpect(Res);
   }
+  // Record the maximum value stack height for reserving the stack when
+  // entering this function.
+  const_cast<AST::CodeSegment &>(CodeSeg).setMaxStackHeight(
+      CodeChecker.getMaxStackHeight());
   return {};
 }
 
@@ -671,21 +759,96 @@ Expect<void> Validator::validate(const AST::ElementSection &ElemSec) {
 Expect<void> Validator::validate(const AST::CodeSection &CodeSec) {
   const auto &CodeVec = CodeSec.getContent();
   const auto &FuncVec = Checker.getFunctions();
+  const auto CodeNum = static_cast<uint32_t>(CodeVec.size());
 
-  // Validate function body.
-  for (uint32_t Id = 0; Id < static_cast<uint32_t>(CodeVec.size()); ++Id) {
-    // Added functions contains imported functions.
-    uint32_t TId = Id + static_cast<uint32_t>(Checker.getNumImportFuncs());
-    if (TId >= static_cast<uint32_t>(FuncVec.size())) {
-      spdlog::error(ErrCode::Value::InvalidFuncIdx);
-      spdlog::error(
-          ErrInfo::InfoForbidIndex(ErrInfo::IndexCategory::Function, TId,
-                                   static_cast<uint32_t>(FuncVec.size())));
-      return Unexpect(ErrCode::Value::InvalidFuncIdx);
+  // Added functions contains imported functions.
+  const auto NumImportFuncs =
+      static_cast<uint32_t>(Checker.getNumImportFuncs());
+  if (CodeNum > 0 &&
+      CodeNum - 1 + NumImportFuncs >= static_cast<uint32_t>(FuncVec.size())) {
+    const uint32_t TId =
+        std::max(static_cast<uint32_t>(FuncVec.size()), NumImportFuncs);
+    spdlog::error(ErrCode::Value::InvalidFuncIdx);
+    spdlog::error(
+        ErrInfo::InfoForbidIndex(ErrInfo::IndexCategory::Function, TId,
+                                 static_cast<uint32_t>(FuncVec.size())));
+    return Unexpect(ErrCode::Value::InvalidFuncIdx);
+  }
+
+  uint32_t Jobs = Conf.getRuntimeConfigure().getValidationJobs();
+  if (Jobs == 0) {
+    Jobs = std::max(std::thread::hardware_concurrency(), 1U);
+  }
+  Jobs = std::min(Jobs, CodeNum);
+
+  // Validate function body. Only the locals are validated here in the lazy
+  // loading mode.
+  const bool IsLazy = CodeNum > 0 && CodeVec[0].getLazyBody();
+  if (Jobs <= 1 || IsLazy) {
+    for (uint32_t Id = 0; Id < CodeNum; ++Id) {
+      if (auto Res = validate(CodeVec[Id], FuncVec[Id + NumImportFuncs],
+                              Checker);
+          !Res) {
+        spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Seg_Code));
+        return Unexpect(Res);
+      }
+    }
+    if (IsLazy) {
+      // Wrap the lazily loaded function bodies to be validated with the module
+      // contexts after decoded.
+      auto Context = std::make_shared<const LazyContext>(Checker);
+      for (uint32_t Id = 0; Id < CodeNum; ++Id) {
+        auto Body = CodeVec[Id].getLazyBody();
+        if (auto *Validated =
+                dynamic_cast<const LazyValidatedBody *>(Body.get())) {
+          // Unwrap the body when the module is validated again.
+          Body = Validated->getBody();
+        }
+        const_cast<AST::CodeSegment &>(CodeVec[Id])
+            .setLazyBody(std::make_shared<LazyValidatedBody>(
+                Context, std::move(Body), FuncVec[Id + NumImportFuncs],
+                CodeVec[Id].getLocals()));
+      }
+    }
+    return {};
+  }
+
+  // The function bodies are independent with each other. Every worker
+  // validates them with its own copy of the form checker which shares the
+  // module contexts. The functions after the first failed one are skipped, and
+  // the results are reduced in order to report the same error as the
+  // sequential validation.
+  std::vector<Expect<void>> Results(CodeNum);
+  std::atomic<uint32_t> NextId = 0;
+  std::atomic<uint32_t> FailedId = CodeNum;
+  auto Worker = [&](FormChecker CodeChecker) {
+    for (uint32_t Id = NextId.fetch_add(1, std::memory_order_relaxed);
+         Id < FailedId.load(std::memory_order_relaxed);
+         Id = NextId.fetch_add(1, std::memory_order_relaxed)) {
+      Results[Id] =
+          validate(CodeVec[Id], FuncVec[Id + NumImportFuncs], CodeChecker);
+      if (!Results[Id]) {
+        uint32_t Failed = FailedId.load(std::memory_order_relaxed);
+        while (Id < Failed && !FailedId.compare_exchange_weak(
+                                  Failed, Id, std::memory_order_relaxed)) {
+        }
+      }
     }
-    if (auto Res = validate(CodeVec[Id], FuncVec[TId]); !Res) {
+  };
+  std::vector<std::thread> Threads;
+  Threads.reserve(Jobs - 1);
+  for (uint32_t I = 1; I < Jobs; ++I) {
+    Threads.emplace_back(Worker, Checker);
+  }
+  Worker(Checker);
+  for (auto &Thread : Threads) {
+    Thread.join();
+  }
+
+  for (uint32_t Id = 0; Id < CodeNum; ++Id) {
+    if (!Results[Id]) {
       spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Seg_Code));
-      return Unexpect(Res);
+      return Unexpect(Results[Id]);
     }
   }
   return {};
@@ -3,8 +3,11 @@
 
 #include "vm/vm.h"
 
+#include "aot/cache.h"
+#include "baseline/compiler.h"
 #include "host/wasi/wasimodule.h"
 #include "plugin/plugin.h"
+#include "llvm/codegen.h"
 #include "llvm/compiler.h"
 #include "llvm/jit.h"
 
@@ -15,6 +18,9 @@
 #include "host/mock/wasmedge_process_module.h"
 #include "host/mock/wasmedge_tensorflow_module.h"
 #include "host/mock/wasmedge_tensorflowlite_module.h"
+#include <algorithm>
+#include <array>
+#include <fstream>
 #include <variant>
 
 namespace WasmEdge {
@@ -34,6 +40,85 @@ createPluginModule(std::string_view PName, std::string_view MName) {
                 PName, MName);
   return std::make_unique<T>();
 }
+
+#ifdef WASMEDGE_USE_LLVM
+// Compile the module in the background, and publish the compiled module into
+// the AOT cache for the next loading.
+void compileAOTCache(const Configure &Conf, const AST::Module &Mod,
+                     Span<const Byte> Code,
+                     const std::filesystem::path &Path) noexcept {
+  using namespace std::literals::string_view_literals;
+  auto Res = AOT::Cache::publish(
+      Path, [&](const std::filesystem::path &TmpPath) -> Expect<void> {
+        LLVM::Compiler Compiler(Conf);
+        LLVM::CodeGen CodeGen(Conf);
+        auto Data = Compiler.compile(Mod);
+        if (!Data) {
+          return Unexpect(Data);
+        }
+        return CodeGen.codegen(Code, std::move(*Data), TmpPath);
+      });
+  if (!Res) {
+    const auto Err = static_cast<uint32_t>(Res.error());
+    spdlog::warn("AOT cache compilation failed. Error code: {}"sv, Err);
+    return;
+  }
+  if (const auto Limit = Conf.getRuntimeConfigure().getAOTCacheSizeLimit();
+      Limit > 0) {
+    AOT::Cache::prune(AOT::Cache::StorageScope::Local, Limit);
+  }
+}
+#endif
+
+// Compile the module in the background, and switch the functions of the
+// module instance to the compiled code for the tiered execution. Without LLVM,
+// the baseline compiler is used instead.
+void compileTierUp(const Configure &Conf, Executor::Executor &ExecutorEngine,
+                   const AST::Module &Mod,
+                   const Runtime::Instance::ModuleInstance &ModInst) noexcept {
+  using namespace std::literals::string_view_literals;
+#ifdef WASMEDGE_USE_LLVM
+  for (const auto &SubType : Mod.getTypeSection().getContent()) {
+    if (unlikely(!SubType.getCompositeType().isFunc())) {
+      // TODO: GC - AOT: implement other composite types.
+      spdlog::warn("Tiered compilation does not support GC proposal yet, "
+                   "keep running in interpreter mode."sv);
+      return;
+    }
+  }
+
+  LLVM::Compiler Compiler(Conf);
+  LLVM::JIT JIT(Conf);
+  auto Res = Compiler.compile(Mod);
+  if (!Res) {
+    const auto Err = static_cast<uint32_t>(Res.error());
+    spdlog::warn("Tiered compilation failed. Error code: {}, keep running in "
+                 "interpreter mode."sv,
+                 Err);
+    return;
+  }
+  auto Exec = JIT.load(std::move(*Res));
+  if (!Exec) {
+    const auto Err = static_cast<uint32_t>(Exec.error());
+    spdlog::warn(
+        "Tiered JIT failed. Error code: {}, keep running in interpreter mode."sv,
+        Err);
+    return;
+  }
+#else
+  Baseline::Compiler Compiler(Conf);
+  auto Exec = Compiler.compile(Mod);
+  if (!Exec) {
+    const auto Err = static_cast<uint32_t>(Exec.error());
+    spdlog::warn("Tiered baseline compilation failed. Error code: {}, keep "
+                 "running in interpreter mode."sv,
+                 Err);
+    return;
+  }
+#endif
+
+  ExecutorEngine.loadTieredExecutable(Mod, ModInst, std::move(*Exec));
+}
 } // namespace
 
 VM::VM(const Configure &Conf)
@@ -51,6 +136,15 @@ VM::VM(const Configure &Conf, Runtime::StoreManager &S)
   unsafeInitVM();
 }
 
+VM::~VM() {
+  if (TierUpThread.joinable()) {
+    TierUpThread.join();
+  }
+  if (AOTCacheThread.joinable()) {
+    AOTCacheThread.join();
+  }
+}
+
 void VM::unsafeInitVM() {
   // Load the built-in modules and the plug-ins.
   unsafeLoadBuiltInHosts();
@@ -277,6 +371,7 @@ VM::unsafeRunWasmFile(const AST::Module &Module, std::string_view Func,
   if (auto Res = ValidatorEngine.validate(Module); !Res) {
     return Unexpect(Res);
   }
+  unsafeInitTierUp(Module);
   if (auto Res = ExecutorEngine.instantiateModule(StoreRef, Module)) {
     ActiveModInst = std::move(*Res);
   } else {
@@ -339,42 +434,77 @@ VM::asyncRunWasmFile(const AST::Module &Module, std::string_view Func,
 }
 
 Expect<void> VM::unsafeLoadWasm(const std::filesystem::path &Path) {
+  ImageCachePath.clear();
+  if (Conf.getRuntimeConfigure().isEnableImageCache()) {
+    if (auto Code = Loader::Loader::loadFile(Path);
+        Code && unsafeLoadImageCache(*Code)) {
+      if (Conf.getRuntimeConfigure().isEnableAOTCache()) {
+        unsafeLoadAOTCache(*Code);
+      }
+      Stage = VMStage::Loaded;
+      return {};
+    }
+  }
   // If not load successfully, the previous status will be reserved.
   if (auto Res = LoaderEngine.parseWasmUnit(Path)) {
     if (std::holds_alternative<std::unique_ptr<AST::Module>>(*Res)) {
       Mod = std::move(std::get<std::unique_ptr<AST::Module>>(*Res));
+      if (Conf.getRuntimeConfigure().isEnableAOTCache() && !Mod->getSymbol()) {
+        if (auto Code = Loader::Loader::loadFile(Path)) {
+          unsafeLoadAOTCache(*Code);
+        }
+      }
     } else if (std::holds_alternative<
                    std::unique_ptr<AST::Component::Component>>(*Res)) {
       spdlog::error("component execution is not done yet.");
+      ImageCachePath.clear();
     } else {
+      ImageCachePath.clear();
       return Unexpect(Res);
     }
     Stage = VMStage::Loaded;
   } else {
+    ImageCachePath.clear();
     return Unexpect(Res);
   }
   return {};
 }
 
 Expect<void> VM::unsafeLoadWasm(Span<const Byte> Code) {
+  ImageCachePath.clear();
+  if (Conf.getRuntimeConfigure().isEnableImageCache() &&
+      unsafeLoadImageCache(Code)) {
+    if (Conf.getRuntimeConfigure().isEnableAOTCache()) {
+      unsafeLoadAOTCache(Code);
+    }
+    Stage = VMStage::Loaded;
+    return {};
+  }
   // If not load successfully, the previous status will be reserved.
   if (auto Res = LoaderEngine.parseWasmUnit(Code)) {
     if (std::holds_alternative<std::unique_ptr<AST::Module>>(*Res)) {
       Mod = std::move(std::get<std::unique_ptr<AST::Module>>(*Res));
+      if (Conf.getRuntimeConfigure().isEnableAOTCache() && !Mod->getSymbol()) {
+        unsafeLoadAOTCache(Code);
+      }
     } else if (std::holds_alternative<
                    std::unique_ptr<AST::Component::Component>>(*Res)) {
       spdlog::error("component execution is not done yet.");
+      ImageCachePath.clear();
     } else {
+      ImageCachePath.clear();
       return Unexpect(Res);
     }
     Stage = VMStage::Loaded;
   } else {
+    ImageCachePath.clear();
     return Unexpect(Res);
   }
   return {};
 }
 
 Expect<void> VM::unsafeLoadWasm(const AST::Module &Module) {
+  ImageCachePath.clear();
   Mod = std::make_unique<AST::Module>(Module);
   Stage = VMStage::Loaded;
   return {};
@@ -388,13 +518,15 @@ Expect<void> VM::unsafeValidate() {
   }
   if (auto Res = ValidatorEngine.validate(*Mod.get())) {
     Stage = VMStage::Validated;
+    unsafeStartImageCache();
+    unsafeStartAOTCache();
     return {};
   } else {
     return Unexpect(Res);
   }
 }
 
-Expect<void> VM::unsafeInstantiate() {
+Expect<void> VM::unsafeInstantiate(const Executor::Snapshot *Snap) {
   if (Stage < VMStage::Validated) {
     // When module is not validated, not instantiate.
     spdlog::error(ErrCode::Value::WrongVMWorkflow);
@@ -422,9 +554,12 @@ Expect<void> VM::unsafeInstantiate() {
       spdlog::error("LLVM disabled, JIT is unsupported!");
 #endif
     }
+    unsafeInitTierUp(*Mod);
   }
 
-  if (auto Res = ExecutorEngine.instantiateModule(StoreRef, *Mod.get())) {
+  auto Res = Snap ? ExecutorEngine.instantiateSnapshot(StoreRef, *Mod, *Snap)
+                  : ExecutorEngine.instantiateModule(StoreRef, *Mod);
+  if (Res) {
     Stage = VMStage::Instantiated;
     ActiveModInst = std::move(*Res);
     return {};
@@ -433,6 +568,14 @@ Expect<void> VM::unsafeInstantiate() {
   }
 }
 
+Expect<void> VM::unsafeSaveSnapshot(const std::filesystem::path &Path) {
+  if (Stage < VMStage::Instantiated || !ActiveModInst) {
+    spdlog::error(ErrCode::Value::WrongVMWorkflow);
+    return Unexpect(ErrCode::Value::WrongVMWorkflow);
+  }
+  return ExecutorEngine.saveSnapshot(*ActiveModInst, Path);
+}
+
 Expect<std::vector<std::pair<ValVariant, ValType>>>
 VM::unsafeExecute(std::string_view Func, Span<const ValVariant> Params,
                   Span<const ValType> ParamTypes) {
@@ -508,7 +651,181 @@ VM::asyncExecute(std::string_view ModName, std::string_view Func,
           std::vector(ParamTypes.begin(), ParamTypes.end())};
 }
 
+void VM::unsafeLoadAOTCache([[maybe_unused]] Span<const Byte> Code) {
+  AOTCacheCode.clear();
+  AOTCachePath.clear();
+  if (Conf.getRuntimeConfigure().isForceInterpreter()) {
+    return;
+  }
+#ifdef WASMEDGE_USE_LLVM
+  using namespace std::literals::string_view_literals;
+  auto Path = AOT::Cache::getPath(
+      Code, AOT::Cache::StorageScope::Local,
+      AOT::Cache::getKey(Conf, LLVM::Compiler::getTarget(Conf)));
+  if (!Path) {
+    return;
+  }
+  std::error_code Error;
+  if (std::filesystem::exists(*Path, Error)) {
+    // Cache hit. The cached module is compiled from the same binary with the
+    // same target and options.
+    if (auto Res = LoaderEngine.parseModule(*Path); Res && (*Res)->getSymbol()) {
+      Mod = std::move(*Res);
+      AOT::Cache::recordHit(*Path);
+      return;
+    }
+    spdlog::warn("AOT cache {} is broken, recompile it."sv, Path->u8string());
+    std::filesystem::remove(*Path, Error);
+  }
+  // Cache miss. The module will be compiled in the background after the
+  // validation.
+  AOT::Cache::recordMiss();
+  AOTCacheCode.assign(Code.begin(), Code.end());
+  AOTCachePath = std::move(*Path);
+#else
+  spdlog::error("LLVM disabled, AOT cache is unsupported!");
+#endif
+}
+
+void VM::unsafeStartAOTCache() {
+  if (AOTCachePath.empty()) {
+    return;
+  }
+#ifdef WASMEDGE_USE_LLVM
+  if (AOTCacheThread.joinable()) {
+    AOTCacheThread.join();
+  }
+  AOTCacheThread =
+      std::thread([&Conf = Conf, Module = std::make_shared<AST::Module>(*Mod),
+                   Code = std::move(AOTCacheCode),
+                   Path = std::move(AOTCachePath)]() {
+        compileAOTCache(Conf, *Module, Code, Path);
+      });
+#endif
+  AOTCacheCode.clear();
+  AOTCachePath.clear();
+}
+
+bool VM::unsafeLoadImageCache(Span<const Byte> Code) {
+  using namespace std::literals::string_view_literals;
+  // Only the WASM modules are cached. The components and the AOT compiled
+  // modules in the universal WASM format are loaded as usual.
+  static constexpr std::array<Byte, 8> ModuleHeader = {0x00U, 0x61U, 0x73U,
+                                                        0x6DU, 0x01U, 0x00U,
+                                                        0x00U, 0x00U};
+  if (Code.size() < ModuleHeader.size() ||
+      !std::equal(ModuleHeader.begin(), ModuleHeader.end(), Code.begin())) {
+    return false;
+  }
+  auto Path = AOT::Cache::getPath(Code, AOT::Cache::StorageScope::Local,
+                                  AOT::Cache::getKey(Conf, "image"sv));
+  if (!Path) {
+    return false;
+  }
+  std::error_code Error;
+  if (std::filesystem::exists(*Path, Error)) {
+    // Cache hit. The cached image is created from the same binary with the
+    // same proposals, and the function bodies in it are validated already.
+    if (auto Res = LoaderEngine.parseModule(*Path)) {
+      Mod = std::move(*Res);
+      AOT::Cache::recordHit(*Path);
+      return true;
+    }
+    spdlog::warn("Image cache {} is broken, recreate it."sv, Path->u8string());
+    std::filesystem::remove(*Path, Error);
+  }
+  // Cache miss. The image will be created after the validation.
+  AOT::Cache::recordMiss();
+  ImageCachePath = std::move(*Path);
+  return false;
+}
+
+void VM::unsafeStartImageCache() {
+  if (ImageCachePath.empty()) {
+    return;
+  }
+  using namespace std::literals::string_view_literals;
+  // The image is small compared to the compiled code, so it is serialized and
+  // published synchronously with the validated module.
+  auto Res = AOT::Cache::publish(
+      ImageCachePath,
+      [this](const std::filesystem::path &TmpPath) -> Expect<void> {
+        auto Image = LoaderEngine.serializeImage(*Mod);
+        if (!Image) {
+          return Unexpect(Image);
+        }
+        std::ofstream File(TmpPath, std::ios::binary | std::ios::trunc);
+        File.write(reinterpret_cast<const char *>(Image->data()),
+                   static_cast<std::streamsize>(Image->size()));
+        if (!File.flush()) {
+          spdlog::error(ErrCode::Value::IllegalPath);
+          spdlog::error("    Write image failed:{}"sv, TmpPath.u8string());
+          return Unexpect(ErrCode::Value::IllegalPath);
+        }
+        return {};
+      });
+  if (!Res) {
+    const auto Err = static_cast<uint32_t>(Res.error());
+    spdlog::warn("Image cache creation failed. Error code: {}"sv, Err);
+  } else if (const auto Limit =
+                 Conf.getRuntimeConfigure().getAOTCacheSizeLimit();
+             Limit > 0) {
+    AOT::Cache::prune(AOT::Cache::StorageScope::Local, Limit);
+  }
+  ImageCachePath.clear();
+}
+
+void VM::unsafeInitTierUp(const AST::Module &Module) {
+  // The background compilation of the previous active module should finish
+  // before replacing the module instance.
+  if (TierUpThread.joinable()) {
+    TierUpThread.join();
+  }
+  TierUpMod.reset();
+  TierUpStarted.store(false, std::memory_order_relaxed);
+  if (!Conf.getRuntimeConfigure().isEnableTieredJIT() ||
+      Conf.getRuntimeConfigure().isForceInterpreter() || Module.getSymbol()) {
+    return;
+  }
+#ifndef WASMEDGE_USE_LLVM
+  if (!Baseline::Compiler::isSupported(Conf)) {
+    spdlog::error("LLVM disabled and the baseline compiler is unsupported, "
+                  "tiered JIT is unsupported!");
+    return;
+  }
+#endif
+  TierUpMod = std::make_shared<AST::Module>(Module);
+  ExecutorEngine.registerTierUpFunction(
+      [this](const Runtime::Instance::FunctionInstance &Func) {
+        startTierUp(Func);
+      });
+}
+
+void VM::startTierUp(const Runtime::Instance::FunctionInstance &Func) {
+  // Only the functions of the active module are compiled, and the whole module
+  // is compiled once by the first hot function.
+  if (!TierUpMod || Func.getModule() != ActiveModInst.get() ||
+      TierUpStarted.exchange(true, std::memory_order_relaxed)) {
+    return;
+  }
+  TierUpThread =
+      std::thread([&Conf = Conf, &ExecutorEngine = ExecutorEngine,
+                   Mod = TierUpMod, ModInst = ActiveModInst.get()]() {
+        compileTierUp(Conf, ExecutorEngine, *Mod, *ModInst);
+      });
+}
+
 void VM::unsafeCleanup() {
+  if (TierUpThread.joinable()) {
+    TierUpThread.join();
+  }
+  if (AOTCacheThread.joinable()) {
+    AOTCacheThread.join();
+  }
+  AOTCacheCode.clear();
+  AOTCachePath.clear();
+  ImageCachePath.clear();
+  TierUpMod.reset();
   Mod.reset();
   ActiveModInst.reset();
   StoreRef.reset();
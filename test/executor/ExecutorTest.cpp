@@ -14,18 +14,24 @@
 ///
 //===----------------------------------------------------------------------===//
 
+#include "aot/cache.h"
+#include "baseline/compiler.h"
 #include "common/spdlog.h"
+#include "executor/pool.h"
 #include "vm/vm.h"
 
 #include "../spec/hostfunc.h"
 #include "../spec/spectest.h"
 
+#include <algorithm>
 #include <array>
 #include <chrono>
 #include <cstdint>
 #include <filesystem>
+#include <fstream>
 #include <functional>
 #include <gtest/gtest.h>
+#include <limits>
 #include <map>
 #include <string>
 #include <string_view>
@@ -41,9 +47,17 @@ static SpecTest T(std::filesystem::u8path("../spec/testSuites"sv));
 
 // Parameterized testing class.
 class CoreTest : public testing::TestWithParam<std::string> {};
+class ThreadedCoreTest : public testing::TestWithParam<std::string> {};
+class RegisterCoreTest : public testing::TestWithParam<std::string> {};
+class GuardedCoreTest : public testing::TestWithParam<std::string> {};
 
-TEST_P(CoreTest, TestSuites) {
-  const auto [Proposal, Conf, UnitName] = T.resolve(GetParam());
+void runTestSuites(const std::string &Params, bool IsThreadedInterpreter,
+                   bool IsRegisterInterpreter,
+                   bool IsGuardPageBoundsCheck = false) {
+  auto [Proposal, Conf, UnitName] = T.resolve(Params);
+  Conf.getRuntimeConfigure().setThreadedInterpreter(IsThreadedInterpreter);
+  Conf.getRuntimeConfigure().setRegisterInterpreter(IsRegisterInterpreter);
+  Conf.getRuntimeConfigure().setGuardPageBoundsCheck(IsGuardPageBoundsCheck);
   WasmEdge::VM::VM VM(Conf);
   WasmEdge::SpecTestModule SpecTestMod;
   VM.registerModule(SpecTestMod);
@@ -110,10 +124,33 @@ TEST_P(CoreTest, TestSuites) {
   T.run(Proposal, UnitName);
 }
 
+TEST_P(CoreTest, TestSuites) { runTestSuites(GetParam(), false, false); }
+
+TEST_P(ThreadedCoreTest, TestSuites) {
+  runTestSuites(GetParam(), true, false);
+}
+
+TEST_P(RegisterCoreTest, TestSuites) {
+  runTestSuites(GetParam(), false, true);
+}
+
+TEST_P(GuardedCoreTest, TestSuites) {
+  runTestSuites(GetParam(), true, false, true);
+}
+
 // Initiate test suite.
 INSTANTIATE_TEST_SUITE_P(
     TestUnit, CoreTest,
     testing::ValuesIn(T.enumerate(SpecTest::TestMode::Interpreter)));
+INSTANTIATE_TEST_SUITE_P(
+    TestUnit, ThreadedCoreTest,
+    testing::ValuesIn(T.enumerate(SpecTest::TestMode::Interpreter)));
+INSTANTIATE_TEST_SUITE_P(
+    TestUnit, RegisterCoreTest,
+    testing::ValuesIn(T.enumerate(SpecTest::TestMode::Interpreter)));
+INSTANTIATE_TEST_SUITE_P(
+    TestUnit, GuardedCoreTest,
+    testing::ValuesIn(T.enumerate(SpecTest::TestMode::Interpreter)));
 
 std::array<WasmEdge::Byte, 46> AsyncWasm{
     0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x04, 0x01, 0x60,
@@ -121,6 +158,715 @@ std::array<WasmEdge::Byte, 46> AsyncWasm{
     0x0a, 0x01, 0x06, 0x5f, 0x73, 0x74, 0x61, 0x72, 0x74, 0x00, 0x00, 0x0a,
     0x09, 0x01, 0x07, 0x00, 0x03, 0x40, 0x0c, 0x00, 0x0b, 0x0b};
 
+std::array<WasmEdge::Byte, 38> RecursiveWasm{
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x04,
+    0x01, 0x60, 0x00, 0x00, 0x03, 0x02, 0x01, 0x00, 0x07, 0x0a,
+    0x01, 0x06, 0x5f, 0x73, 0x74, 0x61, 0x72, 0x74, 0x00, 0x00,
+    0x0a, 0x06, 0x01, 0x04, 0x00, 0x10, 0x00, 0x0b};
+
+TEST(CallStack, ExhaustionTest) {
+  {
+    WasmEdge::Configure Conf;
+    WasmEdge::VM::VM VM(Conf);
+    auto Result = VM.runWasmFile(RecursiveWasm, "_start");
+    EXPECT_FALSE(Result);
+    EXPECT_EQ(Result.error(), WasmEdge::ErrCode::Value::CallStackExhausted);
+  }
+  {
+    WasmEdge::Configure Conf;
+    Conf.getRuntimeConfigure().setMaxCallStackDepth(16);
+    WasmEdge::VM::VM VM(Conf);
+    auto Result = VM.runWasmFile(RecursiveWasm, "_start");
+    EXPECT_FALSE(Result);
+    EXPECT_EQ(Result.error(), WasmEdge::ErrCode::Value::CallStackExhausted);
+  }
+}
+
+std::array<WasmEdge::Byte, 85> MemoryWasm{
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x0b, 0x02, 0x60,
+    0x01, 0x7f, 0x01, 0x7f, 0x60, 0x02, 0x7f, 0x7f, 0x00, 0x03, 0x04, 0x03,
+    0x00, 0x01, 0x00, 0x05, 0x03, 0x01, 0x00, 0x01, 0x07, 0x17, 0x03, 0x04,
+    0x6c, 0x6f, 0x61, 0x64, 0x00, 0x00, 0x05, 0x73, 0x74, 0x6f, 0x72, 0x65,
+    0x00, 0x01, 0x04, 0x67, 0x72, 0x6f, 0x77, 0x00, 0x02, 0x0a, 0x1a, 0x03,
+    0x07, 0x00, 0x20, 0x00, 0x28, 0x02, 0x00, 0x0b, 0x09, 0x00, 0x20, 0x00,
+    0x20, 0x01, 0x36, 0x02, 0x00, 0x0b, 0x06, 0x00, 0x20, 0x00, 0x40, 0x00,
+    0x0b};
+
+TEST(GuardPage, BoundsCheckTest) {
+  WasmEdge::Configure Conf;
+  Conf.getRuntimeConfigure().setGuardPageBoundsCheck(true);
+  WasmEdge::VM::VM VM(Conf);
+  ASSERT_TRUE(VM.loadWasm(MemoryWasm));
+  ASSERT_TRUE(VM.validate());
+  ASSERT_TRUE(VM.instantiate());
+  const std::array<WasmEdge::ValType, 2> ParamTypes{WasmEdge::TypeCode::I32,
+                                                    WasmEdge::TypeCode::I32};
+  const std::array<WasmEdge::ValType, 1> ParamType{WasmEdge::TypeCode::I32};
+  auto Store = [&VM, &ParamTypes](uint32_t Addr, uint32_t Val) {
+    return VM.execute("store", std::array<WasmEdge::ValVariant, 2>{Addr, Val},
+                      ParamTypes);
+  };
+  auto Load = [&VM, &ParamType](uint32_t Addr) {
+    return VM.execute("load", std::array<WasmEdge::ValVariant, 1>{Addr},
+                      ParamType);
+  };
+
+  ASSERT_TRUE(Store(65532, 1234));
+  auto Result = Load(65532);
+  ASSERT_TRUE(Result);
+  EXPECT_EQ((*Result)[0].first.get<uint32_t>(), 1234U);
+  // Out-of-bounds accesses in the guard region trap.
+  Result = Load(65533);
+  ASSERT_FALSE(Result);
+  EXPECT_EQ(Result.error(), WasmEdge::ErrCode::Value::MemoryOutOfBounds);
+  auto StoreResult = Store(UINT32_MAX, 0);
+  ASSERT_FALSE(StoreResult);
+  EXPECT_EQ(StoreResult.error(), WasmEdge::ErrCode::Value::MemoryOutOfBounds);
+  // The grown pages are accessible.
+  ASSERT_TRUE(VM.execute("grow", std::array<WasmEdge::ValVariant, 1>{1U},
+                         ParamType));
+  Result = Load(65533);
+  ASSERT_TRUE(Result);
+  EXPECT_EQ((*Result)[0].first.get<uint32_t>(), 1234U >> 8);
+}
+
+TEST(Validator, ParallelTest) {
+  WasmEdge::Configure Conf;
+  Conf.getRuntimeConfigure().setValidationJobs(4);
+  {
+    WasmEdge::VM::VM VM(Conf);
+    ASSERT_TRUE(VM.loadWasm(MemoryWasm));
+    EXPECT_TRUE(VM.validate());
+  }
+  // Invalid local index in the `grow` function.
+  auto Wasm = MemoryWasm;
+  Wasm[81] = 0x05;
+  {
+    WasmEdge::VM::VM VM(Conf);
+    ASSERT_TRUE(VM.loadWasm(Wasm));
+    auto Result = VM.validate();
+    ASSERT_FALSE(Result);
+    EXPECT_EQ(Result.error(), WasmEdge::ErrCode::Value::InvalidLocalIdx);
+  }
+  // The error of the first invalid function, the `store` function with the
+  // invalid alignment, is reported.
+  Wasm[75] = 0x03;
+  {
+    WasmEdge::VM::VM VM(Conf);
+    ASSERT_TRUE(VM.loadWasm(Wasm));
+    auto Result = VM.validate();
+    ASSERT_FALSE(Result);
+    EXPECT_EQ(Result.error(), WasmEdge::ErrCode::Value::InvalidAlignment);
+  }
+}
+
+TEST(LazyLoading, LoadOnCallTest) {
+  WasmEdge::Configure Conf;
+  Conf.getRuntimeConfigure().setLazyLoading(true);
+  const std::array<WasmEdge::ValType, 2> ParamTypes{WasmEdge::TypeCode::I32,
+                                                    WasmEdge::TypeCode::I32};
+  const std::array<WasmEdge::ValType, 1> ParamType{WasmEdge::TypeCode::I32};
+  {
+    WasmEdge::VM::VM VM(Conf);
+    ASSERT_TRUE(VM.loadWasm(MemoryWasm));
+    ASSERT_TRUE(VM.validate());
+    ASSERT_TRUE(VM.instantiate());
+    ASSERT_TRUE(VM.execute("store",
+                           std::array<WasmEdge::ValVariant, 2>{8U, 1234U},
+                           ParamTypes));
+    auto Result =
+        VM.execute("load", std::array<WasmEdge::ValVariant, 1>{8U}, ParamType);
+    ASSERT_TRUE(Result);
+    EXPECT_EQ((*Result)[0].first.get<uint32_t>(), 1234U);
+  }
+  // The invalid `grow` function is reported when calling it.
+  auto Wasm = MemoryWasm;
+  Wasm[81] = 0x05;
+  {
+    WasmEdge::VM::VM VM(Conf);
+    ASSERT_TRUE(VM.loadWasm(Wasm));
+    ASSERT_TRUE(VM.validate());
+    ASSERT_TRUE(VM.instantiate());
+    auto Result =
+        VM.execute("load", std::array<WasmEdge::ValVariant, 1>{8U}, ParamType);
+    ASSERT_TRUE(Result);
+    for (uint32_t I = 0; I < 2; ++I) {
+      Result = VM.execute("grow", std::array<WasmEdge::ValVariant, 1>{1U},
+                          ParamType);
+      ASSERT_FALSE(Result);
+      EXPECT_EQ(Result.error(), WasmEdge::ErrCode::Value::InvalidLocalIdx);
+    }
+  }
+}
+
+std::array<WasmEdge::Byte, 70> DataWasm{
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x06, 0x01, 0x60,
+    0x01, 0x7f, 0x01, 0x7f, 0x03, 0x02, 0x01, 0x00, 0x05, 0x03, 0x01, 0x00,
+    0x01, 0x07, 0x08, 0x01, 0x04, 0x6c, 0x6f, 0x61, 0x64, 0x00, 0x00, 0x0a,
+    0x09, 0x01, 0x07, 0x00, 0x20, 0x00, 0x28, 0x02, 0x00, 0x0b, 0x0b, 0x0a,
+    0x01, 0x00, 0x41, 0x08, 0x0b, 0x04, 0x2a, 0x00, 0x00, 0x00, 0x00, 0x0a,
+    0x04, 0x6e, 0x6f, 0x74, 0x65, 0x68, 0x65, 0x6c, 0x6c, 0x6f};
+
+TEST(ZeroCopy, MappedDataTest) {
+  const auto Path =
+      std::filesystem::temp_directory_path() / "wasmedgeZeroCopyTest.wasm";
+  {
+    std::ofstream File(Path, std::ios::binary);
+    File.write(reinterpret_cast<const char *>(DataWasm.data()),
+               static_cast<std::streamsize>(DataWasm.size()));
+  }
+  WasmEdge::Configure Conf;
+  std::unique_ptr<WasmEdge::AST::Module> Mod;
+  {
+    WasmEdge::Loader::Loader Loader(Conf);
+    auto Res = Loader.parseModule(Path);
+    ASSERT_TRUE(Res);
+    Mod = std::move(*Res);
+  }
+  // The payloads reference the mapped file after the loader is destroyed.
+  const auto &DataSegs = std::as_const(*Mod).getDataSection().getContent();
+  ASSERT_EQ(DataSegs.size(), 1U);
+  EXPECT_NE(DataSegs[0].getDataHolder(), nullptr);
+  EXPECT_EQ(DataSegs[0].getData().size(), 4U);
+  EXPECT_EQ(DataSegs[0].getData()[0], 0x2aU);
+  const auto &CustomSecs = std::as_const(*Mod).getCustomSections();
+  ASSERT_EQ(CustomSecs.size(), 1U);
+  EXPECT_EQ(CustomSecs[0].getName(), "note"sv);
+  EXPECT_EQ(std::string_view(
+                reinterpret_cast<const char *>(CustomSecs[0].getContent().data()),
+                CustomSecs[0].getContent().size()),
+            "hello"sv);
+
+  WasmEdge::VM::VM VM(Conf);
+  ASSERT_TRUE(VM.loadWasm(*Mod));
+  Mod.reset();
+  ASSERT_TRUE(VM.validate());
+  ASSERT_TRUE(VM.instantiate());
+  auto Result = VM.execute("load", std::array<WasmEdge::ValVariant, 1>{8U},
+                           std::array<WasmEdge::ValType, 1>{
+                               WasmEdge::TypeCode::I32});
+  ASSERT_TRUE(Result);
+  EXPECT_EQ((*Result)[0].first.get<uint32_t>(), 42U);
+  std::filesystem::remove(Path);
+}
+
+std::array<WasmEdge::Byte, 83> SwitchWasm{
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x06, 0x01, 0x60,
+    0x01, 0x7f, 0x01, 0x7f, 0x03, 0x03, 0x02, 0x00, 0x00, 0x07, 0x10, 0x02,
+    0x06, 0x73, 0x77, 0x69, 0x74, 0x63, 0x68, 0x00, 0x00, 0x03, 0x61, 0x64,
+    0x64, 0x00, 0x01, 0x0a, 0x2a, 0x02, 0x1a, 0x00, 0x02, 0x40, 0x02, 0x40,
+    0x02, 0x40, 0x20, 0x00, 0x0e, 0x02, 0x00, 0x01, 0x02, 0x0b, 0x41, 0x0a,
+    0x0f, 0x0b, 0x41, 0x14, 0x0f, 0x0b, 0x41, 0x1e, 0x0b, 0x0d, 0x01, 0x01,
+    0x7f, 0x20, 0x00, 0x41, 0x05, 0x6a, 0x21, 0x01, 0x20, 0x01, 0x0b};
+
+TEST(ModuleImage, SerializeTest) {
+  WasmEdge::Configure Conf;
+  WasmEdge::Loader::Loader Loader(Conf);
+  WasmEdge::Validator::Validator Validator(Conf);
+  std::vector<WasmEdge::Byte> Image;
+  {
+    auto Mod = Loader.parseModule(SwitchWasm);
+    ASSERT_TRUE(Mod);
+    // Only the validated modules can be serialized.
+    EXPECT_FALSE(Loader.serializeImage(**Mod));
+    ASSERT_TRUE(Validator.validate(**Mod));
+    auto Res = Loader.serializeImage(**Mod);
+    ASSERT_TRUE(Res);
+    Image = std::move(*Res);
+  }
+  const auto Path =
+      std::filesystem::temp_directory_path() / "wasmedgeModuleImageTest.wmi";
+  {
+    std::ofstream File(Path, std::ios::binary);
+    File.write(reinterpret_cast<const char *>(Image.data()),
+               static_cast<std::streamsize>(Image.size()));
+  }
+
+  const std::array<WasmEdge::ValType, 1> ParamType{WasmEdge::TypeCode::I32};
+  auto Check = [&](std::unique_ptr<WasmEdge::AST::Module> Mod) {
+    ASSERT_TRUE(Validator.validate(*Mod));
+    WasmEdge::VM::VM VM(Conf);
+    ASSERT_TRUE(VM.loadWasm(*Mod));
+    ASSERT_TRUE(VM.validate());
+    ASSERT_TRUE(VM.instantiate());
+    for (uint32_t I = 0; I < 4; ++I) {
+      auto Result = VM.execute(
+          "switch", std::array<WasmEdge::ValVariant, 1>{I}, ParamType);
+      ASSERT_TRUE(Result);
+      EXPECT_EQ((*Result)[0].first.get<uint32_t>(),
+                I < 2 ? 10U * (I + 1) : 30U);
+    }
+    auto Result =
+        VM.execute("add", std::array<WasmEdge::ValVariant, 1>{37U}, ParamType);
+    ASSERT_TRUE(Result);
+    EXPECT_EQ((*Result)[0].first.get<uint32_t>(), 42U);
+  };
+
+  // The function body without payloads references the mapped image, and the
+  // function body with the jump table is rebuilt.
+  {
+    auto Mod = Loader.parseModule(Path);
+    ASSERT_TRUE(Mod);
+    const auto &Segs = std::as_const(**Mod).getCodeSection().getContent();
+    ASSERT_EQ(Segs.size(), 2U);
+    EXPECT_NE(Segs[0].getExpr().getInstrsHolder(), nullptr);
+    EXPECT_NE(Segs[1].getExpr().getInstrsHolder(), nullptr);
+    Check(std::move(*Mod));
+  }
+  {
+    auto Mod = Loader.parseModule(Image);
+    ASSERT_TRUE(Mod);
+    Check(std::move(*Mod));
+  }
+  // The image created with different proposals is rejected.
+  {
+    WasmEdge::Configure OtherConf;
+    OtherConf.removeProposal(WasmEdge::Proposal::SIMD);
+    WasmEdge::Loader::Loader OtherLoader(OtherConf);
+    auto Mod = OtherLoader.parseModule(Path);
+    ASSERT_FALSE(Mod);
+    EXPECT_EQ(Mod.error(), WasmEdge::ErrCode::Value::MalformedVersion);
+  }
+  std::filesystem::remove(Path);
+}
+
+TEST(ModuleImage, CacheTest) {
+  WasmEdge::Configure Conf;
+  Conf.getRuntimeConfigure().setEnableImageCache(true);
+  const auto Key = WasmEdge::AOT::Cache::getKey(Conf, "image"sv);
+  WasmEdge::AOT::Cache::clear(WasmEdge::AOT::Cache::StorageScope::Local, Key);
+  const auto Before = WasmEdge::AOT::Cache::getStatistics();
+  const std::array<WasmEdge::ValType, 1> ParamType{WasmEdge::TypeCode::I32};
+  // The first run creates the image, and the second run loads it.
+  for (uint32_t I = 0; I < 2; ++I) {
+    WasmEdge::VM::VM VM(Conf);
+    ASSERT_TRUE(VM.loadWasm(SwitchWasm));
+    ASSERT_TRUE(VM.validate());
+    ASSERT_TRUE(VM.instantiate());
+    auto Result = VM.execute(
+        "switch", std::array<WasmEdge::ValVariant, 1>{1U}, ParamType);
+    ASSERT_TRUE(Result);
+    EXPECT_EQ((*Result)[0].first.get<uint32_t>(), 20U);
+  }
+  const auto After = WasmEdge::AOT::Cache::getStatistics();
+  EXPECT_EQ(After.Misses - Before.Misses, 1U);
+  EXPECT_EQ(After.Hits - Before.Hits, 1U);
+  WasmEdge::AOT::Cache::clear(WasmEdge::AOT::Cache::StorageScope::Local, Key);
+}
+
+TEST(MemoryImage, CopyOnWriteTest) {
+  // A module with a 2 pages memory exported as `mem`, and an active data
+  // segment of 70000 bytes at the offset 16.
+  std::vector<WasmEdge::Byte> Wasm{0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00,
+                                   0x00, 0x05, 0x03, 0x01, 0x00, 0x02, 0x07,
+                                   0x07, 0x01, 0x03, 0x6d, 0x65, 0x6d, 0x02,
+                                   0x00, 0x0b};
+  std::vector<WasmEdge::Byte> Data(70000);
+  for (uint32_t I = 0; I < Data.size(); ++I) {
+    Data[I] = static_cast<WasmEdge::Byte>(I % 251 + 1);
+  }
+  const auto WriteLEB = [&Wasm](uint32_t Value) {
+    do {
+      const auto Byte = static_cast<WasmEdge::Byte>(Value & 0x7FU);
+      Value >>= 7;
+      Wasm.push_back(Value ? (Byte | 0x80U) : Byte);
+    } while (Value);
+  };
+  const std::array<WasmEdge::Byte, 5> SegHeader{0x01, 0x00, 0x41, 0x10, 0x0b};
+  WriteLEB(static_cast<uint32_t>(SegHeader.size() + 3 + Data.size()));
+  Wasm.insert(Wasm.end(), SegHeader.begin(), SegHeader.end());
+  WriteLEB(static_cast<uint32_t>(Data.size()));
+  Wasm.insert(Wasm.end(), Data.begin(), Data.end());
+
+  WasmEdge::Configure Conf;
+  WasmEdge::Loader::Loader Loader(Conf);
+  WasmEdge::Validator::Validator Validator(Conf);
+  WasmEdge::Executor::Executor Executor(Conf);
+  WasmEdge::Runtime::StoreManager Store;
+  auto Mod = Loader.parseModule(Wasm);
+  ASSERT_TRUE(Mod);
+  ASSERT_TRUE(Validator.validate(**Mod));
+  auto Inst1 = Executor.instantiateModule(Store, **Mod);
+  ASSERT_TRUE(Inst1);
+  if (WasmEdge::MemoryImage::supported()) {
+    const auto &Images = (*Mod)->getMemoryImages().Images;
+    ASSERT_EQ(Images.size(), 1U);
+    ASSERT_NE(Images[0], nullptr);
+    EXPECT_EQ(Images[0]->size(), 2U * 65536U);
+  }
+  auto Inst2 = Executor.instantiateModule(Store, **Mod);
+  ASSERT_TRUE(Inst2);
+
+  auto *Mem1 = (*Inst1)->findMemoryExports("mem"sv);
+  auto *Mem2 = (*Inst2)->findMemoryExports("mem"sv);
+  ASSERT_NE(Mem1, nullptr);
+  ASSERT_NE(Mem2, nullptr);
+  for (auto *Mem : {Mem1, Mem2}) {
+    const auto *Ptr = Mem->getDataPtr();
+    EXPECT_EQ(Ptr[15], 0U);
+    EXPECT_TRUE(std::equal(Data.begin(), Data.end(), Ptr + 16));
+    EXPECT_EQ(Ptr[16 + Data.size()], 0U);
+    EXPECT_EQ(Ptr[2 * 65536 - 1], 0U);
+  }
+  // The writes are private to the instance.
+  Mem1->getDataPtr()[16] = 0;
+  Mem1->getDataPtr()[2 * 65536 - 1] = 1;
+  EXPECT_EQ(Mem2->getDataPtr()[16], Data[0]);
+  EXPECT_EQ(Mem2->getDataPtr()[2 * 65536 - 1], 0U);
+  ASSERT_TRUE(Mem2->growPage(1));
+  EXPECT_EQ(Mem2->getDataPtr()[2 * 65536], 0U);
+  EXPECT_EQ(Mem2->getDataPtr()[17], Data[1]);
+
+  // The pooled reservation of the released instance is mapped again.
+  WasmEdge::Allocator::set_pool_capacity(1);
+  Inst1->reset();
+  auto Inst3 = Executor.instantiateModule(Store, **Mod);
+  ASSERT_TRUE(Inst3);
+  auto *Mem3 = (*Inst3)->findMemoryExports("mem"sv);
+  ASSERT_NE(Mem3, nullptr);
+  EXPECT_EQ(Mem3->getDataPtr()[16], Data[0]);
+  EXPECT_EQ(Mem3->getDataPtr()[2 * 65536 - 1], 0U);
+  Inst3->reset();
+  WasmEdge::Allocator::set_pool_capacity(0);
+}
+
+std::array<WasmEdge::Byte, 165> InitWasm{
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x08, 0x02, 0x60,
+    0x00, 0x00, 0x60, 0x00, 0x01, 0x7f, 0x03, 0x04, 0x03, 0x00, 0x01, 0x00,
+    0x04, 0x04, 0x01, 0x70, 0x00, 0x02, 0x05, 0x03, 0x01, 0x00, 0x01, 0x06,
+    0x0b, 0x02, 0x7f, 0x01, 0x41, 0x00, 0x0b, 0x70, 0x01, 0xd0, 0x70, 0x0b,
+    0x07, 0x2f, 0x06, 0x0b, 0x5f, 0x69, 0x6e, 0x69, 0x74, 0x69, 0x61, 0x6c,
+    0x69, 0x7a, 0x65, 0x00, 0x00, 0x06, 0x61, 0x6e, 0x73, 0x77, 0x65, 0x72,
+    0x00, 0x01, 0x04, 0x63, 0x6f, 0x70, 0x79, 0x00, 0x02, 0x03, 0x6d, 0x65,
+    0x6d, 0x02, 0x00, 0x01, 0x67, 0x03, 0x00, 0x03, 0x74, 0x61, 0x62, 0x01,
+    0x00, 0x0c, 0x01, 0x01, 0x0a, 0x38, 0x03, 0x24, 0x00, 0x41, 0x07, 0x24,
+    0x00, 0x41, 0x01, 0x40, 0x00, 0x1a, 0x41, 0x84, 0x80, 0x04, 0x41, 0x00,
+    0x41, 0x02, 0xfc, 0x08, 0x00, 0x00, 0xfc, 0x09, 0x00, 0x41, 0x01, 0xd2,
+    0x01, 0x26, 0x00, 0xd2, 0x01, 0x24, 0x01, 0x0b, 0x04, 0x00, 0x41, 0x2a,
+    0x0b, 0x0c, 0x00, 0x41, 0x00, 0x41, 0x00, 0x41, 0x02, 0xfc, 0x08, 0x00,
+    0x00, 0x0b, 0x0b, 0x05, 0x01, 0x01, 0x02, 0x2a, 0x2b};
+
+TEST(Snapshot, RestoreTest) {
+  // The `_initialize` function grows the memory by 1 page, copies the passive
+  // data segment to the offset 65540 and drops it, sets the global `g` to 7,
+  // and stores the reference of `answer` to the table and the second global.
+  // The `copy` function copies the passive data segment to the offset 0.
+  WasmEdge::Configure Conf;
+  WasmEdge::Loader::Loader Loader(Conf);
+  WasmEdge::Validator::Validator Validator(Conf);
+  WasmEdge::Executor::Executor Executor(Conf);
+  WasmEdge::Runtime::StoreManager Store;
+  auto Mod = Loader.parseModule(InitWasm);
+  ASSERT_TRUE(Mod);
+  ASSERT_TRUE(Validator.validate(**Mod));
+  auto Inst1 = Executor.instantiateModule(Store, **Mod);
+  ASSERT_TRUE(Inst1);
+  ASSERT_TRUE(Executor.invoke((*Inst1)->findFuncExports("_initialize"sv), {},
+                              {}));
+  const auto Path = std::filesystem::temp_directory_path() /
+                    std::filesystem::u8path("wasmedge-snapshot-test.snap"sv);
+  ASSERT_TRUE(Executor.saveSnapshot(**Inst1, Path));
+  (*Inst1)->findMemoryExports("mem"sv)->getDataPtr()[65540] = 0;
+
+  auto Snap = WasmEdge::Executor::Snapshot::load(Path);
+  ASSERT_TRUE(Snap);
+  for (uint32_t I = 0; I < 2; ++I) {
+    auto Inst = Executor.instantiateSnapshot(Store, **Mod, **Snap);
+    ASSERT_TRUE(Inst);
+    auto *Mem = (*Inst)->findMemoryExports("mem"sv);
+    ASSERT_NE(Mem, nullptr);
+    EXPECT_EQ(Mem->getPageSize(), 2U);
+    EXPECT_EQ(Mem->getDataPtr()[65539], 0U);
+    EXPECT_EQ(Mem->getDataPtr()[65540], 0x2aU);
+    EXPECT_EQ(Mem->getDataPtr()[65541], 0x2bU);
+    auto *Glob = (*Inst)->findGlobalExports("g"sv);
+    ASSERT_NE(Glob, nullptr);
+    EXPECT_EQ(Glob->getValue().get<uint32_t>(), 7U);
+    // The references are restored to the functions of the new instance.
+    auto *Tab = (*Inst)->findTableExports("tab"sv);
+    ASSERT_NE(Tab, nullptr);
+    auto Refs = Tab->getRefs(0, 2);
+    ASSERT_TRUE(Refs);
+    EXPECT_TRUE((*Refs)[0].isNull());
+    using FuncInstance = WasmEdge::Runtime::Instance::FunctionInstance;
+    EXPECT_EQ((*Refs)[1].getPtr<FuncInstance>(),
+              (*Inst)->findFuncExports("answer"sv));
+    // The dropped data segment is not restored.
+    EXPECT_FALSE(Executor.invoke((*Inst)->findFuncExports("copy"sv), {}, {}));
+    // The writes are private to the instance.
+    Mem->getDataPtr()[65541] = 0;
+  }
+
+  // The snapshot is rejected by the other modules.
+  auto OtherMod = Loader.parseModule(SwitchWasm);
+  ASSERT_TRUE(OtherMod);
+  ASSERT_TRUE(Validator.validate(**OtherMod));
+  EXPECT_FALSE(Executor.instantiateSnapshot(Store, **OtherMod, **Snap));
+  std::error_code Error;
+  std::filesystem::remove(Path, Error);
+}
+
+TEST(InstancePool, ResetTest) {
+  WasmEdge::Configure Conf;
+  WasmEdge::Loader::Loader Loader(Conf);
+  WasmEdge::Validator::Validator Validator(Conf);
+  WasmEdge::Executor::Executor Executor(Conf);
+  WasmEdge::Runtime::StoreManager Store;
+  auto Mod = Loader.parseModule(InitWasm);
+  ASSERT_TRUE(Mod);
+  ASSERT_TRUE(Validator.validate(**Mod));
+  auto Pool =
+      WasmEdge::Executor::InstancePool::create(Executor, Store, **Mod, 2);
+  ASSERT_TRUE(Pool);
+  EXPECT_EQ((*Pool)->getInstanceCount(), 2U);
+  EXPECT_EQ((*Pool)->getIdleCount(), 2U);
+
+  auto Inst = (*Pool)->acquire();
+  ASSERT_TRUE(Inst);
+  for (uint32_t I = 0; I < 2; ++I) {
+    // The instance is the same as a newly instantiated one.
+    auto *Mem = (*Inst)->findMemoryExports("mem"sv);
+    ASSERT_NE(Mem, nullptr);
+    EXPECT_EQ(Mem->getPageSize(), 1U);
+    EXPECT_EQ(Mem->getDataPtr()[0], 0U);
+    auto *Glob = (*Inst)->findGlobalExports("g"sv);
+    ASSERT_NE(Glob, nullptr);
+    EXPECT_EQ(Glob->getValue().get<uint32_t>(), 0U);
+    auto *Tab = (*Inst)->findTableExports("tab"sv);
+    ASSERT_NE(Tab, nullptr);
+    auto Refs = Tab->getRefs(0, 2);
+    ASSERT_TRUE(Refs);
+    EXPECT_TRUE((*Refs)[1].isNull());
+
+    // Grow the memory, drop the data segment, and write the states.
+    ASSERT_TRUE(Executor.invoke((*Inst)->findFuncExports("_initialize"sv),
+                                {}, {}));
+    EXPECT_EQ(Mem->getPageSize(), 2U);
+    EXPECT_EQ(Glob->getValue().get<uint32_t>(), 7U);
+    EXPECT_FALSE(Executor.invoke((*Inst)->findFuncExports("copy"sv), {}, {}));
+    Mem->getDataPtr()[0] = 1;
+    ASSERT_TRUE((*Pool)->release(*Inst));
+    EXPECT_FALSE((*Pool)->release(*Inst));
+
+    auto Reused = (*Pool)->acquire();
+    ASSERT_TRUE(Reused);
+    EXPECT_EQ(*Reused, *Inst);
+    // The dropped data segment is restored.
+    ASSERT_TRUE(Executor.invoke((*Inst)->findFuncExports("copy"sv), {}, {}));
+    EXPECT_EQ(Mem->getDataPtr()[0], 0x2aU);
+    EXPECT_EQ(Mem->getDataPtr()[1], 0x2bU);
+    ASSERT_TRUE((*Pool)->release(*Inst));
+    Inst = (*Pool)->acquire();
+    ASSERT_TRUE(Inst);
+  }
+
+  // The pool grows when there is no idle instance.
+  auto Other = (*Pool)->acquire();
+  ASSERT_TRUE(Other);
+  auto Added = (*Pool)->acquire();
+  ASSERT_TRUE(Added);
+  EXPECT_EQ((*Pool)->getInstanceCount(), 3U);
+  EXPECT_EQ((*Pool)->getIdleCount(), 0U);
+  EXPECT_NE(*Added, *Inst);
+  EXPECT_NE(*Added, *Other);
+  EXPECT_TRUE((*Pool)->release(*Added));
+  EXPECT_EQ((*Pool)->getIdleCount(), 1U);
+}
+
+std::array<WasmEdge::Byte, 50> LoopWasm{
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x06, 0x01, 0x60,
+    0x01, 0x7f, 0x01, 0x7f, 0x03, 0x02, 0x01, 0x00, 0x07, 0x08, 0x01, 0x04,
+    0x6c, 0x6f, 0x6f, 0x70, 0x00, 0x00, 0x0a, 0x12, 0x01, 0x10, 0x00, 0x03,
+    0x40, 0x20, 0x00, 0x41, 0x01, 0x6b, 0x22, 0x00, 0x0d, 0x00, 0x0b, 0x20,
+    0x00, 0x0b};
+
+TEST(TieredExecution, TierUpTest) {
+  WasmEdge::Configure Conf;
+  Conf.getRuntimeConfigure().setTierUpThreshold(100);
+  WasmEdge::Loader::Loader Loader(Conf);
+  WasmEdge::Validator::Validator Validator(Conf);
+  WasmEdge::Executor::Executor Executor(Conf);
+  WasmEdge::Runtime::StoreManager Store;
+  auto Mod = Loader.parseModule(LoopWasm);
+  ASSERT_TRUE(Mod);
+  ASSERT_TRUE(Validator.validate(**Mod));
+  std::vector<const WasmEdge::Runtime::Instance::FunctionInstance *> HotFuncs;
+  ASSERT_TRUE(Executor.registerTierUpFunction(
+      [&HotFuncs](const WasmEdge::Runtime::Instance::FunctionInstance &Func) {
+        HotFuncs.push_back(&Func);
+      }));
+  auto ModInst = Executor.instantiateModule(Store, **Mod);
+  ASSERT_TRUE(ModInst);
+  const auto *Func = (*ModInst)->findFuncExports("loop");
+  ASSERT_NE(Func, nullptr);
+  const std::array<WasmEdge::ValType, 1> ParamType{WasmEdge::TypeCode::I32};
+  auto Loop = [&Executor, &Func, &ParamType](uint32_t N) {
+    return Executor.invoke(Func, std::array<WasmEdge::ValVariant, 1>{N},
+                           ParamType);
+  };
+
+  // The calls and the backward branches are counted.
+  ASSERT_TRUE(Loop(50));
+  EXPECT_TRUE(HotFuncs.empty());
+  auto Result = Loop(50);
+  ASSERT_TRUE(Result);
+  EXPECT_EQ((*Result)[0].first.get<uint32_t>(), 0U);
+  ASSERT_EQ(HotFuncs.size(), 1U);
+  EXPECT_EQ(HotFuncs[0], Func);
+  // The hot function is notified only once, and keeps running in the
+  // interpreter before the compiled code is ready.
+  ASSERT_TRUE(Loop(1000));
+  EXPECT_EQ(HotFuncs.size(), 1U);
+}
+
+std::array<WasmEdge::Byte, 444> BaselineWasm{
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x3e, 0x0b, 0x60,
+    0x01, 0x7e, 0x01, 0x7e, 0x60, 0x01, 0x7f, 0x01, 0x7f, 0x60, 0x02, 0x7f,
+    0x7f, 0x01, 0x7f, 0x60, 0x02, 0x7f, 0x7e, 0x01, 0x7e, 0x60, 0x01, 0x7c,
+    0x01, 0x7f, 0x60, 0x02, 0x7d, 0x7d, 0x01, 0x7d, 0x60, 0x01, 0x7c, 0x01,
+    0x7e, 0x60, 0x01, 0x7e, 0x01, 0x7c, 0x60, 0x03, 0x7f, 0x7f, 0x7f, 0x01,
+    0x7f, 0x60, 0x01, 0x7c, 0x01, 0x7c, 0x60, 0x02, 0x7c, 0x7c, 0x01, 0x7f,
+    0x03, 0x12, 0x11, 0x00, 0x01, 0x02, 0x02, 0x02, 0x03, 0x04, 0x05, 0x06,
+    0x07, 0x08, 0x01, 0x01, 0x09, 0x01, 0x01, 0x0a, 0x05, 0x03, 0x01, 0x00,
+    0x01, 0x07, 0x79, 0x11, 0x03, 0x66, 0x61, 0x63, 0x00, 0x00, 0x03, 0x73,
+    0x75, 0x6d, 0x00, 0x01, 0x05, 0x64, 0x69, 0x76, 0x5f, 0x73, 0x00, 0x02,
+    0x05, 0x72, 0x65, 0x6d, 0x5f, 0x75, 0x00, 0x03, 0x04, 0x72, 0x6f, 0x74,
+    0x6c, 0x00, 0x04, 0x03, 0x6d, 0x65, 0x6d, 0x00, 0x05, 0x05, 0x74, 0x72,
+    0x75, 0x6e, 0x63, 0x00, 0x06, 0x03, 0x6d, 0x69, 0x6e, 0x00, 0x07, 0x03,
+    0x73, 0x61, 0x74, 0x00, 0x08, 0x03, 0x63, 0x76, 0x74, 0x00, 0x09, 0x03,
+    0x73, 0x65, 0x6c, 0x00, 0x0a, 0x06, 0x73, 0x77, 0x69, 0x74, 0x63, 0x68,
+    0x00, 0x0b, 0x04, 0x62, 0x69, 0x74, 0x73, 0x00, 0x0c, 0x07, 0x6e, 0x65,
+    0x61, 0x72, 0x65, 0x73, 0x74, 0x00, 0x0d, 0x04, 0x74, 0x72, 0x61, 0x70,
+    0x00, 0x0e, 0x04, 0x67, 0x72, 0x6f, 0x77, 0x00, 0x0f, 0x04, 0x66, 0x63,
+    0x6d, 0x70, 0x00, 0x10, 0x0a, 0xdd, 0x01, 0x11, 0x15, 0x00, 0x20, 0x00,
+    0x50, 0x04, 0x7e, 0x42, 0x01, 0x05, 0x20, 0x00, 0x20, 0x00, 0x42, 0x01,
+    0x7d, 0x10, 0x00, 0x7e, 0x0b, 0x0b, 0x21, 0x01, 0x01, 0x7f, 0x02, 0x40,
+    0x03, 0x40, 0x20, 0x00, 0x45, 0x0d, 0x01, 0x20, 0x01, 0x20, 0x00, 0x6a,
+    0x21, 0x01, 0x20, 0x00, 0x41, 0x01, 0x6b, 0x21, 0x00, 0x0c, 0x00, 0x0b,
+    0x0b, 0x20, 0x01, 0x0b, 0x07, 0x00, 0x20, 0x00, 0x20, 0x01, 0x6d, 0x0b,
+    0x07, 0x00, 0x20, 0x00, 0x20, 0x01, 0x70, 0x0b, 0x07, 0x00, 0x20, 0x00,
+    0x20, 0x01, 0x77, 0x0b, 0x12, 0x00, 0x20, 0x00, 0x20, 0x01, 0x37, 0x03,
+    0x08, 0x20, 0x00, 0x29, 0x03, 0x08, 0x3f, 0x00, 0xad, 0x7c, 0x0b, 0x05,
+    0x00, 0x20, 0x00, 0xaa, 0x0b, 0x07, 0x00, 0x20, 0x00, 0x20, 0x01, 0x96,
+    0x0b, 0x06, 0x00, 0x20, 0x00, 0xfc, 0x07, 0x0b, 0x05, 0x00, 0x20, 0x00,
+    0xba, 0x0b, 0x09, 0x00, 0x20, 0x00, 0x20, 0x01, 0x20, 0x02, 0x1b, 0x0b,
+    0x1a, 0x00, 0x02, 0x40, 0x02, 0x40, 0x02, 0x40, 0x20, 0x00, 0x0e, 0x02,
+    0x00, 0x01, 0x02, 0x0b, 0x41, 0x0a, 0x0f, 0x0b, 0x41, 0x14, 0x0f, 0x0b,
+    0x41, 0x1e, 0x0b, 0x0d, 0x00, 0x20, 0x00, 0x67, 0x41, 0xe4, 0x00, 0x6c,
+    0x20, 0x00, 0x68, 0x6a, 0x0b, 0x05, 0x00, 0x20, 0x00, 0x9e, 0x0b, 0x03,
+    0x00, 0x00, 0x0b, 0x06, 0x00, 0x20, 0x00, 0x40, 0x00, 0x0b, 0x19, 0x00,
+    0x20, 0x00, 0x20, 0x01, 0x63, 0x41, 0x02, 0x74, 0x20, 0x00, 0x20, 0x01,
+    0x61, 0x41, 0x01, 0x74, 0x72, 0x20, 0x00, 0x20, 0x01, 0x62, 0x72, 0x0b,
+};
+
+TEST(TieredExecution, BaselineTest) {
+  WasmEdge::Configure Conf;
+  if (!WasmEdge::Baseline::Compiler::isSupported(Conf)) {
+    GTEST_SKIP();
+  }
+  WasmEdge::Loader::Loader Loader(Conf);
+  WasmEdge::Validator::Validator Validator(Conf);
+  auto Mod = Loader.parseModule(BaselineWasm);
+  ASSERT_TRUE(Mod);
+  ASSERT_TRUE(Validator.validate(**Mod));
+
+  // The compiled code runs only when the tiered execution is enabled, and the
+  // results are compared with the interpreter.
+  WasmEdge::Executor::Executor Interpreter(Conf);
+  WasmEdge::Runtime::StoreManager InterpreterStore;
+  auto InterpreterInst = Interpreter.instantiateModule(InterpreterStore, **Mod);
+  ASSERT_TRUE(InterpreterInst);
+  WasmEdge::Executor::Executor Executor(Conf);
+  ASSERT_TRUE(Executor.registerTierUpFunction(
+      [](const WasmEdge::Runtime::Instance::FunctionInstance &) {}));
+  WasmEdge::Runtime::StoreManager Store;
+  auto ModInst = Executor.instantiateModule(Store, **Mod);
+  ASSERT_TRUE(ModInst);
+  WasmEdge::Baseline::Compiler Compiler(Conf);
+  auto Exec = Compiler.compile(**Mod);
+  ASSERT_TRUE(Exec);
+  ASSERT_TRUE(Executor.loadTieredExecutable(**Mod, **ModInst, *Exec));
+
+  auto Check = [&](std::string_view Name,
+                   std::vector<WasmEdge::ValVariant> Params) {
+    SCOPED_TRACE(Name);
+    const auto *Expected = (*InterpreterInst)->findFuncExports(Name);
+    const auto *Func = (*ModInst)->findFuncExports(Name);
+    ASSERT_NE(Func, nullptr);
+    ASSERT_NE(Func->getTieredCode(), nullptr);
+    const auto &ParamTypes = Func->getFuncType().getParamTypes();
+    auto ExpectedResult = Interpreter.invoke(Expected, Params, ParamTypes);
+    auto Result = Executor.invoke(Func, Params, ParamTypes);
+    ASSERT_EQ(static_cast<bool>(Result), static_cast<bool>(ExpectedResult));
+    if (!Result) {
+      EXPECT_EQ(Result.error(), ExpectedResult.error());
+      return;
+    }
+    ASSERT_EQ(Result->size(), ExpectedResult->size());
+    for (size_t I = 0; I < Result->size(); ++I) {
+      const auto &[Val, Type] = (*Result)[I];
+      const auto &ExpectedVal = (*ExpectedResult)[I].first;
+      if (Type == WasmEdge::TypeCode::I32 || Type == WasmEdge::TypeCode::F32) {
+        EXPECT_EQ(Val.get<uint32_t>(), ExpectedVal.get<uint32_t>());
+      } else {
+        EXPECT_EQ(Val.get<uint64_t>(), ExpectedVal.get<uint64_t>());
+      }
+    }
+  };
+  const double NaN = std::numeric_limits<double>::quiet_NaN();
+
+  for (uint64_t N : {0, 1, 10, 20}) {
+    Check("fac", {N});
+  }
+  for (uint32_t N : {0, 1, 100, 1000}) {
+    Check("sum", {N});
+  }
+  for (auto [L, R] : std::initializer_list<std::pair<int32_t, int32_t>>{
+           {7, 2}, {-7, 2}, {1, 0}, {INT32_MIN, -1}, {INT32_MIN, 1}, {5, -1}}) {
+    Check("div_s", {L, R});
+    Check("rem_u", {L, R});
+    Check("rotl", {L, R});
+  }
+  for (uint32_t N : {0, 1, 2, 3, 100}) {
+    Check("switch", {N});
+  }
+  for (uint32_t N : {0U, 1U, 0x80000000U, 0xF0U}) {
+    Check("bits", {N});
+  }
+  Check("sel", {1U, 2U, 0U});
+  Check("sel", {1U, 2U, 5U});
+  for (double F : {1.5, -1.5, NaN, 2147483647.9, 2147483648.0, -2147483648.9,
+                   -2147483649.0}) {
+    Check("trunc", {F});
+  }
+  for (double F : {NaN, -1.5, 1e20, 18446744073709551615.0, 9.3e18, 42.7}) {
+    Check("sat", {F});
+  }
+  for (double F : {2.5, 3.5, -0.5, 1.4999}) {
+    Check("nearest", {F});
+  }
+  for (auto [L, R] : std::initializer_list<std::pair<float, float>>{
+           {1.0f, 2.0f}, {-0.0f, 0.0f}, {0.0f, -0.0f}, {-1.0f, -2.0f}}) {
+    Check("min", {L, R});
+  }
+  for (auto [L, R] : std::initializer_list<std::pair<double, double>>{
+           {1.0, 2.0}, {2.0, 1.0}, {1.0, 1.0}, {NaN, 1.0}}) {
+    Check("fcmp", {L, R});
+  }
+  for (uint64_t N : {UINT64_C(0), UINT64_C(1), UINT64_C(0x8000000000000001),
+                     UINT64_MAX, UINT64_C(0x7FFFFFFFFFFFFFFF)}) {
+    Check("cvt", {N});
+  }
+  Check("trap", {0U});
+  Check("mem", {0U, UINT64_C(0x1122334455667788)});
+  Check("mem", {65520U, UINT64_C(5)});
+  // Out-of-bounds accesses in the guard region trap.
+  Check("mem", {65528U, UINT64_C(1)});
+  Check("grow", {1U});
+  Check("mem", {65528U, UINT64_C(1)});
+  Check("grow", {70000U});
+}
+
 TEST(AsyncRunWsmFile, InterruptTest) {
   WasmEdge::Configure Conf;
   WasmEdge::VM::VM VM(Conf);
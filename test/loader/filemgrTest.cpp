@@ -927,6 +927,48 @@ TEST(FileManagerTest, Vector__PeekByte) {
   EXPECT_EQ(10U, Mgr.getOffset());
 }
 
+TEST(FileManagerTest, Stream__ReadBytes) {
+  // 19. Test reading the streaming source which sends one byte per reading.
+  std::vector<uint8_t> Vec = {0x00, 0xFF, 0x1F, 0x2E, 0x3D,
+                              0x4C, 0x5B, 0x6A, 0x79, 0x88};
+  size_t Sent = 0;
+  WasmEdge::Expect<std::vector<uint8_t>> ReadBytes;
+  ASSERT_TRUE(Mgr.setStream(
+      [&](WasmEdge::Span<WasmEdge::Byte> Buf) -> WasmEdge::Expect<size_t> {
+        if (Sent == Vec.size() || Buf.empty()) {
+          return 0;
+        }
+        Buf[0] = Vec[Sent++];
+        return 1;
+      }));
+  EXPECT_TRUE(Mgr.isStream());
+  EXPECT_EQ(0U, Mgr.getOffset());
+  EXPECT_EQ(0U, Sent);
+  ASSERT_TRUE(ReadBytes = Mgr.readBytes(3));
+  EXPECT_EQ(0x00, ReadBytes.value()[0]);
+  EXPECT_EQ(0xFF, ReadBytes.value()[1]);
+  EXPECT_EQ(0x1F, ReadBytes.value()[2]);
+  EXPECT_EQ(3U, Sent);
+  Mgr.seek(5);
+  ASSERT_TRUE(ReadBytes = Mgr.readBytes(5));
+  EXPECT_EQ(0x4C, ReadBytes.value()[0]);
+  EXPECT_EQ(0x88, ReadBytes.value()[4]);
+  ASSERT_FALSE(ReadBytes = Mgr.readBytes(1));
+  EXPECT_EQ(10U, Mgr.getOffset());
+}
+
+TEST(FileManagerTest, Stream__ReadError) {
+  // 20. Test the failure of reading the streaming source.
+  WasmEdge::Expect<uint8_t> ReadByte;
+  ASSERT_TRUE(Mgr.setStream(
+      [](WasmEdge::Span<WasmEdge::Byte>) -> WasmEdge::Expect<size_t> {
+        return WasmEdge::Unexpect(WasmEdge::ErrCode::Value::ReadError);
+      }));
+  ASSERT_FALSE(ReadByte = Mgr.readByte());
+  EXPECT_EQ(WasmEdge::ErrCode::Value::ReadError, ReadByte.error());
+  EXPECT_EQ(0U, Mgr.getOffset());
+}
+
 } // namespace
 
 GTEST_API_ int main(int argc, char **argv) {
@@ -499,6 +499,63 @@ TEST(SectionTest, LoadCodeSection) {
   EXPECT_TRUE(Ldr.parseModule(prefixedVec(Vec)));
 }
 
+TEST(SectionTest, LoadCodeSectionParallel) {
+  WasmEdge::Configure ParConf;
+  ParConf.getRuntimeConfigure().setLoadingJobs(4);
+  WasmEdge::Loader::Loader ParLdr(ParConf);
+  std::vector<uint8_t> Vec;
+
+  // 12. Test load code section in parallel.
+  //
+  //   1.  Load code section with contents.
+  //   2.  Load code section with a malformed expression.
+  //   3.  Load code section with malformed expressions in two segments.
+  //   4.  Load code section with an oversized segment size.
+
+  Vec = {
+      0x03U,                      // Function section
+      0x04U,                      // Content size = 4
+      0x03U,                      // Vector length = 3
+      0x00U, 0x00U, 0x00U,        // vec[0..2]
+      0x0AU,                      // Code section
+      0x16U,                      // Content size = 22
+      0x03U,                      // Vector length = 3
+      0x06U,                      // vec[0] Code segment size = 6
+      0x01U, 0x01U, 0x7FU,        // Local vec(1)
+      0x41U, 0x00U, 0x0BU,        // Expression
+      0x06U,                      // vec[1] Code segment size = 6
+      0x01U, 0x02U, 0x7EU,        // Local vec(1)
+      0x42U, 0x01U, 0x0BU,        // Expression
+      0x06U,                      // vec[2] Code segment size = 6
+      0x01U, 0x03U, 0x7DU,        // Local vec(1)
+      0x01U, 0x01U, 0x0BU         // Expression
+  };
+  auto Res = ParLdr.parseModule(prefixedVec(Vec));
+  ASSERT_TRUE(Res);
+  const auto &Codes = (*Res)->getCodeSection().getContent();
+  ASSERT_EQ(Codes.size(), 3U);
+  EXPECT_EQ(Codes[1].getLocals()[0].first, 2U);
+  EXPECT_EQ(Codes[2].getExpr().getInstrs().size(), 3U);
+
+  auto ExpectSameError = [&](const std::vector<uint8_t> &Bytes) {
+    auto SeqRes = Ldr.parseModule(prefixedVec(Bytes));
+    auto ParRes = ParLdr.parseModule(prefixedVec(Bytes));
+    ASSERT_FALSE(SeqRes);
+    ASSERT_FALSE(ParRes);
+    EXPECT_EQ(SeqRes.error(), ParRes.error());
+  };
+  auto Malformed = Vec;
+  Malformed[20] = 0x0AU;
+  ExpectSameError(Malformed);
+  Malformed[13] = 0xFFU;
+  ExpectSameError(Malformed);
+  Malformed = Vec;
+  Malformed[7] = 0x17U;
+  Malformed[16] = 0x86U;
+  Malformed.push_back(0x80U);
+  ExpectSameError(Malformed);
+}
+
 TEST(SectionTest, LoadDataSection) {
   std::vector<uint8_t> Vec;
 
@@ -3,6 +3,7 @@
 
 #include "common/configure.h"
 #include "runtime/instance/memory.h"
+#include "system/allocator.h"
 
 #include <gtest/gtest.h>
 
@@ -41,6 +42,54 @@ TEST(MemLimitTest, Limit__Pages) {
   ASSERT_FALSE(Inst6.growPage(0xFFFFFFFF));
 }
 
+TEST(MemLimitTest, Pool__Reuse) {
+  using MemInst = WasmEdge::Runtime::Instance::MemoryInstance;
+  using WasmEdge::Allocator;
+  if (!Allocator::has_guard_region()) {
+    GTEST_SKIP();
+  }
+  Allocator::set_pool_capacity(2);
+  auto Stat = Allocator::get_pool_statistics();
+  EXPECT_EQ(Stat.Capacity, 2U);
+  EXPECT_EQ(Stat.Idle, 2U);
+  const auto Reused = Stat.Reused;
+
+  {
+    MemInst Inst1(WasmEdge::AST::MemoryType(1));
+    MemInst Inst2(WasmEdge::AST::MemoryType(1));
+    MemInst Inst3(WasmEdge::AST::MemoryType(1));
+    ASSERT_FALSE(Inst3.getDataPtr() == nullptr);
+    ASSERT_TRUE(Inst1.growPage(3));
+    Inst1.getDataPtr()[0] = 0x2A;
+    Inst1.getDataPtr()[3 * 65536] = 0x2A;
+    Stat = Allocator::get_pool_statistics();
+    EXPECT_EQ(Stat.Idle, 0U);
+    EXPECT_GE(Stat.Live, 3U);
+    EXPECT_GE(Stat.HighWater, Stat.Live);
+    EXPECT_EQ(Stat.Reused - Reused, 2U);
+  }
+  // Only 2 released reservations are kept.
+  Stat = Allocator::get_pool_statistics();
+  EXPECT_EQ(Stat.Idle, 2U);
+
+  // The reused memories are zero-filled.
+  {
+    MemInst Inst1(WasmEdge::AST::MemoryType(4));
+    MemInst Inst2(WasmEdge::AST::MemoryType(4));
+    for (auto *Inst : {&Inst1, &Inst2}) {
+      ASSERT_FALSE(Inst->getDataPtr() == nullptr);
+      EXPECT_EQ(Inst->getDataPtr()[0], 0U);
+      EXPECT_EQ(Inst->getDataPtr()[3 * 65536], 0U);
+    }
+    EXPECT_EQ(Allocator::get_pool_statistics().Reused - Reused, 4U);
+  }
+
+  Allocator::set_pool_capacity(0);
+  Stat = Allocator::get_pool_statistics();
+  EXPECT_EQ(Stat.Capacity, 0U);
+  EXPECT_EQ(Stat.Idle, 0U);
+}
+
 } // namespace
 
 GTEST_API_ int main(int argc, char **argv) {